@@ -0,0 +1,111 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+// The parts of libOBS that the code measured by 'streamfx-bench' uses, without a graphics device or anything else
+// that OBS Studio would have to be running for. Settings only hold values for as long as the process runs.
+
+#include "common.hpp"
+
+#include "warning-disable.hpp"
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include "warning-enable.hpp"
+
+struct obs_data {
+	std::atomic<long>                _references{1};
+	std::map<std::string, long long> _values;
+};
+
+extern "C" {
+void blog(int log_level, const char* format, ...)
+{
+	const char* level = "info";
+	switch (log_level) {
+	case LOG_ERROR:
+		level = "error";
+		break;
+	case LOG_WARNING:
+		level = "warning";
+		break;
+	case LOG_DEBUG:
+		level = "debug";
+		break;
+	}
+
+	va_list args;
+	va_start(args, format);
+	fprintf(stderr, "%s: ", level);
+	vfprintf(stderr, format, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+}
+
+void* bmalloc(size_t size)
+{
+	return malloc((size > 0) ? size : 1);
+}
+
+void* brealloc(void* ptr, size_t size)
+{
+	return realloc(ptr, (size > 0) ? size : 1);
+}
+
+void bfree(void* ptr)
+{
+	free(ptr);
+}
+
+obs_data_t* obs_data_create()
+{
+	return new obs_data();
+}
+
+obs_data_t* obs_data_create_from_json_file_safe(const char*, const char*)
+{
+	return nullptr;
+}
+
+void obs_data_addref(obs_data_t* data)
+{
+	if (data) {
+		data->_references.fetch_add(1);
+	}
+}
+
+void obs_data_release(obs_data_t* data)
+{
+	if (data && (data->_references.fetch_sub(1) == 1)) {
+		delete data;
+	}
+}
+
+bool obs_data_save_json_safe(obs_data_t*, const char*, const char*, const char*)
+{
+	return true;
+}
+
+void obs_data_set_int(obs_data_t* data, const char* name, long long val)
+{
+	data->_values[name] = val;
+}
+
+long long obs_data_get_int(obs_data_t* data, const char* name)
+{
+	auto kv = data->_values.find(name);
+	return (kv != data->_values.end()) ? kv->second : 0;
+}
+
+bool obs_data_get_bool(obs_data_t* data, const char* name)
+{
+	return obs_data_get_int(data, name) != 0;
+}
+
+void obs_add_tick_callback(void (*)(void* param, float seconds), void*) {}
+
+void obs_remove_tick_callback(void (*)(void* param, float seconds), void*) {}
+}
@@ -0,0 +1,95 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+// Takes the place of plugin.cpp, so that everything which registers benchmarks without needing a graphics device can
+// be measured outside of OBS Studio.
+
+#include "plugin.hpp"
+#include "util/util-benchmark.hpp"
+#include "util/util-logging.hpp"
+
+#include "warning-disable.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "warning-enable.hpp"
+
+namespace streamfx {
+	typedef std::list<loader_function_t>               loader_list_t;
+	typedef std::map<loader_priority_t, loader_list_t> loader_map_t;
+
+	loader_map_t& get_initializers()
+	{
+		static loader_map_t initializers;
+		return initializers;
+	}
+
+	loader_map_t& get_finalizers()
+	{
+		static loader_map_t finalizers;
+		return finalizers;
+	}
+
+	loader::loader(loader_function_t initializer, loader_function_t finalizer, loader_priority_t priority)
+	{
+		get_initializers()[priority].push_back(initializer);
+
+		// Invert the order for finalizers.
+		get_finalizers()[priority ^ static_cast<loader_priority_t>(0xFFFFFFFFFFFFFFFF)].push_back(finalizer);
+	}
+
+	static void run_loaders(loader_map_t& loaders)
+	{
+		for (auto kv : loaders) {
+			for (auto function : kv.second) {
+				try {
+					function();
+				} catch (const std::exception& ex) {
+					DLOG_ERROR("Loader threw exception: %s", ex.what());
+				} catch (...) {
+					DLOG_ERROR("Loader threw unknown exception.");
+				}
+			}
+		}
+	}
+} // namespace streamfx
+
+std::shared_ptr<streamfx::util::threadpool::threadpool> streamfx::threadpool()
+{
+	return streamfx::util::threadpool::threadpool::instance();
+}
+
+std::filesystem::path streamfx::data_file_path(std::string_view file)
+{
+	return std::filesystem::current_path() / "data" / file;
+}
+
+std::filesystem::path streamfx::config_file_path(std::string_view file)
+{
+	// Keep whatever the benchmarks write away from a real configuration.
+	return std::filesystem::temp_directory_path() / "streamfx-bench" / file;
+}
+
+int main(int argc, const char* argv[])
+{
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <results.json> [prefix ...]\n", argv[0]);
+		fprintf(stderr, "Runs all benchmarks whose name starts with one of the given prefixes, or all of them if none are given.\n");
+		return 2;
+	}
+
+	std::vector<std::string> filters;
+	for (int idx = 2; idx < argc; idx++) {
+		filters.emplace_back(argv[idx]);
+	}
+
+	streamfx::run_loaders(streamfx::get_initializers());
+	size_t failed = streamfx::util::benchmark::run(std::filesystem::u8path(argv[1]), filters);
+	streamfx::run_loaders(streamfx::get_finalizers());
+
+	return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+// Benchmarks of the threadpool, which are only part of streamfx-bench.
+
+#include "plugin.hpp"
+#include "util/util-benchmark.hpp"
+#include "util/util-threadpool.hpp"
+
+#include "warning-disable.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "warning-enable.hpp"
+
+namespace {
+	/** The mutex guarded task list that the threadpool used before it had work-stealing queues.
+	 *
+	 * Only kept as the baseline for the contention benchmark. Unlike the original, pushing a task wakes
+	 * a worker instead of leaving it to poll, so that only the cost of contention is compared.
+	 */
+	class list_threadpool {
+		std::mutex                                                   _lock;
+		std::condition_variable                                      _cv;
+		std::list<std::shared_ptr<streamfx::util::threadpool::task>> _tasks;
+		std::vector<std::thread>                                     _workers;
+		bool                                                         _stop;
+
+		public:
+		list_threadpool(size_t workers) : _lock(), _cv(), _tasks(), _workers(), _stop(false)
+		{
+			for (size_t idx = 0; idx < workers; idx++) {
+				_workers.emplace_back([this]() { work(); });
+			}
+		}
+
+		~list_threadpool()
+		{
+			{
+				std::lock_guard<std::mutex> lg(_lock);
+				_stop = true;
+				for (auto& task : _tasks) {
+					task->cancel();
+				}
+				_tasks.clear();
+			}
+			_cv.notify_all();
+			for (auto& worker : _workers) {
+				worker.join();
+			}
+		}
+
+		std::shared_ptr<streamfx::util::threadpool::task> push(streamfx::util::threadpool::task_callback_t callback, streamfx::util::threadpool::task_data_t data = nullptr)
+		{
+			auto task = std::make_shared<streamfx::util::threadpool::task>(callback, data);
+			{
+				std::lock_guard<std::mutex> lg(_lock);
+				_tasks.emplace_back(task);
+			}
+			_cv.notify_one();
+			return task;
+		}
+
+		private:
+		void work()
+		{
+			std::unique_lock<std::mutex> ul(_lock);
+			while (!_stop) {
+				if (_tasks.empty()) {
+					_cv.wait(ul);
+					continue;
+				}
+
+				auto task = std::move(_tasks.front());
+				_tasks.pop_front();
+
+				ul.unlock();
+				task->run();
+				task.reset();
+				ul.lock();
+			}
+		}
+	};
+} // namespace
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		for (auto priority : {streamfx::util::threadpool::priority::REALTIME, streamfx::util::threadpool::priority::INTERACTIVE}) {
+			std::string name = (priority == streamfx::util::threadpool::priority::REALTIME) ? "threadpool.realtime.1000" : "threadpool.interactive.1000";
+			streamfx::util::benchmark::add(name, 100, [priority]() -> streamfx::util::benchmark::function_t {
+				return [priority]() {
+					std::vector<std::shared_ptr<streamfx::util::threadpool::task>> tasks;
+					tasks.reserve(1000);
+					for (size_t idx = 0; idx < 1000; idx++) {
+						tasks.push_back(streamfx::threadpool()->push([](streamfx::util::threadpool::task_data_t) {}, nullptr, priority));
+					}
+					for (auto& task : tasks) {
+						task->await_completion();
+					}
+				};
+			});
+		}
+
+		// Many threads outside of the threadpool pushing small tasks at once, against the previous implementation.
+		constexpr size_t producers  = 8;
+		constexpr size_t tasks      = 1000;
+		auto             contention = [](auto& pool) {
+			std::vector<std::thread> threads;
+			threads.reserve(producers);
+			for (size_t idx = 0; idx < producers; idx++) {
+				threads.emplace_back([&pool]() {
+					std::vector<std::shared_ptr<streamfx::util::threadpool::task>> handles;
+					handles.reserve(tasks);
+					for (size_t idx = 0; idx < tasks; idx++) {
+						handles.push_back(pool.push([](streamfx::util::threadpool::task_data_t) {}, nullptr));
+					}
+					for (auto& handle : handles) {
+						handle->await_completion();
+					}
+				});
+			}
+			for (auto& thread : threads) {
+				thread.join();
+			}
+		};
+		streamfx::util::benchmark::add("threadpool.contention.8x1000", 20, [contention]() -> streamfx::util::benchmark::function_t {
+			return [contention]() { contention(*streamfx::threadpool()); };
+		});
+		streamfx::util::benchmark::add("threadpool.contention.list.8x1000", 20, [contention]() -> streamfx::util::benchmark::function_t {
+			auto pool = std::make_shared<list_threadpool>(std::max<size_t>(std::thread::hardware_concurrency(), 2));
+			return [contention, pool]() { contention(*pool); };
+		});
+	},
+	[]() { // Finalizer
+	},
+	streamfx::loader_priority::NORMAL);
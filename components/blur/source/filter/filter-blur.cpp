@@ -5,6 +5,7 @@
 
 #include "filter-blur.hpp"
 #include "strings.hpp"
+#include "gfx/blur/gfx-blur-automatic.hpp"
 #include "gfx/blur/gfx-blur-box-linear.hpp"
 #include "gfx/blur/gfx-blur-box.hpp"
 #include "gfx/blur/gfx-blur-dual-filtering.hpp"
@@ -15,6 +16,7 @@
 #include "util/util-logging.hpp"
 
 #include "warning-disable.hpp"
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 #include <cmath>
@@ -44,6 +46,9 @@
 #define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
 #endif
 
+// Upper limit for the number of frames that inputs which keep changing are not compared for.
+#define ST_CACHE_MAX_BACKOFF 64
+
 // Translation Strings
 #define ST_I18N "Filter.Blur"
 
@@ -66,6 +71,17 @@
 #define ST_KEY_STEPSCALE_X "Filter.Blur.StepScale.X"
 #define ST_I18N_STEPSCALE_Y "Filter.Blur.StepScale.Y"
 #define ST_KEY_STEPSCALE_Y "Filter.Blur.StepScale.Y"
+#define ST_I18N_RESOLUTION "Filter.Blur.Resolution"
+#define ST_KEY_RESOLUTION "Filter.Blur.Resolution"
+#define ST_I18N_RESOLUTION_FULL "Filter.Blur.Resolution.Full"
+#define ST_I18N_RESOLUTION_HALF "Filter.Blur.Resolution.Half"
+#define ST_I18N_RESOLUTION_QUARTER "Filter.Blur.Resolution.Quarter"
+#define ST_I18N_UPDATERATE "Filter.Blur.UpdateRate"
+#define ST_KEY_UPDATERATE "Filter.Blur.UpdateRate"
+#define ST_I18N_UPDATERATE_BLEND "Filter.Blur.UpdateRate.Blend"
+#define ST_KEY_UPDATERATE_BLEND "Filter.Blur.UpdateRate.Blend"
+#define ST_I18N_CACHE "Filter.Blur.Cache"
+#define ST_KEY_CACHE "Filter.Blur.Cache"
 #define ST_I18N_MASK "Filter.Blur.Mask"
 #define ST_KEY_MASK "Filter.Blur.Mask"
 #define ST_I18N_MASK_TYPE "Filter.Blur.Mask.Type"
@@ -112,7 +128,7 @@ struct local_blur_subtype_t {
 };
 
 static std::map<std::string, local_blur_type_t> list_of_types = {
-	{"box", {&::streamfx::gfx::blur::box_factory::get, S_BLUR_TYPE_BOX}}, {"box_linear", {&::streamfx::gfx::blur::box_linear_factory::get, S_BLUR_TYPE_BOX_LINEAR}}, {"gaussian", {&::streamfx::gfx::blur::gaussian_factory::get, S_BLUR_TYPE_GAUSSIAN}}, {"gaussian_linear", {&::streamfx::gfx::blur::gaussian_linear_factory::get, S_BLUR_TYPE_GAUSSIAN_LINEAR}}, {"dual_filtering", {&::streamfx::gfx::blur::dual_filtering_factory::get, S_BLUR_TYPE_DUALFILTERING}},
+	{"automatic", {&::streamfx::gfx::blur::automatic_factory::get, S_BLUR_TYPE_AUTOMATIC}}, {"box", {&::streamfx::gfx::blur::box_factory::get, S_BLUR_TYPE_BOX}}, {"box_linear", {&::streamfx::gfx::blur::box_linear_factory::get, S_BLUR_TYPE_BOX_LINEAR}}, {"gaussian", {&::streamfx::gfx::blur::gaussian_factory::get, S_BLUR_TYPE_GAUSSIAN}}, {"gaussian_linear", {&::streamfx::gfx::blur::gaussian_linear_factory::get, S_BLUR_TYPE_GAUSSIAN_LINEAR}}, {"dual_filtering", {&::streamfx::gfx::blur::dual_filtering_factory::get, S_BLUR_TYPE_DUALFILTERING}},
 };
 static std::map<std::string, local_blur_subtype_t> list_of_subtypes = {
 	{"area", {::streamfx::gfx::blur::type::Area, S_BLUR_SUBTYPE_AREA}},
@@ -121,15 +137,11 @@ static std::map<std::string, local_blur_subtype_t> list_of_subtypes = {
 	{"zoom", {::streamfx::gfx::blur::type::Zoom, S_BLUR_SUBTYPE_ZOOM}},
 };
 
-blur_instance::blur_instance(obs_data_t* settings, obs_source_t* self) : obs::source_instance(settings, self), _gfx_util(::streamfx::gfx::util::get()), _source_rendered(false), _output_rendered(false)
+blur_instance::blur_instance(obs_data_t* settings, obs_source_t* self) : obs::source_instance(settings, self), _gfx_util(::streamfx::gfx::util::get()), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _source_rendered(false), _output_rendered(false), _cache(), _amortize()
 {
 	{
 		auto gctx = streamfx::obs::gs::context();
 
-		// Create RenderTargets
-		this->_source_rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-		this->_output_rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-
 		// Load Effects
 		{
 			auto file = streamfx::data_file_path("effects/mask.effect");
@@ -144,72 +156,153 @@ blur_instance::blur_instance(obs_data_t* settings, obs_source_t* self) : obs::so
 	update(settings);
 }
 
-blur_instance::~blur_instance() {}
+blur_instance::~blur_instance()
+{
+	if (_cache.enabled) {
+		uint64_t total = _cache.hits + _cache.misses;
+		D_LOG_INFO("Instance '%s' reused its previous result for %" PRIu64 " of %" PRIu64 " frame(s) (%.1f%%).", obs_source_get_name(_self), _cache.hits, total, (total > 0) ? (100. * static_cast<double_t>(_cache.hits) / static_cast<double_t>(total)) : 0.);
+	}
+
+	auto gctx = streamfx::obs::gs::context();
+	_cache.blurred.reset();
+	_cache.output.reset();
+	_cache.detector.reset();
+	_amortize.previous.reset();
+	_amortize.latest.reset();
+}
 
 bool blur_instance::apply_mask_parameters(streamfx::obs::gs::effect effect, gs_texture_t* original_texture, gs_texture_t* blurred_texture)
 {
-	if (effect.has_parameter("image_orig")) {
-		effect.get_parameter("image_orig").set_texture(original_texture);
+	auto& prm = _mask_parameters;
+
+	if (auto& p = prm.image_orig(effect); p) {
+		p.set_texture(original_texture);
 	}
-	if (effect.has_parameter("image_blur")) {
-		effect.get_parameter("image_blur").set_texture(blurred_texture);
+	if (auto& p = prm.image_blur(effect); p) {
+		p.set_texture(blurred_texture);
 	}
 
 	// Region
 	if (_mask.type == mask_type::Region) {
-		if (effect.has_parameter("mask_region_left")) {
-			effect.get_parameter("mask_region_left").set_float(_mask.region.left);
+		if (auto& p = prm.region_left(effect); p) {
+			p.set_float(_mask.region.left);
 		}
-		if (effect.has_parameter("mask_region_right")) {
-			effect.get_parameter("mask_region_right").set_float(_mask.region.right);
+		if (auto& p = prm.region_right(effect); p) {
+			p.set_float(_mask.region.right);
 		}
-		if (effect.has_parameter("mask_region_top")) {
-			effect.get_parameter("mask_region_top").set_float(_mask.region.top);
+		if (auto& p = prm.region_top(effect); p) {
+			p.set_float(_mask.region.top);
 		}
-		if (effect.has_parameter("mask_region_bottom")) {
-			effect.get_parameter("mask_region_bottom").set_float(_mask.region.bottom);
+		if (auto& p = prm.region_bottom(effect); p) {
+			p.set_float(_mask.region.bottom);
 		}
-		if (effect.has_parameter("mask_region_feather")) {
-			effect.get_parameter("mask_region_feather").set_float(_mask.region.feather);
+		if (auto& p = prm.region_feather(effect); p) {
+			p.set_float(_mask.region.feather);
 		}
-		if (effect.has_parameter("mask_region_feather_shift")) {
-			effect.get_parameter("mask_region_feather_shift").set_float(_mask.region.feather_shift);
+		if (auto& p = prm.region_feather_shift(effect); p) {
+			p.set_float(_mask.region.feather_shift);
 		}
 	}
 
 	// Image
 	if (_mask.type == mask_type::Image) {
-		if (effect.has_parameter("mask_image")) {
+		if (auto& p = prm.image(effect); p) {
 			if (_mask.image.texture) {
-				effect.get_parameter("mask_image").set_texture(_mask.image.texture);
+				p.set_texture(_mask.image.texture);
 			} else {
-				effect.get_parameter("mask_image").set_texture(nullptr);
+				p.set_texture(nullptr);
 			}
 		}
 	}
 
 	// Source
 	if (_mask.type == mask_type::Source) {
-		if (effect.has_parameter("mask_image")) {
+		if (auto& p = prm.image(effect); p) {
 			if (_mask.source.texture) {
-				effect.get_parameter("mask_image").set_texture(_mask.source.texture);
+				p.set_texture(_mask.source.texture);
 			} else {
-				effect.get_parameter("mask_image").set_texture(nullptr);
+				p.set_texture(nullptr);
 			}
 		}
 	}
 
 	// Shared
-	if (effect.has_parameter("mask_color")) {
-		effect.get_parameter("mask_color").set_float4(_mask.color.r, _mask.color.g, _mask.color.b, _mask.color.a);
+	if (auto& p = prm.color(effect); p) {
+		p.set_float4(_mask.color.r, _mask.color.g, _mask.color.b, _mask.color.a);
 	}
-	if (effect.has_parameter("mask_multiplier")) {
-		effect.get_parameter("mask_multiplier").set_float(_mask.multiplier);
+	if (auto& p = prm.multiplier(effect); p) {
+		p.set_float(_mask.multiplier);
 	}
 
 	return true;
 }
 
+std::shared_ptr<streamfx::obs::gs::texture> blur_instance::render_blend(std::shared_ptr<streamfx::obs::gs::texture> from, std::shared_ptr<streamfx::obs::gs::texture> to, float factor, uint32_t width, uint32_t height)
+{
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	try {
+		rt = _pool->acquire(width, height);
+	} catch (const std::exception&) {
+		return nullptr;
+	}
+
+	gs_blend_state_push();
+	gs_reset_blend_state();
+	gs_enable_color(true, true, true, true);
+	gs_enable_blending(false);
+	gs_enable_depth_test(false);
+	gs_enable_stencil_test(false);
+	gs_enable_stencil_write(false);
+	gs_set_cull_mode(GS_NEITHER);
+	gs_depth_function(GS_ALWAYS);
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+
+	_blend_parameters.image_orig(_effect_mask).set_texture(from);
+	_blend_parameters.image_blur(_effect_mask).set_texture(to);
+	_blend_parameters.factor(_effect_mask).set_float(factor);
+
+	{
+		auto op = rt->render(width, height);
+		gs_ortho(0, 1, 0, 1, -1, 1);
+		while (gs_effect_loop(_effect_mask.get_object(), "Blend")) {
+			_gfx_util->draw_fullscreen_triangle();
+		}
+	}
+
+	gs_blend_state_pop();
+
+	return streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+}
+
+::streamfx::gfx::blur::region blur_instance::get_blur_region(uint32_t width, uint32_t height)
+{
+	// Only a region mask that is not inverted leaves part of the blurred image unused.
+	if (!_mask.enabled || (_mask.type != mask_type::Region) || _mask.region.invert) {
+		return {};
+	}
+
+	// Feathering fades in from outside of the region, and reaches further out the more it is shifted.
+	float extent = 0.f;
+	if (_mask.region.feather > std::numeric_limits<float>::epsilon()) {
+		extent = _mask.region.feather * (.5f + std::max(_mask.region.feather_shift, 0.f));
+	}
+
+	// Include one more texel on each side for filtering.
+	auto left   = static_cast<int64_t>(std::floor((_mask.region.left - extent) * static_cast<float>(width))) - 1;
+	auto top    = static_cast<int64_t>(std::floor((_mask.region.top - extent) * static_cast<float>(height))) - 1;
+	auto right  = static_cast<int64_t>(std::ceil((_mask.region.right + extent) * static_cast<float>(width))) + 1;
+	auto bottom = static_cast<int64_t>(std::ceil((_mask.region.bottom + extent) * static_cast<float>(height))) + 1;
+	left        = std::clamp<int64_t>(left, 0, width);
+	top         = std::clamp<int64_t>(top, 0, height);
+	right       = std::clamp<int64_t>(right, 0, width);
+	bottom      = std::clamp<int64_t>(bottom, 0, height);
+	if ((right <= left) || (bottom <= top)) {
+		return {};
+	}
+
+	return ::streamfx::gfx::blur::region{static_cast<uint32_t>(left), static_cast<uint32_t>(top), static_cast<uint32_t>(right - left), static_cast<uint32_t>(bottom - top)};
+}
+
 void blur_instance::load(obs_data_t* settings)
 {
 	update(settings);
@@ -255,23 +348,8 @@ void blur_instance::migrate(obs_data_t* settings, uint64_t version)
 
 void blur_instance::update(obs_data_t* settings)
 {
-	{ // Blur Type
-		const char* blur_type      = obs_data_get_string(settings, ST_KEY_TYPE);
-		const char* blur_subtype   = obs_data_get_string(settings, ST_KEY_SUBTYPE);
-		const char* last_blur_type = obs_data_get_string(settings, ST_KEY_TYPE ".last");
-
-		auto type_found = list_of_types.find(blur_type);
-		if (type_found != list_of_types.end()) {
-			auto subtype_found = list_of_subtypes.find(blur_subtype);
-			if (subtype_found != list_of_subtypes.end()) {
-				if ((strcmp(last_blur_type, blur_type) != 0) || (_blur->get_type() != subtype_found->second.type)) {
-					if (type_found->second.fn().is_type_supported(subtype_found->second.type)) {
-						_blur = type_found->second.fn().create(subtype_found->second.type);
-					}
-				}
-			}
-		}
-	}
+	_cache.dirty    = true;
+	_amortize.dirty = true;
 
 	{ // Blur Parameters
 		this->_blur_size          = obs_data_get_double(settings, ST_KEY_SIZE);
@@ -283,6 +361,38 @@ void blur_instance::update(obs_data_t* settings)
 		this->_blur_step_scaling      = obs_data_get_bool(settings, ST_KEY_STEPSCALE);
 		this->_blur_step_scale.first  = obs_data_get_double(settings, ST_KEY_STEPSCALE_X) / 100.0;
 		this->_blur_step_scale.second = obs_data_get_double(settings, ST_KEY_STEPSCALE_Y) / 100.0;
+
+		// Resolution
+		this->_blur_resolution = static_cast<::streamfx::gfx::blur::resolution>(obs_data_get_int(settings, ST_KEY_RESOLUTION));
+
+		// Update Rate
+		this->_amortize.rate  = std::max<int64_t>(obs_data_get_int(settings, ST_KEY_UPDATERATE), 1);
+		this->_amortize.blend = obs_data_get_bool(settings, ST_KEY_UPDATERATE_BLEND);
+
+		// Cache
+		this->_cache.enabled = obs_data_get_bool(settings, ST_KEY_CACHE);
+	}
+
+	{ // Blur Type
+		const char* blur_type    = obs_data_get_string(settings, ST_KEY_TYPE);
+		const char* blur_subtype = obs_data_get_string(settings, ST_KEY_SUBTYPE);
+
+		auto type_found = list_of_types.find(blur_type);
+		if (type_found != list_of_types.end()) {
+			auto subtype_found = list_of_subtypes.find(blur_subtype);
+			if (subtype_found != list_of_subtypes.end()) {
+				if (type_found->second.fn().is_type_supported(subtype_found->second.type)) {
+					// Everything that is applied to the blur in video_tick() has to be part of the key, as all filters
+					// sharing the blur apply it.
+					std::string key = std::string(blur_type) + "/" + blur_subtype + "/" + std::to_string(_blur_size) + "/" + std::to_string(_blur_angle) + "/" + std::to_string(_blur_center.first) + "/" + std::to_string(_blur_center.second) + "/" + std::to_string(static_cast<int64_t>(_blur_resolution));
+					if (_blur_step_scaling) {
+						key += "/" + std::to_string(_blur_step_scale.first) + "/" + std::to_string(_blur_step_scale.second);
+					}
+
+					_blur = blur_factory::instance()->acquire_blur(key, [&type_found, &subtype_found]() { return type_found->second.fn().create(subtype_found->second.type); });
+				}
+			}
+		}
 	}
 
 	{ // Masking
@@ -320,6 +430,25 @@ void blur_instance::update(obs_data_t* settings)
 
 void blur_instance::video_tick(float)
 {
+	_amortize.frame++;
+
+	// Cache
+	if (_cache.enabled != static_cast<bool>(_cache.detector)) {
+		if (_cache.enabled) {
+			try {
+				auto gctx       = streamfx::obs::gs::context();
+				_cache.detector = std::make_shared<streamfx::gfx::change_detector>();
+				_cache.dirty    = true;
+			} catch (const std::exception& ex) {
+				DLOG_ERROR("<filter-blur> Instance '%s' failed to set up caching: %s", obs_source_get_name(_self), ex.what());
+				_cache.enabled = false;
+			}
+		} else {
+			release_retained();
+			_cache.detector.reset();
+		}
+	}
+
 	// Blur
 	if (_blur) {
 		_blur->set_size(_blur_size);
@@ -336,6 +465,9 @@ void blur_instance::video_tick(float)
 			auto obj = std::dynamic_pointer_cast<::streamfx::gfx::blur::base_center>(_blur);
 			obj->set_center(_blur_center.first, _blur_center.second);
 		}
+		if (auto obj = std::dynamic_pointer_cast<::streamfx::gfx::blur::base_resolution>(_blur); obj) {
+			obj->set_resolution(_blur_resolution);
+		}
 	}
 
 	// Load Mask
@@ -344,6 +476,7 @@ void blur_instance::video_tick(float)
 			try {
 				_mask.image.texture  = std::make_shared<streamfx::obs::gs::texture>(_mask.image.path);
 				_mask.image.path_old = _mask.image.path;
+				_cache.dirty         = true;
 			} catch (...) {
 				DLOG_ERROR("<filter-blur> Instance '%s' failed to load image '%s'.", obs_source_get_name(_self), _mask.image.path.c_str());
 			}
@@ -362,6 +495,8 @@ void blur_instance::video_tick(float)
 
 	_source_rendered = false;
 	_output_rendered = false;
+	_source_texture.reset();
+	_output_texture.reset();
 }
 
 void blur_instance::video_render(gs_effect_t* effect)
@@ -390,8 +525,9 @@ void blur_instance::video_render(gs_effect_t* effect)
 #endif
 
 			if (obs_source_process_filter_begin(this->_self, GS_RGBA, OBS_ALLOW_DIRECT_RENDERING)) {
+				auto rt = _pool->acquire(baseW, baseH);
 				{
-					auto op = this->_source_rt->render(baseW, baseH);
+					auto op = rt->render(baseW, baseH);
 
 					gs_blend_state_push();
 					gs_reset_blend_state();
@@ -419,7 +555,7 @@ void blur_instance::video_render(gs_effect_t* effect)
 					gs_blend_state_pop();
 				}
 
-				_source_texture = this->_source_rt->get_texture();
+				_source_texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 				if (!_source_texture) {
 					obs_source_skip_video_filter(this->_self);
 					return;
@@ -434,17 +570,104 @@ void blur_instance::video_render(gs_effect_t* effect)
 	}
 
 	if (!_output_rendered) {
-		{
+		// Reuse the retained result while the input is known to be identical to the one it was rendered from. Results
+		// of the comparison describe the input from a few frames ago, so the retained result is only trusted once every
+		// comparison over that many frames found the input unchanged. It is dropped again on the first change, which
+		// therefore shows up that many frames late.
+		bool reuse  = false;
+		bool retain = false;
+		if (_cache.enabled && _cache.detector) {
+			if (_cache.dirty || !_cache.blurred) {
+				retain = true;
+			} else if (_cache.skip > 0) {
+				// Inputs that keep changing would pay for the comparison every frame without ever reusing anything.
+				_cache.skip--;
+			} else {
+				switch (_cache.detector->compare(_source_texture)) {
+				case streamfx::gfx::change_detector::result::Unchanged:
+					if (++_cache.unchanged >= _cache.detector->get_latency()) {
+						reuse          = true;
+						_cache.backoff = 0;
+					}
+					break;
+				case streamfx::gfx::change_detector::result::Changed:
+					retain           = true;
+					_cache.unchanged = 0;
+					_cache.skip      = _cache.backoff;
+					_cache.backoff   = std::min<uint64_t>(std::max<uint64_t>(_cache.backoff * 2, 1), ST_CACHE_MAX_BACKOFF);
+					break;
+				case streamfx::gfx::change_detector::result::Unknown:
+					break;
+				}
+			}
+
+			if (reuse) {
+				_cache.hits++;
+			} else {
+				_cache.misses++;
+			}
+			if (auto prof = profiler(); prof) {
+				prof->track_reuse(reuse);
+			}
+		}
+
+		// In between updates the latest result stands in for the blur of the current input. It must never be retained
+		// as the result of an input it was not rendered from.
+		bool amortized = !reuse && (_amortize.rate > 1) && !_amortize.dirty && _amortize.latest && (_amortize.frame < static_cast<uint64_t>(_amortize.rate));
+		if (amortized) {
+			retain = false;
+		}
+
+		if (reuse) {
+			_output_texture = _cache.blurred;
+		} else if (amortized) {
+			_output_texture = _amortize.latest;
+		} else {
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_convert, "Blur"};
 #endif
 
+			if (auto obj = std::dynamic_pointer_cast<::streamfx::gfx::blur::base_region>(_blur); obj) {
+				obj->set_region(get_blur_region(baseW, baseH));
+			}
 			_blur->set_input(_source_texture);
 			_output_texture = _blur->render();
+			_blur->set_input(nullptr);
+
+			if (_amortize.rate > 1) {
+				// Changed parameters are shown right away instead of being faded to.
+				_amortize.previous = (_amortize.blend && !_amortize.dirty) ? _amortize.latest : nullptr;
+				_amortize.latest   = _output_texture;
+				_amortize.frame    = 0;
+				_amortize.dirty    = false;
+			} else {
+				_amortize.previous.reset();
+				_amortize.latest.reset();
+			}
+		}
+		auto blurred_texture = _output_texture;
+
+		// Fade from the previous to the latest result until the next update.
+		if (!reuse && _amortize.previous) {
+			float factor = static_cast<float>(_amortize.frame + 1) / static_cast<float>(_amortize.rate);
+			if ((factor < 1.f) && _effect_mask) {
+#if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
+				streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_convert, "Blend"};
+#endif
+
+				if (auto blended = render_blend(_amortize.previous, _amortize.latest, factor, baseW, baseH); blended) {
+					_output_texture = blended;
+					retain          = false;
+				}
+			} else {
+				_amortize.previous.reset();
+			}
 		}
 
 		// Mask
-		if (_mask.enabled) {
+		if (reuse && _mask.enabled && (_mask.type != mask_type::Source)) {
+			_output_texture = _cache.output;
+		} else if (_mask.enabled) {
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_convert, "Mask"};
 #endif
@@ -512,8 +735,10 @@ void blur_instance::video_render(gs_effect_t* effect)
 
 			apply_mask_parameters(_effect_mask, _source_texture->get_object(), _output_texture->get_object());
 
+			std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
 			try {
-				auto op = this->_output_rt->render(baseW, baseH);
+				rt      = _pool->acquire(baseW, baseH);
+				auto op = rt->render(baseW, baseH);
 				gs_ortho(0, 1, 0, 1, -1, 1);
 
 				// Render
@@ -527,12 +752,20 @@ void blur_instance::video_render(gs_effect_t* effect)
 			}
 			gs_blend_state_pop();
 
-			if (!(_output_texture = this->_output_rt->get_texture())) {
+			if (!(_output_texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt))) {
 				obs_source_skip_video_filter(this->_self);
 				return;
 			}
 		}
 
+		if (retain && blurred_texture && _output_texture) {
+			_cache.detector->set_reference(_source_texture);
+			_cache.blurred   = blurred_texture;
+			_cache.output    = _output_texture;
+			_cache.dirty     = false;
+			_cache.unchanged = 0;
+		}
+
 		_output_rendered = true;
 	}
 
@@ -569,6 +802,32 @@ void blur_instance::video_render(gs_effect_t* effect)
 	}
 }
 
+void blur_instance::hide()
+{
+	release_retained();
+}
+
+void blur_instance::deactivate()
+{
+	release_retained();
+}
+
+void blur_instance::release_retained()
+{
+	// Filters that are hidden or inactive may not be rendered for a long time, and their results would keep render
+	// targets away from everyone else until then.
+	auto gctx = streamfx::obs::gs::context();
+	if (_cache.detector) {
+		_cache.detector->set_reference(nullptr);
+	}
+	_cache.blurred.reset();
+	_cache.output.reset();
+	_cache.dirty = true;
+	_amortize.previous.reset();
+	_amortize.latest.reset();
+	_amortize.dirty = true;
+}
+
 blur_factory::blur_factory()
 {
 	_info.id           = S_PREFIX "filter-blur";
@@ -576,6 +835,8 @@ blur_factory::blur_factory()
 	_info.output_flags = OBS_SOURCE_VIDEO;
 
 	support_size(false);
+	support_activity_tracking(true);
+	support_visibility_tracking(true);
 	finish_setup();
 	register_proxy("obs-stream-effects-filter-blur");
 }
@@ -601,6 +862,10 @@ void blur_factory::get_defaults2(obs_data_t* settings)
 	obs_data_set_default_bool(settings, ST_KEY_STEPSCALE, false);
 	obs_data_set_default_double(settings, ST_KEY_STEPSCALE_X, 1.);
 	obs_data_set_default_double(settings, ST_KEY_STEPSCALE_Y, 1.);
+	obs_data_set_default_int(settings, ST_KEY_RESOLUTION, static_cast<int64_t>(::streamfx::gfx::blur::resolution::Automatic));
+	obs_data_set_default_int(settings, ST_KEY_UPDATERATE, 1);
+	obs_data_set_default_bool(settings, ST_KEY_UPDATERATE_BLEND, false);
+	obs_data_set_default_bool(settings, ST_KEY_CACHE, false);
 
 	// Masking
 	obs_data_set_default_bool(settings, ST_KEY_MASK, false);
@@ -683,10 +948,11 @@ bool modified_properties(void*, obs_properties_t* props, obs_property* prop, obs
 
 		// Blur Sub-Type
 		{
-			bool has_angle_support     = (subtype_found->second.type == ::streamfx::gfx::blur::type::Directional) || (subtype_found->second.type == ::streamfx::gfx::blur::type::Rotational);
-			bool has_center_support    = (subtype_found->second.type == ::streamfx::gfx::blur::type::Rotational) || (subtype_found->second.type == ::streamfx::gfx::blur::type::Zoom);
-			bool has_stepscale_support = type_found->second.fn().is_step_scale_supported(subtype_found->second.type);
-			bool show_scaling          = obs_data_get_bool(settings, ST_KEY_STEPSCALE) && has_stepscale_support;
+			bool has_angle_support      = (subtype_found->second.type == ::streamfx::gfx::blur::type::Directional) || (subtype_found->second.type == ::streamfx::gfx::blur::type::Rotational);
+			bool has_center_support     = (subtype_found->second.type == ::streamfx::gfx::blur::type::Rotational) || (subtype_found->second.type == ::streamfx::gfx::blur::type::Zoom);
+			bool has_stepscale_support  = type_found->second.fn().is_step_scale_supported(subtype_found->second.type);
+			bool show_scaling           = obs_data_get_bool(settings, ST_KEY_STEPSCALE) && has_stepscale_support;
+			bool has_resolution_support = ((strcmp(vtype, "box") == 0) || (strcmp(vtype, "gaussian") == 0)) && (subtype_found->second.type == ::streamfx::gfx::blur::type::Area);
 
 			/// Size
 			p = obs_properties_get(props, ST_KEY_SIZE);
@@ -709,6 +975,12 @@ bool modified_properties(void*, obs_properties_t* props, obs_property* prop, obs
 			p = obs_properties_get(props, ST_KEY_STEPSCALE_Y);
 			obs_property_set_visible(p, show_scaling);
 			obs_property_float_set_limits(p, type_found->second.fn().get_min_step_scale_x(subtype_found->second.type), type_found->second.fn().get_max_step_scale_x(subtype_found->second.type), type_found->second.fn().get_step_step_scale_x(subtype_found->second.type));
+
+			/// Resolution
+			obs_property_set_visible(obs_properties_get(props, ST_KEY_RESOLUTION), has_resolution_support);
+
+			/// Update Rate
+			obs_property_set_visible(obs_properties_get(props, ST_KEY_UPDATERATE_BLEND), obs_data_get_int(settings, ST_KEY_UPDATERATE) > 1);
 		}
 
 		{ // Masking
@@ -758,6 +1030,7 @@ obs_properties_t* blur_factory::get_properties2(blur_instance* data)
 		obs_property_list_add_string(p, D_TRANSLATE(S_BLUR_TYPE_GAUSSIAN), "gaussian");
 		obs_property_list_add_string(p, D_TRANSLATE(S_BLUR_TYPE_GAUSSIAN_LINEAR), "gaussian_linear");
 		obs_property_list_add_string(p, D_TRANSLATE(S_BLUR_TYPE_DUALFILTERING), "dual_filtering");
+		obs_property_list_add_string(p, D_TRANSLATE(S_BLUR_TYPE_AUTOMATIC), "automatic");
 
 		p = obs_properties_add_list(pr, ST_KEY_SUBTYPE, D_TRANSLATE(ST_I18N_SUBTYPE), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_STRING);
 		obs_property_set_modified_callback2(p, modified_properties, this);
@@ -778,6 +1051,19 @@ obs_properties_t* blur_factory::get_properties2(blur_instance* data)
 		obs_property_set_modified_callback2(p, modified_properties, this);
 		p = obs_properties_add_float_slider(pr, ST_KEY_STEPSCALE_X, D_TRANSLATE(ST_I18N_STEPSCALE_X), 0.0, 1000.0, 0.01);
 		p = obs_properties_add_float_slider(pr, ST_KEY_STEPSCALE_Y, D_TRANSLATE(ST_I18N_STEPSCALE_Y), 0.0, 1000.0, 0.01);
+
+		p = obs_properties_add_list(pr, ST_KEY_RESOLUTION, D_TRANSLATE(ST_I18N_RESOLUTION), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+		obs_property_list_add_int(p, D_TRANSLATE(S_STATE_AUTOMATIC), static_cast<int64_t>(::streamfx::gfx::blur::resolution::Automatic));
+		obs_property_list_add_int(p, D_TRANSLATE(ST_I18N_RESOLUTION_FULL), static_cast<int64_t>(::streamfx::gfx::blur::resolution::Full));
+		obs_property_list_add_int(p, D_TRANSLATE(ST_I18N_RESOLUTION_HALF), static_cast<int64_t>(::streamfx::gfx::blur::resolution::Half));
+		obs_property_list_add_int(p, D_TRANSLATE(ST_I18N_RESOLUTION_QUARTER), static_cast<int64_t>(::streamfx::gfx::blur::resolution::Quarter));
+
+		p = obs_properties_add_int_slider(pr, ST_KEY_UPDATERATE, D_TRANSLATE(ST_I18N_UPDATERATE), 1, 60, 1);
+		obs_property_set_modified_callback2(p, modified_properties, this);
+		p = obs_properties_add_bool(pr, ST_KEY_UPDATERATE_BLEND, D_TRANSLATE(ST_I18N_UPDATERATE_BLEND));
+
+		// Off by default, as a change to a previously static input is only noticed a few frames late.
+		p = obs_properties_add_bool(pr, ST_KEY_CACHE, D_TRANSLATE(ST_I18N_CACHE));
 	}
 
 	// Masking
@@ -838,6 +1124,30 @@ std::string blur_factory::translate_string(const char* format, ...)
 	return std::string(buffer.data(), buffer.data() + len);
 }
 
+std::shared_ptr<::streamfx::gfx::blur::base> blur_factory::acquire_blur(std::string const& key, std::function<std::shared_ptr<::streamfx::gfx::blur::base>()> create)
+{
+	std::unique_lock<decltype(_blurs_lock)> lock(_blurs_lock);
+
+	// Forget about blurs that no filter uses anymore.
+	for (auto iter = _blurs.begin(); iter != _blurs.end();) {
+		if (iter->second.expired()) {
+			iter = _blurs.erase(iter);
+		} else {
+			iter++;
+		}
+	}
+
+	if (auto iter = _blurs.find(key); iter != _blurs.end()) {
+		if (auto blur = iter->second.lock(); blur) {
+			return blur;
+		}
+	}
+
+	auto blur   = create();
+	_blurs[key] = blur;
+	return blur;
+}
+
 bool blur_factory::on_manual_open(obs_properties_t* props, obs_property_t* property, void* data)
 {
 	try {
@@ -5,11 +5,12 @@
 #pragma once
 #include "common.hpp"
 #include "gfx/blur/gfx-blur-base.hpp"
+#include "gfx/gfx-change-detector.hpp"
 #include "gfx/gfx-source-texture.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
 #include "obs/gs/gs-helper.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 #include "obs/obs-source-factory.hpp"
 
@@ -18,6 +19,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <mutex>
 #include "warning-enable.hpp"
 
 namespace streamfx::filter::blur {
@@ -32,15 +34,40 @@ namespace streamfx::filter::blur {
 		streamfx::obs::gs::effect            _effect_mask;
 		std::shared_ptr<streamfx::gfx::util> _gfx_util;
 
+		// Render Targets, borrowed until the next tick.
+		std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+
 		// Input
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _source_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _source_texture;
-		bool                                             _source_rendered;
+		std::shared_ptr<streamfx::obs::gs::texture> _source_texture;
+		bool                                        _source_rendered;
 
 		// Rendering
-		std::shared_ptr<streamfx::obs::gs::texture>      _output_texture;
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _output_rt;
-		bool                                             _output_rendered;
+		std::shared_ptr<streamfx::obs::gs::texture> _output_texture;
+		bool                                        _output_rendered;
+
+		// Caching, so that unchanged input is not blurred again.
+		struct {
+			bool                                            enabled;
+			bool                                            dirty;    // Parameters changed since the result was retained.
+			std::shared_ptr<streamfx::gfx::change_detector> detector; // Holds the input the result was rendered from.
+			std::shared_ptr<streamfx::obs::gs::texture>     blurred;
+			std::shared_ptr<streamfx::obs::gs::texture>     output;    // Blurred and masked.
+			std::size_t                                     unchanged; // Comparisons in a row that found no change.
+			uint64_t                                        skip;      // Frames left to skip comparing for.
+			uint64_t                                        backoff;   // Frames to skip comparing for after a change.
+			uint64_t                                        hits;
+			uint64_t                                        misses;
+		} _cache;
+
+		// Amortization, so that the blur is only rendered every few frames.
+		struct {
+			int64_t                                     rate;  // Render the blur every n-th frame.
+			bool                                        blend; // Fade from the previous to the latest result in between.
+			bool                                        dirty; // Parameters changed since the latest result.
+			uint64_t                                    frame; // Frames since the latest result was rendered.
+			std::shared_ptr<streamfx::obs::gs::texture> previous;
+			std::shared_ptr<streamfx::obs::gs::texture> latest;
+		} _amortize;
 
 		// Blur
 		std::shared_ptr<::streamfx::gfx::blur::base> _blur;
@@ -49,6 +76,7 @@ namespace streamfx::filter::blur {
 		std::pair<double_t, double_t>                _blur_center;
 		bool                                         _blur_step_scaling;
 		std::pair<double_t, double_t>                _blur_step_scale;
+		::streamfx::gfx::blur::resolution            _blur_resolution;
 
 		// Masking
 		struct {
@@ -83,6 +111,24 @@ namespace streamfx::filter::blur {
 			} color;
 			float multiplier;
 		} _mask;
+		struct {
+			streamfx::obs::gs::effect_parameter_handle image_orig{"image_orig"};
+			streamfx::obs::gs::effect_parameter_handle image_blur{"image_blur"};
+			streamfx::obs::gs::effect_parameter_handle region_left{"mask_region_left"};
+			streamfx::obs::gs::effect_parameter_handle region_right{"mask_region_right"};
+			streamfx::obs::gs::effect_parameter_handle region_top{"mask_region_top"};
+			streamfx::obs::gs::effect_parameter_handle region_bottom{"mask_region_bottom"};
+			streamfx::obs::gs::effect_parameter_handle region_feather{"mask_region_feather"};
+			streamfx::obs::gs::effect_parameter_handle region_feather_shift{"mask_region_feather_shift"};
+			streamfx::obs::gs::effect_parameter_handle image{"mask_image"};
+			streamfx::obs::gs::effect_parameter_handle color{"mask_color"};
+			streamfx::obs::gs::effect_parameter_handle multiplier{"mask_multiplier"};
+		} _mask_parameters;
+		struct {
+			streamfx::obs::gs::effect_parameter_handle image_orig{"image_orig"};
+			streamfx::obs::gs::effect_parameter_handle image_blur{"image_blur"};
+			streamfx::obs::gs::effect_parameter_handle factor{"blend_factor"};
+		} _blend_parameters;
 
 		public:
 		blur_instance(obs_data_t* settings, obs_source_t* self);
@@ -96,13 +142,28 @@ namespace streamfx::filter::blur {
 		virtual void video_tick(float time) override;
 		virtual void video_render(gs_effect_t* effect) override;
 
+		virtual void hide() override;
+		virtual void deactivate() override;
+
 		private:
+		// Hand everything retained for caching and amortization back to the pool, to be rendered again when needed.
+		void release_retained();
+
 		bool apply_mask_parameters(streamfx::obs::gs::effect effect, gs_texture_t* original_texture, gs_texture_t* blurred_texture);
+
+		// Fade from one texture to another, at the given factor between 0 (from) and 1 (to).
+		std::shared_ptr<streamfx::obs::gs::texture> render_blend(std::shared_ptr<streamfx::obs::gs::texture> from, std::shared_ptr<streamfx::obs::gs::texture> to, float factor, uint32_t width, uint32_t height);
+
+		// Area of the blurred image that the mask actually uses, in texels.
+		::streamfx::gfx::blur::region get_blur_region(uint32_t width, uint32_t height);
 	};
 
 	class blur_factory : public obs::source_factory<filter::blur::blur_factory, filter::blur::blur_instance> {
 		std::vector<std::string> _translation_cache;
 
+		std::mutex                                                        _blurs_lock;
+		std::map<std::string, std::weak_ptr<::streamfx::gfx::blur::base>> _blurs;
+
 		public:
 		blur_factory();
 		virtual ~blur_factory();
@@ -117,6 +178,14 @@ namespace streamfx::filter::blur {
 
 		static bool on_manual_open(obs_properties_t* props, obs_property_t* property, void* data);
 
+		/** Retrieve the blur shared by all filters with the given settings, or create it.
+		 *
+		 * Filters render one after another on the graphics thread, so one blur can serve all of them as long as each
+		 * sets its own input and region right before rendering. Identical filters then share a single kernel, effect
+		 * state and parameter binding instead of each keeping their own.
+		 */
+		std::shared_ptr<::streamfx::gfx::blur::base> acquire_blur(std::string const& key, std::function<std::shared_ptr<::streamfx::gfx::blur::base>()> create);
+
 		public: // Singleton
 		static std::shared_ptr<blur_factory> instance();
 	};
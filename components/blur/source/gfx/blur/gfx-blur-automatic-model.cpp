@@ -0,0 +1,218 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gfx-blur-automatic-model.hpp"
+#include "common.hpp"
+#include "gfx-blur-automatic.hpp"
+#include "gfx-blur-gaussian-linear.hpp"
+#include "gfx-blur-gaussian.hpp"
+#include "gfx-blur-kernel-cache.hpp"
+#include "gfx-blur-scale.hpp"
+#include "plugin.hpp"
+#include "util/util-benchmark.hpp"
+
+#include "warning-disable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "warning-enable.hpp"
+
+// Linear sampling reads two texels with every sample, and every time the image is halved in size the remaining blur
+//  needs half the samples on a quarter of the pixels. Small sizes instead place their samples a third of a texel
+//  apart, as pairs of whole texels are too coarse for them. The thresholds were chosen by comparing the model below
+//  against a true Gaussian blur of a hard edge, in steps of 1/8 up to a size of 32:
+//   Subtexel: Below 3 levels of difference up to a deviation of 5.
+//   Linear:   Below 3.5 levels of difference from a deviation of 5 up to 16, getting worse above.
+//   Pyramid:  Below 4 levels of difference as long as the lowest level stays at or below 16.
+
+#define ST_LINEAR_THRESHOLD 5.
+#define ST_SUBTEXEL_STEP (1. / 3.)
+#define ST_SUBTEXEL_VARIANCE (1. / 6.)
+#define ST_PYRAMID_THRESHOLD 16.
+#define ST_MAX_LEVELS 6
+
+::streamfx::gfx::blur::automatic::plan streamfx::gfx::blur::automatic::get_plan(double_t size)
+{
+	if (size < ST_LINEAR_THRESHOLD) {
+		// Bilinear filtering between the samples already blurs by a variance of about 1/6 on average, so only what is
+		// still missing after that is left for the kernel.
+		double_t deviation = std::sqrt(size * size - ST_SUBTEXEL_VARIANCE) / ST_SUBTEXEL_STEP;
+		return plan{strategy::Subtexel, 0, ::streamfx::gfx::blur::gaussian_linear_data::find_width(deviation), ST_SUBTEXEL_STEP};
+	}
+
+	// Halving the image averages pairs of texels, which already blurs it a little. Only the variance that is
+	// still missing after that has to be made up for by the blur at the lowest level.
+	std::size_t levels    = 0;
+	double_t    deviation = size;
+	while ((deviation > ST_PYRAMID_THRESHOLD) && (levels < ST_MAX_LEVELS)) {
+		levels++;
+		double_t scale = double_t(1ull << levels);
+		deviation      = std::sqrt(size * size - ::streamfx::gfx::blur::get_downsample_variance(levels)) / scale;
+	}
+
+	return plan{(levels > 0) ? strategy::Pyramid : strategy::Linear, levels, ::streamfx::gfx::blur::gaussian_linear_data::find_width(deviation), 1.};
+}
+
+namespace {
+	typedef std::vector<double_t> row_t;
+
+	// What an 8-bit render target stores.
+	double_t quantize(double_t v)
+	{
+		return std::round(std::clamp(v, 0., 1.) * 255.) / 255.;
+	}
+
+	// What a clamping sampler reads at a texel.
+	double_t texel(row_t const& row, int64_t x)
+	{
+		return row[static_cast<size_t>(std::clamp<int64_t>(x, 0, int64_t(row.size()) - 1))];
+	}
+
+	// What a clamping sampler with bilinear filtering reads at a position in texels.
+	double_t sample(row_t const& row, double_t x)
+	{
+		double_t base = std::floor(x);
+		double_t frac = x - base;
+		return texel(row, int64_t(base)) * (1. - frac) + texel(row, int64_t(base) + 1) * frac;
+	}
+
+	// 'gaussian-linear.effect', which reads pairs of kernel weights with one sample and does not normalize. The
+	// vertical pass only scales the rows of an edge by the sum of all weights.
+	row_t blur_linear(row_t const& row, double_t size, double_t step)
+	{
+		auto    kernel = ::streamfx::gfx::blur::kernel_cache::instance()->get(::streamfx::gfx::blur::kernel_cache::type::GAUSSIAN_LINEAR, size, &::streamfx::gfx::blur::gaussian_linear_data::generate_kernel);
+		auto    width  = static_cast<int64_t>(std::lround(size));
+		bool    odd    = ((width % 2) == 1);
+		int64_t pairs  = 1;
+
+		double_t total = kernel[0];
+		for (; (pairs < int64_t(::streamfx::gfx::blur::gaussian_linear_data::kernel_size)) && (double_t(pairs) < size); pairs += 2) {
+			total += (kernel[static_cast<size_t>(pairs)] + kernel[static_cast<size_t>(pairs + 1)]) * 2.;
+		}
+		if (odd) {
+			total += kernel[static_cast<size_t>(width)] * 2.;
+		}
+
+		row_t result(row.size());
+		for (int64_t x = 0; x < int64_t(row.size()); x++) {
+			double_t value = texel(row, x) * kernel[0];
+			for (int64_t n = 1; n < pairs; n += 2) {
+				double_t weight = kernel[static_cast<size_t>(n)] + kernel[static_cast<size_t>(n + 1)];
+				double_t offset = step * (double_t(n) + .5);
+				value += weight * (sample(row, double_t(x) + offset) + sample(row, double_t(x) - offset));
+			}
+			if (odd) {
+				double_t offset = step * double_t(width);
+				value += kernel[static_cast<size_t>(width)] * (sample(row, double_t(x) + offset) + sample(row, double_t(x) - offset));
+			}
+			result[static_cast<size_t>(x)] = quantize(value);
+		}
+		for (auto& value : result) {
+			value = quantize(value * total);
+		}
+		return result;
+	}
+
+	// Bilinear filtering at half the size averages every pair of texels.
+	row_t downsample_row(row_t const& row)
+	{
+		row_t result(std::max<size_t>(row.size() / 2, 1));
+		for (size_t x = 0; x < result.size(); x++) {
+			result[x] = quantize((texel(row, int64_t(x * 2)) + texel(row, int64_t(x * 2 + 1))) * .5);
+		}
+		return result;
+	}
+
+	row_t upsample_row(row_t const& row, uint32_t width)
+	{
+		double_t scale = double_t(width) / double_t(row.size());
+		row_t    result(width);
+		for (uint32_t x = 0; x < width; x++) {
+			result[x] = quantize(sample(row, (double_t(x) + .5) / scale - .5));
+		}
+		return result;
+	}
+
+	void check(double_t size)
+	{
+		uint32_t width     = ::streamfx::gfx::blur::model::edge_width(size);
+		auto     reference = ::streamfx::gfx::blur::model::reference_edge(width, size);
+		auto     row       = ::streamfx::gfx::blur::model::automatic_edge(width, size);
+
+		double_t max_error = 0.;
+		double_t sum_error = 0.;
+		for (uint32_t x = 0; x < width; x++) {
+			double_t error = std::abs(row[x] - reference[x]) * 255.;
+			max_error      = std::max(max_error, error);
+			sum_error += error * error;
+		}
+
+		DLOG_INFO("Model of the Automatic Blur of size %.1f differs by up to %.2f levels from a true Gaussian blur, %.2f on average.", size, max_error, std::sqrt(sum_error / width));
+		if (max_error > ::streamfx::gfx::blur::model::error_bound) {
+			throw std::runtime_error("Difference of " + std::to_string(max_error) + " levels is above the bound.");
+		}
+	}
+} // namespace
+
+uint32_t streamfx::gfx::blur::model::edge_width(double_t size)
+{
+	return static_cast<uint32_t>(std::ceil(size * 12. / 64.) + 1) * 64;
+}
+
+std::vector<double_t> streamfx::gfx::blur::model::reference_edge(uint32_t width, double_t deviation)
+{
+	auto                  radius = static_cast<int64_t>(std::ceil(deviation * 5.));
+	std::vector<double_t> weights(static_cast<size_t>(radius * 2 + 1));
+	double_t              total = 0.;
+	for (int64_t idx = -radius; idx <= radius; idx++) {
+		double_t v = static_cast<double_t>(idx) / deviation;
+		double_t w = std::exp(-0.5 * v * v);
+		weights[static_cast<size_t>(idx + radius)] = w;
+		total += w;
+	}
+
+	std::vector<double_t> row(width);
+	for (int64_t x = 0; x < int64_t(width); x++) {
+		double_t v = 0.;
+		for (int64_t idx = -radius; idx <= radius; idx++) {
+			int64_t sx = std::clamp<int64_t>(x + idx, 0, int64_t(width) - 1);
+			v += (sx >= int64_t(width / 2)) ? weights[static_cast<size_t>(idx + radius)] : 0.;
+		}
+		row[static_cast<size_t>(x)] = v / total;
+	}
+	return row;
+}
+
+std::vector<double_t> streamfx::gfx::blur::model::automatic_edge(uint32_t width, double_t size)
+{
+	// Black on the left half, white on the right half.
+	row_t row(width, 1.);
+	std::fill(row.begin(), row.begin() + (width / 2), 0.);
+
+	auto plan = ::streamfx::gfx::blur::automatic::get_plan(size);
+	switch (plan.type) {
+	case ::streamfx::gfx::blur::automatic::strategy::Subtexel:
+	case ::streamfx::gfx::blur::automatic::strategy::Linear:
+		return blur_linear(row, plan.inner_size, plan.step);
+	case ::streamfx::gfx::blur::automatic::strategy::Pyramid:
+		for (std::size_t n = 0; n < plan.levels; n++) {
+			row = downsample_row(row);
+		}
+		return upsample_row(blur_linear(row, plan.inner_size, plan.step), width);
+	}
+	return row;
+}
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		// Every size up to where the pyramid is first used, and from there on often enough to see every level.
+		for (double_t size = 1.; size <= 256.; size += ((size < 32.) ? 1. : 8.)) {
+			streamfx::util::benchmark::add("blur.automatic.model." + std::to_string(static_cast<int32_t>(size)), 1, [size]() -> streamfx::util::benchmark::function_t { return [size]() { check(size); }; });
+		}
+	},
+	[]() { // Finalizer
+	},
+	streamfx::loader_priority::NORMAL);
@@ -0,0 +1,38 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+
+#include "warning-disable.hpp"
+#include <vector>
+#include "warning-enable.hpp"
+
+// How close the Automatic Blur stays to a true Gaussian blur, measured on one row of a hard edge. The GPU result is
+// checked by the 'blur.automatic.error' benchmarks, and the same blur calculated on the CPU by 'blur.automatic.model'.
+
+namespace streamfx::gfx {
+	namespace blur {
+		namespace model {
+			// Largest allowed difference to a true Gaussian blur of a hard edge, in 8-bit levels. This leaves some
+			// room for the rounding that happens in every 8-bit intermediate render target.
+			constexpr double_t error_bound = 5.;
+
+			/** Width of an edge that the blur of the given size never reaches the borders of.
+			 *
+			 * Always a multiple of the largest downsampling factor.
+			 */
+			uint32_t edge_width(double_t size);
+
+			/** A true Gaussian blur of one row of the edge, with the borders clamped like the samplers do.
+			 */
+			std::vector<double_t> reference_edge(uint32_t width, double_t deviation);
+
+			/** One row of the edge as the Automatic Blur renders it, including the rounding of every 8-bit render
+			 * target in between. Needs no graphics device.
+			 */
+			std::vector<double_t> automatic_edge(uint32_t width, double_t size);
+		} // namespace model
+	} // namespace blur
+} // namespace streamfx::gfx
@@ -0,0 +1,347 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gfx-blur-automatic.hpp"
+#include "common.hpp"
+#include "gfx-blur-automatic-model.hpp"
+#include "gfx-blur-box.hpp"
+#include "gfx-blur-gaussian-linear.hpp"
+#include "gfx-blur-gaussian.hpp"
+#include "gfx-blur-scale.hpp"
+#include "obs/gs/gs-helper.hpp"
+#include "plugin.hpp"
+#include "util/util-benchmark.hpp"
+
+#include "warning-disable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "warning-enable.hpp"
+
+// Automatic Blur
+//
+// Which approach is used for which size is decided by get_plan() in 'gfx-blur-automatic-model.cpp'.
+
+#define ST_MAX_SIZE 256.
+
+streamfx::gfx::blur::automatic_factory::automatic_factory() {}
+
+streamfx::gfx::blur::automatic_factory::~automatic_factory() {}
+
+bool streamfx::gfx::blur::automatic_factory::is_type_supported(::streamfx::gfx::blur::type type)
+{
+	switch (type) {
+	case ::streamfx::gfx::blur::type::Area:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::shared_ptr<::streamfx::gfx::blur::base> streamfx::gfx::blur::automatic_factory::create(::streamfx::gfx::blur::type type)
+{
+	switch (type) {
+	case ::streamfx::gfx::blur::type::Area:
+		return std::make_shared<::streamfx::gfx::blur::automatic>();
+	default:
+		throw std::runtime_error("Invalid type.");
+	}
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_min_size(::streamfx::gfx::blur::type)
+{
+	return double_t(1.);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_step_size(::streamfx::gfx::blur::type)
+{
+	return double_t(1.);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_max_size(::streamfx::gfx::blur::type)
+{
+	return double_t(ST_MAX_SIZE);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_min_angle(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_step_angle(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_max_angle(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+bool streamfx::gfx::blur::automatic_factory::is_step_scale_supported(::streamfx::gfx::blur::type)
+{
+	return false;
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_min_step_scale_x(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_step_step_scale_x(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_max_step_scale_x(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_min_step_scale_y(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_step_step_scale_y(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+double_t streamfx::gfx::blur::automatic_factory::get_max_step_scale_y(::streamfx::gfx::blur::type)
+{
+	return double_t(0);
+}
+
+::streamfx::gfx::blur::automatic_factory& streamfx::gfx::blur::automatic_factory::get()
+{
+	static ::streamfx::gfx::blur::automatic_factory instance;
+	return instance;
+}
+
+streamfx::gfx::blur::automatic::automatic() : _size(0.), _strategy(strategy::Subtexel), _levels(0), _inner_size(0.), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _region()
+{
+	set_size(1.);
+}
+
+streamfx::gfx::blur::automatic::~automatic() {}
+
+void streamfx::gfx::blur::automatic::set_input(std::shared_ptr<::streamfx::obs::gs::texture> texture)
+{
+	_input_texture = std::move(texture);
+}
+
+::streamfx::gfx::blur::type streamfx::gfx::blur::automatic::get_type()
+{
+	return ::streamfx::gfx::blur::type::Area;
+}
+
+double_t streamfx::gfx::blur::automatic::get_size()
+{
+	return _size;
+}
+
+void streamfx::gfx::blur::automatic::set_size(double_t width)
+{
+	width = std::clamp<double_t>(width, 1., ST_MAX_SIZE);
+	if (width == _size) {
+		return;
+	}
+	_size = width;
+
+	auto plan   = get_plan(_size);
+	_strategy   = plan.type;
+	_levels     = plan.levels;
+	_inner_size = plan.inner_size;
+	if (!_linear) {
+		_linear = ::streamfx::gfx::blur::gaussian_linear_factory::get().create(::streamfx::gfx::blur::type::Area);
+	}
+	_linear->set_size(_inner_size);
+	_linear->set_step_scale(plan.step, plan.step);
+}
+
+void streamfx::gfx::blur::automatic::set_step_scale(double_t, double_t) {}
+
+void streamfx::gfx::blur::automatic::get_step_scale(double_t&, double_t&) {}
+
+std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::automatic::render()
+{
+	auto gctx = streamfx::obs::gs::context();
+
+#if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
+	auto gdmp = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Automatic Blur");
+#endif
+
+	std::shared_ptr<::streamfx::obs::gs::texture> output;
+	switch (_strategy) {
+	case strategy::Subtexel:
+	case strategy::Linear:
+		std::dynamic_pointer_cast<::streamfx::gfx::blur::base_region>(_linear)->set_region(_region);
+		_linear->set_input(_input_texture);
+		output = _linear->render();
+		break;
+	case strategy::Pyramid:
+		output = render_pyramid();
+		break;
+	}
+
+	_output_texture = output;
+	return output;
+}
+
+std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::automatic::render_pyramid()
+{
+	uint32_t width  = _input_texture->get_width();
+	uint32_t height = _input_texture->get_height();
+
+	auto level = ::streamfx::gfx::blur::downsample(_pool, _input_texture, _levels);
+
+	// Blur the lowest level, but only as much of it as is needed to scale the requested area back up.
+	std::dynamic_pointer_cast<::streamfx::gfx::blur::base_region>(_linear)->set_region(::streamfx::gfx::blur::downsample_region(_region, _levels, level->get_width(), level->get_height()));
+	_linear->set_input(level);
+	level = _linear->render();
+	_linear->set_input(nullptr);
+
+	return ::streamfx::gfx::blur::upsample(_pool, level, width, height, _region);
+}
+
+std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::automatic::get()
+{
+	return _output_texture.lock();
+}
+
+void streamfx::gfx::blur::automatic::set_region(::streamfx::gfx::blur::region area)
+{
+	_region = area;
+}
+
+::streamfx::gfx::blur::region streamfx::gfx::blur::automatic::get_region()
+{
+	return _region;
+}
+
+::streamfx::gfx::blur::automatic::strategy streamfx::gfx::blur::automatic::get_strategy()
+{
+	return _strategy;
+}
+
+namespace {
+	constexpr double_t benchmark_sizes[] = {1., 2., 3., 4., 8., 16., 24., 32., 64., 128., 256.};
+
+	const char* strategy_name(::streamfx::gfx::blur::automatic::strategy v)
+	{
+		switch (v) {
+		case ::streamfx::gfx::blur::automatic::strategy::Subtexel:
+			return "Subtexel";
+		case ::streamfx::gfx::blur::automatic::strategy::Linear:
+			return "Linear";
+		case ::streamfx::gfx::blur::automatic::strategy::Pyramid:
+			return "Pyramid";
+		}
+		return "Unknown";
+	}
+
+	// Black on the left half, white on the right half.
+	std::shared_ptr<::streamfx::obs::gs::texture> make_edge(uint32_t width, uint32_t height)
+	{
+		std::vector<uint8_t> data(static_cast<size_t>(width) * height * 4, 255);
+		for (uint32_t y = 0; y < height; y++) {
+			for (uint32_t x = 0; x < (width / 2); x++) {
+				uint8_t* px = &data[(static_cast<size_t>(y) * width + x) * 4];
+				px[0] = px[1] = px[2] = 0;
+			}
+		}
+
+		const uint8_t* mip = data.data();
+		return std::make_shared<::streamfx::obs::gs::texture>(width, height, GS_RGBA, 1, &mip, ::streamfx::obs::gs::texture::flags::None);
+	}
+
+	// Blur a hard edge on the GPU and compare the result against a true Gaussian blur done on the CPU.
+	void measure_error(double_t size)
+	{
+		uint32_t width  = ::streamfx::gfx::blur::model::edge_width(size);
+		uint32_t height = 64;
+
+		auto gctx  = streamfx::obs::gs::context();
+		auto input = make_edge(width, height);
+		auto blur  = std::make_shared<::streamfx::gfx::blur::automatic>();
+		blur->set_size(size);
+		blur->set_input(input);
+		auto output = blur->render();
+
+		std::shared_ptr<gs_stagesurf_t> staging(gs_stagesurface_create(width, height, GS_RGBA), [](gs_stagesurf_t* v) { gs_stagesurface_destroy(v); });
+		if (!staging) {
+			throw std::runtime_error("Failed to create staging surface.");
+		}
+		gs_stage_texture(staging.get(), output->get_object());
+
+		uint8_t* data     = nullptr;
+		uint32_t linesize = 0;
+		if (!gs_stagesurface_map(staging.get(), &data, &linesize)) {
+			throw std::runtime_error("Failed to read back the blurred image.");
+		}
+
+		auto           reference = ::streamfx::gfx::blur::model::reference_edge(width, size);
+		const uint8_t* row       = data + static_cast<size_t>(linesize) * (height / 2);
+		double_t       max_error = 0.;
+		double_t       sum_error = 0.;
+		for (uint32_t x = 0; x < width; x++) {
+			double_t error = std::abs(static_cast<double_t>(row[x * 4]) - reference[x] * 255.);
+			max_error      = std::max(max_error, error);
+			sum_error += error * error;
+		}
+		gs_stagesurface_unmap(staging.get());
+
+		DLOG_INFO("Automatic Blur of size %.1f (%s) differs by up to %.2f levels from a true Gaussian blur, %.2f on average.", size, strategy_name(blur->get_strategy()), max_error, std::sqrt(sum_error / width));
+		if (max_error > ::streamfx::gfx::blur::model::error_bound) {
+			throw std::runtime_error("Difference of " + std::to_string(max_error) + " levels is above the bound.");
+		}
+	}
+
+	streamfx::util::benchmark::function_t setup_render(std::shared_ptr<::streamfx::gfx::blur::base> blur, double_t size, ::streamfx::gfx::blur::region area = {}, ::streamfx::gfx::blur::resolution resolution = ::streamfx::gfx::blur::resolution::Automatic)
+	{
+		auto input = make_edge(1920, 1080);
+		blur->set_size(size);
+		blur->set_input(input);
+		if (auto obj = std::dynamic_pointer_cast<::streamfx::gfx::blur::base_region>(blur); obj) {
+			obj->set_region(area);
+		}
+		if (auto obj = std::dynamic_pointer_cast<::streamfx::gfx::blur::base_resolution>(blur); obj) {
+			obj->set_resolution(resolution);
+		}
+		return [blur, input]() {
+			auto gctx = streamfx::obs::gs::context();
+			blur->render();
+		};
+	}
+} // namespace
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		for (auto size : benchmark_sizes) {
+			std::string name = std::to_string(static_cast<int32_t>(size));
+
+			streamfx::util::benchmark::add("blur.automatic.error." + name, 1, [size]() -> streamfx::util::benchmark::function_t { return [size]() { measure_error(size); }; });
+
+			// The same blur with each approach on its own, as long as it supports the size.
+			streamfx::util::benchmark::add("blur.automatic." + name + ".1920x1080", 100, [size]() { return setup_render(std::make_shared<::streamfx::gfx::blur::automatic>(), size); });
+			streamfx::util::benchmark::add("blur.automatic." + name + ".1920x1080.bottom_third", 100, [size]() { return setup_render(std::make_shared<::streamfx::gfx::blur::automatic>(), size, ::streamfx::gfx::blur::region{0, 720, 1920, 360}); });
+			if (size <= ::streamfx::gfx::blur::gaussian_factory::get().get_max_size(::streamfx::gfx::blur::type::Area)) {
+				streamfx::util::benchmark::add("blur.gaussian." + name + ".1920x1080", 100, [size]() { return setup_render(::streamfx::gfx::blur::gaussian_factory::get().create(::streamfx::gfx::blur::type::Area), size); });
+				streamfx::util::benchmark::add("blur.gaussian." + name + ".1920x1080.full", 100, [size]() { return setup_render(::streamfx::gfx::blur::gaussian_factory::get().create(::streamfx::gfx::blur::type::Area), size, {}, ::streamfx::gfx::blur::resolution::Full); });
+			}
+			if (size <= ::streamfx::gfx::blur::box_factory::get().get_max_size(::streamfx::gfx::blur::type::Area)) {
+				streamfx::util::benchmark::add("blur.box." + name + ".1920x1080", 100, [size]() { return setup_render(::streamfx::gfx::blur::box_factory::get().create(::streamfx::gfx::blur::type::Area), size); });
+				streamfx::util::benchmark::add("blur.box." + name + ".1920x1080.full", 100, [size]() { return setup_render(::streamfx::gfx::blur::box_factory::get().create(::streamfx::gfx::blur::type::Area), size, {}, ::streamfx::gfx::blur::resolution::Full); });
+			}
+			if (size <= ::streamfx::gfx::blur::gaussian_linear_data::get_deviation(::streamfx::gfx::blur::gaussian_linear_factory::get().get_max_size(::streamfx::gfx::blur::type::Area))) {
+				streamfx::util::benchmark::add("blur.gaussian_linear." + name + ".1920x1080", 100, [size]() { return setup_render(::streamfx::gfx::blur::gaussian_linear_factory::get().create(::streamfx::gfx::blur::type::Area), ::streamfx::gfx::blur::gaussian_linear_data::find_width(size)); });
+			}
+		}
+	},
+	[]() { // Finalizer
+	},
+	streamfx::loader_priority::NORMAL);
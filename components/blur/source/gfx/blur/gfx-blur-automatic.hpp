@@ -0,0 +1,124 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+#include "gfx-blur-base.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
+#include "obs/gs/gs-texture.hpp"
+
+#include "warning-disable.hpp"
+#include <memory>
+#include "warning-enable.hpp"
+
+namespace streamfx::gfx {
+	namespace blur {
+		class automatic_factory : public ::streamfx::gfx::blur::ifactory {
+			public:
+			automatic_factory();
+			virtual ~automatic_factory() override;
+
+			virtual bool is_type_supported(::streamfx::gfx::blur::type type) override;
+
+			virtual std::shared_ptr<::streamfx::gfx::blur::base> create(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_min_size(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_step_size(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_max_size(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_min_angle(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_step_angle(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_max_angle(::streamfx::gfx::blur::type type) override;
+
+			virtual bool is_step_scale_supported(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_min_step_scale_x(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_step_step_scale_x(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_max_step_scale_x(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_min_step_scale_y(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_step_step_scale_y(::streamfx::gfx::blur::type type) override;
+
+			virtual double_t get_max_step_scale_y(::streamfx::gfx::blur::type type) override;
+
+			public: // Singleton
+			static ::streamfx::gfx::blur::automatic_factory& get();
+		};
+
+		/** Gaussian blur which picks the cheapest implementation that stays close to a true Gaussian blur.
+		 *
+		 * The size is the standard deviation of the Gaussian function in pixels. All sizes use the linear Gaussian
+		 * blur: small sizes with samples closer together than a texel, medium sizes with one sample for every two
+		 * texels, and large sizes on a downsampled copy of the input which is then scaled back up.
+		 */
+		class automatic : public ::streamfx::gfx::blur::base, public ::streamfx::gfx::blur::base_region {
+			public:
+			enum class strategy {
+				Subtexel,
+				Linear,
+				Pyramid,
+			};
+
+			struct plan {
+				strategy    type;
+				std::size_t levels;     // Number of times the input is halved in size before blurring.
+				double_t    inner_size; // Size of the blur applied at the lowest level.
+				double_t    step;       // Distance between the samples of that blur, in texels.
+			};
+
+			private:
+			double_t    _size;
+			strategy    _strategy;
+			std::size_t _levels;     // Number of times the input is halved in size before blurring.
+			double_t    _inner_size; // Size of the blur applied at the lowest level.
+
+			std::shared_ptr<::streamfx::gfx::blur::base> _linear;
+
+			std::shared_ptr<::streamfx::obs::gs::texture>           _input_texture;
+			std::weak_ptr<::streamfx::obs::gs::texture>             _output_texture; // Borrowed until the caller releases it.
+			std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> _pool;
+			::streamfx::gfx::blur::region                            _region;
+
+			public:
+			automatic();
+			virtual ~automatic() override;
+
+			virtual void set_input(std::shared_ptr<::streamfx::obs::gs::texture> texture) override;
+
+			virtual ::streamfx::gfx::blur::type get_type() override;
+
+			virtual double_t get_size() override;
+
+			virtual void set_size(double_t width) override;
+
+			virtual void set_step_scale(double_t x, double_t y) override;
+
+			virtual void get_step_scale(double_t& x, double_t& y) override;
+
+			virtual std::shared_ptr<::streamfx::obs::gs::texture> render() override;
+
+			virtual std::shared_ptr<::streamfx::obs::gs::texture> get() override;
+
+			virtual void set_region(::streamfx::gfx::blur::region area) override;
+
+			virtual ::streamfx::gfx::blur::region get_region() override;
+
+			strategy get_strategy();
+
+			/** How a blur of the given size is rendered, which can be decided without a graphics device.
+			 */
+			static plan get_plan(double_t size);
+
+			private:
+			std::shared_ptr<::streamfx::obs::gs::texture> render_pyramid();
+		};
+	} // namespace blur
+} // namespace streamfx::gfx
@@ -5,9 +5,39 @@
 #include "gfx-blur-base.hpp"
 
 #include "warning-disable.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include "warning-enable.hpp"
 
+bool streamfx::gfx::blur::region::empty() const
+{
+	return (width == 0) || (height == 0);
+}
+
+streamfx::gfx::blur::region streamfx::gfx::blur::region::dilate(uint32_t dx, uint32_t dy, uint32_t max_width, uint32_t max_height) const
+{
+	if (empty()) {
+		return *this;
+	}
+
+	uint32_t left   = (x > dx) ? (x - dx) : 0;
+	uint32_t top    = (y > dy) ? (y - dy) : 0;
+	uint32_t right  = static_cast<uint32_t>(std::min<uint64_t>(uint64_t(x) + width + dx, max_width));
+	uint32_t bottom = static_cast<uint32_t>(std::min<uint64_t>(uint64_t(y) + height + dy, max_height));
+	return region{left, top, (right > left) ? (right - left) : 0, (bottom > top) ? (bottom - top) : 0};
+}
+
+void streamfx::gfx::blur::region::apply(uint32_t target_width, uint32_t target_height) const
+{
+	if (empty() || (target_width == 0) || (target_height == 0)) {
+		gs_ortho(0, 1., 0, 1., 0, 1.);
+		return;
+	}
+
+	gs_set_viewport(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height));
+	gs_ortho(static_cast<float>(x) / static_cast<float>(target_width), static_cast<float>(x + width) / static_cast<float>(target_width), static_cast<float>(y) / static_cast<float>(target_height), static_cast<float>(y + height) / static_cast<float>(target_height), 0, 1.);
+}
+
 void streamfx::gfx::blur::base::set_step_scale_x(double_t v)
 {
 	this->set_step_scale(v, this->get_step_scale_y());
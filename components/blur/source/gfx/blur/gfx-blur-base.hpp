@@ -16,6 +16,37 @@ namespace streamfx::gfx {
 			Zoom,
 		};
 
+		/** Resolution at which a blur is rendered, relative to its input.
+		 */
+		enum class resolution : int64_t {
+			Automatic = -1, // Picked by the blur, depending on its size.
+			Full      = 0,
+			Half      = 1,
+			Quarter   = 2,
+		};
+
+		/** Rectangle in texels. A rectangle without any area stands for the entire texture.
+		 */
+		struct region {
+			uint32_t x;
+			uint32_t y;
+			uint32_t width;
+			uint32_t height;
+
+			bool empty() const;
+
+			/** Grow by the given number of texels on each side, without growing past a texture of the given size.
+			 */
+			region dilate(uint32_t dx, uint32_t dy, uint32_t max_width, uint32_t max_height) const;
+
+			/** Limit drawing to this area of the current render target, which has the given size.
+			 *
+			 * Sets up the viewport, and a projection which maps texture coordinates from 0 to 1 onto the entire
+			 * render target, as used by draw_fullscreen_triangle().
+			 */
+			void apply(uint32_t target_width, uint32_t target_height) const;
+		};
+
 		class base {
 			public:
 			virtual ~base() {}
@@ -71,6 +102,33 @@ namespace streamfx::gfx {
 			virtual double_t get_center_y();
 		};
 
+		class base_region {
+			public:
+			virtual ~base_region() {}
+
+			/** Only render the given area of the output, in texels of the input.
+			 *
+			 * The content of the output outside of the area is undefined.
+			 */
+			virtual void set_region(::streamfx::gfx::blur::region area) = 0;
+
+			virtual ::streamfx::gfx::blur::region get_region() = 0;
+		};
+
+		class base_resolution {
+			public:
+			virtual ~base_resolution() {}
+
+			/** Render the blur at a lower resolution and scale the result back up.
+			 *
+			 * Large blurs leave almost no detail that a lower resolution could lose, but cost a lot less to render
+			 * at one.
+			 */
+			virtual void set_resolution(::streamfx::gfx::blur::resolution value) = 0;
+
+			virtual ::streamfx::gfx::blur::resolution get_resolution() = 0;
+		};
+
 		class ifactory {
 			public:
 			virtual ~ifactory() {}
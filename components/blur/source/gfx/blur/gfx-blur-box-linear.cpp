@@ -173,11 +173,7 @@ std::shared_ptr<::streamfx::gfx::blur::box_linear_data> streamfx::gfx::blur::box
 	return instance;
 }
 
-streamfx::gfx::blur::box_linear::box_linear() : _data(::streamfx::gfx::blur::box_linear_factory::get().data()), _size(1.), _step_scale({1., 1.})
-{
-	_rendertarget  = std::make_shared<::streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-	_rendertarget2 = std::make_shared<::streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-}
+streamfx::gfx::blur::box_linear::box_linear() : _data(::streamfx::gfx::blur::box_linear_factory::get().data()), _size(1.), _step_scale({1., 1.}), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _region() {}
 
 streamfx::gfx::blur::box_linear::~box_linear() {}
 
@@ -253,7 +249,8 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_linear::r
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
 	// Two Pass Blur
-	streamfx::obs::gs::effect effect = _data->get_effect();
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	streamfx::obs::gs::effect                        effect = _data->get_effect();
 	if (effect) {
 		// Pass 1
 		effect.get_parameter("pImage").set_texture(_input_texture);
@@ -262,29 +259,33 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_linear::r
 		effect.get_parameter("pSize").set_float(float(_size));
 		effect.get_parameter("pSizeInverseMul").set_float(float(1.0f / (float(_size) * 2.0f + 1.0f)));
 
+		auto rt2 = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Horizontal");
 #endif
 
-			auto op = _rendertarget2->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt2->render(uint32_t(width), uint32_t(height));
+			// The second pass reads above and below every texel it renders, so those have to be rendered here too.
+			uint32_t radius = static_cast<uint32_t>(std::ceil((_size + 1.) * _step_scale.second)) + 1;
+			_region.dilate(0, radius, uint32_t(width), uint32_t(height)).apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Draw")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
 
 		// Pass 2
-		effect.get_parameter("pImage").set_texture(_rendertarget2->get_texture());
+		effect.get_parameter("pImage").set_texture(rt2->get_texture());
 		effect.get_parameter("pImageTexel").set_float2(0., float(1.f / height));
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Vertical");
 #endif
 
-			auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			_region.apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Draw")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
@@ -293,12 +294,27 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_linear::r
 
 	gs_blend_state_pop();
 
-	return _rendertarget->get_texture();
+	if (!rt) {
+		return _input_texture;
+	}
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
 
 std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_linear::get()
 {
-	return _rendertarget->get_texture();
+	return _output_texture.lock();
+}
+
+void streamfx::gfx::blur::box_linear::set_region(::streamfx::gfx::blur::region area)
+{
+	_region = area;
+}
+
+::streamfx::gfx::blur::region streamfx::gfx::blur::box_linear::get_region()
+{
+	return _region;
 }
 
 streamfx::gfx::blur::box_linear_directional::box_linear_directional() : _angle(0) {}
@@ -343,7 +359,8 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_linear_di
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
 	// One Pass Blur
-	streamfx::obs::gs::effect effect = _data->get_effect();
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	streamfx::obs::gs::effect                        effect = _data->get_effect();
 	if (effect) {
 		effect.get_parameter("pImage").set_texture(_input_texture);
 		effect.get_parameter("pImageTexel").set_float2(float(1. / width * cos(_angle)), float(1.f / height * sin(_angle)));
@@ -351,9 +368,10 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_linear_di
 		effect.get_parameter("pSize").set_float(float(_size));
 		effect.get_parameter("pSizeInverseMul").set_float(float(1.0f / (float(_size) * 2.0f + 1.0f)));
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
-			auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			_region.apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Draw")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
@@ -362,5 +380,10 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_linear_di
 
 	gs_blend_state_pop();
 
-	return _rendertarget->get_texture();
+	if (!rt) {
+		return _input_texture;
+	}
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
@@ -7,7 +7,7 @@
 #include "gfx-blur-base.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 
 #include "warning-disable.hpp"
@@ -73,17 +73,16 @@ namespace streamfx::gfx {
 			static ::streamfx::gfx::blur::box_linear_factory& get();
 		};
 
-		class box_linear : public ::streamfx::gfx::blur::base {
+		class box_linear : public ::streamfx::gfx::blur::base, public ::streamfx::gfx::blur::base_region {
 			protected:
 			std::shared_ptr<::streamfx::gfx::blur::box_linear_data> _data;
 
-			double_t                                           _size;
-			std::pair<double_t, double_t>                      _step_scale;
-			std::shared_ptr<::streamfx::obs::gs::texture>      _input_texture;
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget;
-
-			private:
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget2;
+			double_t                                                _size;
+			std::pair<double_t, double_t>                           _step_scale;
+			std::shared_ptr<::streamfx::obs::gs::texture>           _input_texture;
+			std::weak_ptr<::streamfx::obs::gs::texture>             _output_texture; // Borrowed until the caller releases it.
+			std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> _pool;
+			::streamfx::gfx::blur::region                            _region;
 
 			public:
 			box_linear();
@@ -103,6 +102,10 @@ namespace streamfx::gfx {
 
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> render() override;
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> get() override;
+
+			virtual void set_region(::streamfx::gfx::blur::region area) override;
+
+			virtual ::streamfx::gfx::blur::region get_region() override;
 		};
 
 		class box_linear_directional : public ::streamfx::gfx::blur::box_linear, public ::streamfx::gfx::blur::base_angle {
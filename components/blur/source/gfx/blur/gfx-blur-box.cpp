@@ -5,10 +5,12 @@
 
 #include "gfx-blur-box.hpp"
 #include "common.hpp"
+#include "gfx-blur-scale.hpp"
 #include "obs/gs/gs-helper.hpp"
 #include "plugin.hpp"
 
 #include "warning-disable.hpp"
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <stdexcept>
@@ -16,13 +18,19 @@
 
 #define ST_MAX_BLUR_SIZE 128 // Also change this in box.effect if modified.
 
-streamfx::gfx::blur::box_data::box_data() : _gfx_util(::streamfx::gfx::util::get())
+// Sizes from which the Area blur renders at half and quarter resolution on its own. Compared to a blur of a hard edge
+// at full resolution, the result differs by at most 4 levels at these sizes, and less for any larger size.
+#define ST_HALF_THRESHOLD 16.
+#define ST_QUARTER_THRESHOLD 48.
+
+streamfx::gfx::blur::box_data::box_data() : _paired(false), _gfx_util(::streamfx::gfx::util::get())
 {
 	auto gctx = streamfx::obs::gs::context();
 	{
 		auto file = streamfx::data_file_path("effects/blur/box.effect");
 		try {
 			_effect = streamfx::obs::gs::effect::create(file);
+			_paired = _effect.has_technique("DrawPaired");
 		} catch (const std::exception& ex) {
 			DLOG_ERROR("Error loading '%s': %s", file.generic_u8string().c_str(), ex.what());
 		}
@@ -45,6 +53,11 @@ streamfx::obs::gs::effect streamfx::gfx::blur::box_data::get_effect()
 	return _effect;
 }
 
+bool streamfx::gfx::blur::box_data::has_paired()
+{
+	return _paired;
+}
+
 streamfx::gfx::blur::box_factory::box_factory() {}
 
 streamfx::gfx::blur::box_factory::~box_factory() {}
@@ -182,12 +195,7 @@ std::shared_ptr<::streamfx::gfx::blur::box_data> streamfx::gfx::blur::box_factor
 	return instance;
 }
 
-streamfx::gfx::blur::box::box() : _data(::streamfx::gfx::blur::box_factory::get().data()), _size(1.), _step_scale({1., 1.})
-{
-	auto gctx      = streamfx::obs::gs::context();
-	_rendertarget  = std::make_shared<::streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-	_rendertarget2 = std::make_shared<::streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-}
+streamfx::gfx::blur::box::box() : _data(::streamfx::gfx::blur::box_factory::get().data()), _size(1.), _step_scale({1., 1.}), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _region(), _resolution(::streamfx::gfx::blur::resolution::Automatic) {}
 
 streamfx::gfx::blur::box::~box() {}
 
@@ -246,8 +254,34 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box::render()
 	auto gdmp = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Box Blur");
 #endif
 
-	float width  = float(_input_texture->get_width());
-	float height = float(_input_texture->get_height());
+	if (!_data->get_effect()) {
+		return _input_texture;
+	}
+
+	std::shared_ptr<::streamfx::obs::gs::texture> output;
+	if (std::size_t levels = get_levels(); levels > 0) {
+		// Downsampling already blurs a little, so only the variance still missing afterwards is left for the box. A
+		// box of radius r has a variance of ((2r + 1)² - 1) / 12, which is solved for r at the lower resolution.
+		double_t scale    = double_t(uint64_t(1) << levels);
+		double_t variance = (std::pow(_size * 2. + 1., 2.) - 1.) / 12.;
+		variance          = std::max(variance - ::streamfx::gfx::blur::get_downsample_variance(levels), 0.) / (scale * scale);
+		double_t size     = std::round((std::sqrt(variance * 12. + 1.) - 1.) / 2.);
+
+		auto level = ::streamfx::gfx::blur::downsample(_pool, _input_texture, levels);
+		level      = render_area(level, std::max(size, 1.), ::streamfx::gfx::blur::downsample_region(_region, levels, level->get_width(), level->get_height()));
+		output     = ::streamfx::gfx::blur::upsample(_pool, level, _input_texture->get_width(), _input_texture->get_height(), _region);
+	} else {
+		output = render_area(_input_texture, _size, _region);
+	}
+
+	_output_texture = output;
+	return output;
+}
+
+std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box::render_area(std::shared_ptr<::streamfx::obs::gs::texture> input, double_t size, ::streamfx::gfx::blur::region area)
+{
+	float width  = float(input->get_width());
+	float height = float(input->get_height());
 
 	gs_set_cull_mode(GS_NEITHER);
 	gs_enable_color(true, true, true, true);
@@ -262,40 +296,48 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box::render()
 	gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
+	// Reading texels in pairs is only exact while every step is exactly one texel.
+	const char* technique = ((_step_scale.first == 1.) && (_step_scale.second == 1.) && _data->has_paired()) ? "DrawPaired" : "Draw";
+
 	// Two Pass Blur
-	streamfx::obs::gs::effect effect = _data->get_effect();
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	streamfx::obs::gs::effect                        effect = _data->get_effect();
 	if (effect) {
 		// Pass 1
-		effect.get_parameter("pImage").set_texture(_input_texture);
+		effect.get_parameter("pImage").set_texture(input);
 		effect.get_parameter("pImageTexel").set_float2(float(1.f / width), 0.f);
 		effect.get_parameter("pStepScale").set_float2(float(_step_scale.first), float(_step_scale.second));
-		effect.get_parameter("pSize").set_float(float(_size));
-		effect.get_parameter("pSizeInverseMul").set_float(float(1.0f / (float(_size) * 2.0f + 1.0f)));
+		effect.get_parameter("pSize").set_float(float(size));
+		effect.get_parameter("pSizeInverseMul").set_float(float(1.0f / (float(size) * 2.0f + 1.0f)));
 
+		auto rt2 = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Horizontal");
 #endif
 
-			auto op = _rendertarget2->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
-			while (gs_effect_loop(effect.get_object(), "Draw")) {
+			auto op = rt2->render(uint32_t(width), uint32_t(height));
+			// The second pass reads above and below every texel it renders, so those have to be rendered here too.
+			uint32_t radius = static_cast<uint32_t>(std::ceil((size + 1.) * _step_scale.second)) + 1;
+			area.dilate(0, radius, uint32_t(width), uint32_t(height)).apply(uint32_t(width), uint32_t(height));
+			while (gs_effect_loop(effect.get_object(), technique)) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
 
 		// Pass 2
-		effect.get_parameter("pImage").set_texture(_rendertarget2->get_texture());
+		effect.get_parameter("pImage").set_texture(rt2->get_texture());
 		effect.get_parameter("pImageTexel").set_float2(0.f, float(1.f / height));
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Vertical");
 #endif
 
-			auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
-			while (gs_effect_loop(effect.get_object(), "Draw")) {
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			area.apply(uint32_t(width), uint32_t(height));
+			while (gs_effect_loop(effect.get_object(), technique)) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
@@ -303,12 +345,52 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box::render()
 
 	gs_blend_state_pop();
 
-	return _rendertarget->get_texture();
+	if (!rt) {
+		return input;
+	}
+	return streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 }
 
 std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box::get()
 {
-	return _rendertarget->get_texture();
+	return _output_texture.lock();
+}
+
+void streamfx::gfx::blur::box::set_region(::streamfx::gfx::blur::region area)
+{
+	_region = area;
+}
+
+::streamfx::gfx::blur::region streamfx::gfx::blur::box::get_region()
+{
+	return _region;
+}
+
+void streamfx::gfx::blur::box::set_resolution(::streamfx::gfx::blur::resolution value)
+{
+	_resolution = value;
+}
+
+::streamfx::gfx::blur::resolution streamfx::gfx::blur::box::get_resolution()
+{
+	return _resolution;
+}
+
+std::size_t streamfx::gfx::blur::box::get_levels()
+{
+	if (_resolution != ::streamfx::gfx::blur::resolution::Automatic) {
+		return static_cast<std::size_t>(_resolution);
+	}
+
+	// A different step scale changes how far the box reaches, which the thresholds do not account for.
+	if ((_step_scale.first != 1.) || (_step_scale.second != 1.)) {
+		return 0;
+	} else if (_size >= ST_QUARTER_THRESHOLD) {
+		return 2;
+	} else if (_size >= ST_HALF_THRESHOLD) {
+		return 1;
+	}
+	return 0;
 }
 
 streamfx::gfx::blur::box_directional::box_directional() : _angle(0) {}
@@ -353,7 +435,8 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_direction
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
 	// One Pass Blur
-	streamfx::obs::gs::effect effect = _data->get_effect();
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	streamfx::obs::gs::effect                        effect = _data->get_effect();
 	if (effect) {
 		effect.get_parameter("pImage").set_texture(_input_texture);
 		effect.get_parameter("pImageTexel").set_float2(float(1. / width * cos(_angle)), float(1.f / height * sin(_angle)));
@@ -361,9 +444,10 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_direction
 		effect.get_parameter("pSize").set_float(float(_size));
 		effect.get_parameter("pSizeInverseMul").set_float(float(1.0f / (float(_size) * 2.0f + 1.0f)));
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
-			auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			_region.apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Draw")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
@@ -372,7 +456,12 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_direction
 
 	gs_blend_state_pop();
 
-	return _rendertarget->get_texture();
+	if (!rt) {
+		return _input_texture;
+	}
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
 
 ::streamfx::gfx::blur::type streamfx::gfx::blur::box_rotational::get_type()
@@ -427,7 +516,8 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_rotationa
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
 	// One Pass Blur
-	streamfx::obs::gs::effect effect = _data->get_effect();
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	streamfx::obs::gs::effect                        effect = _data->get_effect();
 	if (effect) {
 		effect.get_parameter("pImage").set_texture(_input_texture);
 		effect.get_parameter("pImageTexel").set_float2(float(1.f / width), float(1.f / height));
@@ -437,9 +527,10 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_rotationa
 		effect.get_parameter("pAngle").set_float(float(_angle / _size));
 		effect.get_parameter("pCenter").set_float2(float(_center.first), float(_center.second));
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
-			auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			_region.apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Rotate")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
@@ -448,7 +539,12 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_rotationa
 
 	gs_blend_state_pop();
 
-	return _rendertarget->get_texture();
+	if (!rt) {
+		return _input_texture;
+	}
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
 
 ::streamfx::gfx::blur::type streamfx::gfx::blur::box_zoom::get_type()
@@ -493,7 +589,8 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_zoom::ren
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
 	// One Pass Blur
-	streamfx::obs::gs::effect effect = _data->get_effect();
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	streamfx::obs::gs::effect                        effect = _data->get_effect();
 	if (effect) {
 		effect.get_parameter("pImage").set_texture(_input_texture);
 		effect.get_parameter("pImageTexel").set_float2(float(1.f / width), float(1.f / height));
@@ -502,9 +599,10 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_zoom::ren
 		effect.get_parameter("pSizeInverseMul").set_float(float(1.0f / (float(_size) * 2.0f + 1.0f)));
 		effect.get_parameter("pCenter").set_float2(float(_center.first), float(_center.second));
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
-			auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			_region.apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Zoom")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
@@ -513,5 +611,10 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::box_zoom::ren
 
 	gs_blend_state_pop();
 
-	return _rendertarget->get_texture();
+	if (!rt) {
+		return _input_texture;
+	}
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
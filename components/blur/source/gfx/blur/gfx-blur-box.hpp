@@ -7,7 +7,7 @@
 #include "gfx-blur-base.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 
 #include "warning-disable.hpp"
@@ -18,6 +18,7 @@ namespace streamfx::gfx {
 	namespace blur {
 		class box_data {
 			streamfx::obs::gs::effect            _effect;
+			bool                                 _paired;
 			std::shared_ptr<streamfx::gfx::util> _gfx_util;
 
 			public:
@@ -27,6 +28,10 @@ namespace streamfx::gfx {
 			std::shared_ptr<streamfx::gfx::util> get_gfx_util();
 
 			streamfx::obs::gs::effect get_effect();
+
+			/** Whether the effect can read the texels of an Area blur in pairs, which needs half as many samples.
+			 */
+			bool has_paired();
 		};
 
 		class box_factory : public ::streamfx::gfx::blur::ifactory {
@@ -73,17 +78,17 @@ namespace streamfx::gfx {
 			static ::streamfx::gfx::blur::box_factory& get();
 		};
 
-		class box : public ::streamfx::gfx::blur::base {
+		class box : public ::streamfx::gfx::blur::base, public ::streamfx::gfx::blur::base_region, public ::streamfx::gfx::blur::base_resolution {
 			protected:
 			std::shared_ptr<::streamfx::gfx::blur::box_data> _data;
 
-			double_t                                           _size;
-			std::pair<double_t, double_t>                      _step_scale;
-			std::shared_ptr<::streamfx::obs::gs::texture>      _input_texture;
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget;
-
-			private:
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget2;
+			double_t                                                _size;
+			std::pair<double_t, double_t>                           _step_scale;
+			std::shared_ptr<::streamfx::obs::gs::texture>           _input_texture;
+			std::weak_ptr<::streamfx::obs::gs::texture>             _output_texture; // Borrowed until the caller releases it.
+			std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> _pool;
+			::streamfx::gfx::blur::region                            _region;
+			::streamfx::gfx::blur::resolution                        _resolution;
 
 			public:
 			box();
@@ -103,6 +108,19 @@ namespace streamfx::gfx {
 
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> render() override;
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> get() override;
+
+			virtual void set_region(::streamfx::gfx::blur::region area) override;
+
+			virtual ::streamfx::gfx::blur::region get_region() override;
+
+			virtual void set_resolution(::streamfx::gfx::blur::resolution value) override;
+
+			virtual ::streamfx::gfx::blur::resolution get_resolution() override;
+
+			protected:
+			std::size_t get_levels();
+
+			std::shared_ptr<::streamfx::obs::gs::texture> render_area(std::shared_ptr<::streamfx::obs::gs::texture> input, double_t size, ::streamfx::gfx::blur::region area);
 		};
 
 		class box_directional : public ::streamfx::gfx::blur::box, public ::streamfx::gfx::blur::base_angle {
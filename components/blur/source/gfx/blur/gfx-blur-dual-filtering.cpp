@@ -10,6 +10,7 @@
 
 #include "warning-disable.hpp"
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 #include "warning-enable.hpp"
 
@@ -168,20 +169,7 @@ std::shared_ptr<::streamfx::gfx::blur::dual_filtering_data> streamfx::gfx::blur:
 	return instance;
 }
 
-streamfx::gfx::blur::dual_filtering::dual_filtering() : _data(::streamfx::gfx::blur::dual_filtering_factory::get().data()), _size(0), _iterations(0)
-{
-	auto gctx = streamfx::obs::gs::context();
-	_rts.resize(ST_MAX_LEVELS + 1);
-	for (std::size_t n = 0; n <= ST_MAX_LEVELS; n++) {
-		gs_color_format cf = GS_RGBA;
-#if 0
-		cf = GS_RGBA16F;
-#elif 0
-		cf = GS_RGBA32F;
-#endif
-		_rts[n] = std::make_shared<streamfx::obs::gs::rendertarget>(cf, GS_ZS_NONE);
-	}
-}
+streamfx::gfx::blur::dual_filtering::dual_filtering() : _data(::streamfx::gfx::blur::dual_filtering_factory::get().data()), _size(0), _iterations(0), _p_image("pImage"), _p_image_size("pImageSize"), _p_image_texel("pImageTexel"), _pool(streamfx::obs::gs::rendertarget_pool::instance()) {}
 
 streamfx::gfx::blur::dual_filtering::~dual_filtering() {}
 
@@ -240,6 +228,16 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::dual_filterin
 	uint32_t height     = _input_texture->get_height();
 	size_t   iterations = _iterations;
 
+	gs_color_format cf = GS_RGBA;
+#if 0
+	cf = GS_RGBA16F;
+#elif 0
+	cf = GS_RGBA32F;
+#endif
+
+	// Each level is only borrowed until the next larger one has been reconstructed from it.
+	std::array<std::shared_ptr<streamfx::obs::gs::rendertarget>, ST_MAX_LEVELS + 1> rts;
+
 	// Downsample
 	for (std::size_t n = 1; n <= iterations; n++) {
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
@@ -249,7 +247,7 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::dual_filterin
 		// Select Texture
 		std::shared_ptr<streamfx::obs::gs::texture> tex;
 		if (n > 1) {
-			tex = _rts[n - 1]->get_texture();
+			tex = rts[n - 1]->get_texture();
 		} else { // Idx 0 is a simply considered as a straight copy of the original and not rendered to.
 			tex = _input_texture;
 		}
@@ -263,12 +261,13 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::dual_filterin
 		}
 
 		// Apply
-		effect.get_parameter("pImage").set_texture(tex);
-		effect.get_parameter("pImageSize").set_float2(static_cast<float>(owidth), static_cast<float>(oheight));
-		effect.get_parameter("pImageTexel").set_float2(0.5f / static_cast<float>(owidth), 0.5f / static_cast<float>(oheight));
+		_p_image(effect).set_texture(tex);
+		_p_image_size(effect).set_float2(static_cast<float>(owidth), static_cast<float>(oheight));
+		_p_image_texel(effect).set_float2(0.5f / static_cast<float>(owidth), 0.5f / static_cast<float>(oheight));
 
+		rts[n] = _pool->acquire(owidth, oheight, cf);
 		{
-			auto op = _rts[n]->render(owidth, oheight);
+			auto op = rts[n]->render(owidth, oheight);
 			gs_ortho(0., 1., 0., 1., 0., 1.);
 			while (gs_effect_loop(effect.get_object(), "Down")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
@@ -283,7 +282,7 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::dual_filterin
 #endif
 
 		// Select Texture
-		std::shared_ptr<streamfx::obs::gs::texture> tex = _rts[n]->get_texture();
+		std::shared_ptr<streamfx::obs::gs::texture> tex = rts[n]->get_texture();
 
 		// Get Size
 		uint32_t iwidth  = tex->get_width();
@@ -292,25 +291,34 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::dual_filterin
 		uint32_t oheight = height >> (n - 1);
 
 		// Apply
-		effect.get_parameter("pImage").set_texture(tex);
-		effect.get_parameter("pImageSize").set_float2(static_cast<float>(iwidth), static_cast<float>(iheight));
-		effect.get_parameter("pImageTexel").set_float2(0.5f / static_cast<float>(iwidth), 0.5f / static_cast<float>(iheight));
+		_p_image(effect).set_texture(tex);
+		_p_image_size(effect).set_float2(static_cast<float>(iwidth), static_cast<float>(iheight));
+		_p_image_texel(effect).set_float2(0.5f / static_cast<float>(iwidth), 0.5f / static_cast<float>(iheight));
 
+		if (!rts[n - 1]) {
+			rts[n - 1] = _pool->acquire(owidth, oheight, cf);
+		}
 		{
-			auto op = _rts[n - 1]->render(owidth, oheight);
+			auto op = rts[n - 1]->render(owidth, oheight);
 			gs_ortho(0., 1., 0., 1., 0., 1.);
 			while (gs_effect_loop(effect.get_object(), "Up")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
+		rts[n].reset();
 	}
 
 	gs_blend_state_pop();
 
-	return _rts[0]->get_texture();
+	if (!rts[0]) {
+		return _input_texture;
+	}
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rts[0]);
+	_output_texture = output;
+	return output;
 }
 
 std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::dual_filtering::get()
 {
-	return _rts[0]->get_texture();
+	return _output_texture.lock();
 }
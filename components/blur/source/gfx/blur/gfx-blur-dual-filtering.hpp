@@ -7,7 +7,7 @@
 #include "gfx-blur-base.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 
 #include "warning-disable.hpp"
@@ -81,8 +81,13 @@ namespace streamfx::gfx {
 			std::size_t _iterations;
 
 			std::shared_ptr<streamfx::obs::gs::texture> _input_texture;
+			std::weak_ptr<streamfx::obs::gs::texture>   _output_texture; // Borrowed until the caller releases it.
 
-			std::vector<std::shared_ptr<streamfx::obs::gs::rendertarget>> _rts;
+			std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+
+			streamfx::obs::gs::effect_parameter_handle _p_image;
+			streamfx::obs::gs::effect_parameter_handle _p_image_size;
+			streamfx::obs::gs::effect_parameter_handle _p_image_texel;
 
 			public:
 			dual_filtering();
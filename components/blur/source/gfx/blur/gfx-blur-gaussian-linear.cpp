@@ -8,21 +8,14 @@
 #include "obs/gs/gs-helper.hpp"
 
 #include "warning-disable.hpp"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include "warning-enable.hpp"
 
-// FIXME: This breaks when MAX_KERNEL_SIZE is changed, due to the way the Gaussian
-//  function first goes up at the point, and then once we pass the critical point
-//  will go down again and it is not handled well. This is a pretty basic
-//  approximation anyway at the moment.
-#define ST_MAX_KERNEL_SIZE 128
-#define ST_MAX_BLUR_SIZE (ST_MAX_KERNEL_SIZE - 1)
-#define ST_SEARCH_DENSITY double_t(1. / 500.)
-#define ST_SEARCH_THRESHOLD double_t(1. / (ST_MAX_KERNEL_SIZE * 5))
-#define ST_SEARCH_EXTENSION 1
-#define ST_SEARCH_RANGE ST_MAX_KERNEL_SIZE * 2
+#define ST_MAX_BLUR_SIZE (::streamfx::gfx::blur::gaussian_linear_data::kernel_size - 1)
 
-streamfx::gfx::blur::gaussian_linear_data::gaussian_linear_data() : _gfx_util(::streamfx::gfx::util::get())
+streamfx::gfx::blur::gaussian_linear_data::gaussian_linear_data() : _gfx_util(::streamfx::gfx::util::get()), _kernels(::streamfx::gfx::blur::kernel_cache::instance())
 {
 	{
 		auto gctx = streamfx::obs::gs::context();
@@ -36,36 +29,6 @@ streamfx::gfx::blur::gaussian_linear_data::gaussian_linear_data() : _gfx_util(::
 			}
 		}
 	}
-
-	// Precalculate Kernels
-	for (std::size_t kernel_size = 1; kernel_size <= ST_MAX_BLUR_SIZE; kernel_size++) {
-		std::vector<double_t> kernel_math(ST_MAX_KERNEL_SIZE);
-		std::vector<float>  kernel_data(ST_MAX_KERNEL_SIZE);
-		double_t              actual_width = 1.;
-
-		// Find actual kernel width.
-		for (double_t h = ST_SEARCH_DENSITY; h < ST_SEARCH_RANGE; h += ST_SEARCH_DENSITY) {
-			if (streamfx::util::math::gaussian<double_t>(double_t(kernel_size + ST_SEARCH_EXTENSION), h) > ST_SEARCH_THRESHOLD) {
-				actual_width = h;
-				break;
-			}
-		}
-
-		// Calculate and normalize
-		double_t sum = 0;
-		for (std::size_t p = 0; p <= kernel_size; p++) {
-			kernel_math[p] = streamfx::util::math::gaussian<double_t>(double_t(p), actual_width);
-			sum += kernel_math[p] * (p > 0 ? 2 : 1);
-		}
-
-		// Normalize to fill the entire 0..1 range over the width.
-		double_t inverse_sum = 1.0 / sum;
-		for (std::size_t p = 0; p <= kernel_size; p++) {
-			kernel_data.at(p) = float(kernel_math[p] * inverse_sum);
-		}
-
-		_kernels.push_back(std::move(kernel_data));
-	}
 }
 
 streamfx::gfx::blur::gaussian_linear_data::~gaussian_linear_data()
@@ -78,14 +41,13 @@ streamfx::obs::gs::effect streamfx::gfx::blur::gaussian_linear_data::get_effect(
 	return _effect;
 }
 
-std::vector<float> const& streamfx::gfx::blur::gaussian_linear_data::get_kernel(std::size_t width)
+::streamfx::gfx::blur::kernel_span streamfx::gfx::blur::gaussian_linear_data::get_kernel(double_t width)
 {
 	if (width < 1)
 		width = 1;
 	if (width > ST_MAX_BLUR_SIZE)
 		width = ST_MAX_BLUR_SIZE;
-	width -= 1;
-	return _kernels[width];
+	return _kernels->get(::streamfx::gfx::blur::kernel_cache::type::GAUSSIAN_LINEAR, width, &::streamfx::gfx::blur::gaussian_linear_data::generate_kernel);
 }
 
 std::shared_ptr<streamfx::gfx::util> streamfx::gfx::blur::gaussian_linear_data::get_gfx_util()
@@ -221,13 +183,7 @@ std::shared_ptr<::streamfx::gfx::blur::gaussian_linear_data> streamfx::gfx::blur
 	return instance;
 }
 
-streamfx::gfx::blur::gaussian_linear::gaussian_linear() : _data(::streamfx::gfx::blur::gaussian_linear_factory::get().data()), _size(1.), _step_scale({1., 1.})
-{
-	auto gctx = streamfx::obs::gs::context();
-
-	_rendertarget  = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-	_rendertarget2 = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-}
+streamfx::gfx::blur::gaussian_linear::gaussian_linear() : _data(::streamfx::gfx::blur::gaussian_linear_factory::get().data()), _size(1.), _step_scale({1., 1.}), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _region(), _kernel(), _kernel_size(0.) {}
 
 streamfx::gfx::blur::gaussian_linear::~gaussian_linear() {}
 
@@ -286,7 +242,7 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_line
 #endif
 
 	streamfx::obs::gs::effect effect = _data->get_effect();
-	auto                      kernel = _data->get_kernel(size_t(_size));
+	auto const&               kernel = get_kernel();
 
 	if (!effect || ((_step_scale.first + _step_scale.second) < std::numeric_limits<double_t>::epsilon())) {
 		return _input_texture;
@@ -312,55 +268,84 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_line
 	effect.get_parameter("pImage").set_texture(_input_texture);
 	effect.get_parameter("pStepScale").set_float2(float(_step_scale.first), float(_step_scale.second));
 	effect.get_parameter("pSize").set_float(float(_size));
-	effect.get_parameter("pKernel").set_value(kernel.data(), ST_MAX_KERNEL_SIZE);
+	effect.get_parameter("pKernel").set_value(kernel.data(), kernel.size());
 
 	// First Pass
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
 	if (_step_scale.first > std::numeric_limits<double_t>::epsilon()) {
 		effect.get_parameter("pImageTexel").set_float2(float(1.f / width), 0.f);
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Horizontal");
 #endif
 
-			auto op = _rendertarget2->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			// The second pass reads above and below every texel it renders, so those have to be rendered here too.
+			uint32_t radius = static_cast<uint32_t>(std::ceil((_size + 1.) * _step_scale.second)) + 1;
+			_region.dilate(0, radius, uint32_t(width), uint32_t(height)).apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Draw")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
 
-		std::swap(_rendertarget, _rendertarget2);
-		effect.get_parameter("pImage").set_texture(_rendertarget->get_texture());
+		effect.get_parameter("pImage").set_texture(rt->get_texture());
 	}
 
 	// Second Pass
 	if (_step_scale.second > std::numeric_limits<double_t>::epsilon()) {
 		effect.get_parameter("pImageTexel").set_float2(0.f, float(1.f / height));
 
+		// The first pass stays borrowed until this one is done reading from it.
+		auto rt2 = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Vertical");
 #endif
 
-			auto op = _rendertarget2->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
+			auto op = rt2->render(uint32_t(width), uint32_t(height));
+			_region.apply(uint32_t(width), uint32_t(height));
 			while (gs_effect_loop(effect.get_object(), "Draw")) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
-
-		std::swap(_rendertarget, _rendertarget2);
+		rt = std::move(rt2);
 	}
 
 	gs_blend_state_pop();
 
-	return this->get();
+	if (!rt) {
+		return _input_texture;
+	}
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
 
 std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_linear::get()
 {
-	return _rendertarget->get_texture();
+	return _output_texture.lock();
+}
+
+void streamfx::gfx::blur::gaussian_linear::set_region(::streamfx::gfx::blur::region area)
+{
+	_region = area;
+}
+
+::streamfx::gfx::blur::region streamfx::gfx::blur::gaussian_linear::get_region()
+{
+	return _region;
+}
+
+::streamfx::gfx::blur::kernel_span const& streamfx::gfx::blur::gaussian_linear::get_kernel()
+{
+	// Only look the kernel up again when the size changed, so that binding it every frame costs nothing.
+	if (_kernel.empty() || (_kernel_size != _size)) {
+		_kernel      = _data->get_kernel(_size);
+		_kernel_size = _size;
+	}
+	return _kernel;
 }
 
 streamfx::gfx::blur::gaussian_linear_directional::gaussian_linear_directional() : _angle(0.) {}
@@ -391,7 +376,7 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_line
 #endif
 
 	streamfx::obs::gs::effect effect = _data->get_effect();
-	auto                      kernel = _data->get_kernel(size_t(_size));
+	auto const&               kernel = get_kernel();
 
 	if (!effect || ((_step_scale.first + _step_scale.second) < std::numeric_limits<double_t>::epsilon())) {
 		return _input_texture;
@@ -418,12 +403,13 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_line
 	effect.get_parameter("pImageTexel").set_float2(float(1.f / width * cos(_angle)), float(1.f / height * sin(_angle)));
 	effect.get_parameter("pStepScale").set_float2(float(_step_scale.first), float(_step_scale.second));
 	effect.get_parameter("pSize").set_float(float(_size));
-	effect.get_parameter("pKernel").set_value(kernel.data(), ST_MAX_KERNEL_SIZE);
+	effect.get_parameter("pKernel").set_value(kernel.data(), kernel.size());
 
 	// First Pass
+	auto rt = _pool->acquire(uint32_t(width), uint32_t(height));
 	{
-		auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-		gs_ortho(0, 1., 0, 1., 0, 1.);
+		auto op = rt->render(uint32_t(width), uint32_t(height));
+		_region.apply(uint32_t(width), uint32_t(height));
 		while (gs_effect_loop(effect.get_object(), "Draw")) {
 			_data->get_gfx_util()->draw_fullscreen_triangle();
 		}
@@ -431,5 +417,7 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_line
 
 	gs_blend_state_pop();
 
-	return this->get();
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
@@ -5,9 +5,10 @@
 #pragma once
 #include "common.hpp"
 #include "gfx-blur-base.hpp"
+#include "gfx-blur-kernel-cache.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 
 #include "warning-disable.hpp"
@@ -18,11 +19,13 @@
 namespace streamfx::gfx {
 	namespace blur {
 		class gaussian_linear_data {
-			streamfx::obs::gs::effect            _effect;
-			std::shared_ptr<streamfx::gfx::util> _gfx_util;
-			std::vector<std::vector<float>>    _kernels;
+			streamfx::obs::gs::effect                            _effect;
+			std::shared_ptr<streamfx::gfx::util>                 _gfx_util;
+			std::shared_ptr<::streamfx::gfx::blur::kernel_cache> _kernels;
 
 			public:
+			static constexpr std::size_t kernel_size = 128; // As many weights as the effect reads.
+
 			gaussian_linear_data();
 			virtual ~gaussian_linear_data();
 
@@ -30,7 +33,19 @@ namespace streamfx::gfx {
 
 			streamfx::obs::gs::effect get_effect();
 
-			std::vector<float> const& get_kernel(std::size_t width);
+			::streamfx::gfx::blur::kernel_span get_kernel(double_t width);
+
+			/** Standard deviation of the Gaussian function the kernel for the given width was generated from.
+			 */
+			static double_t get_deviation(double_t width);
+
+			/** Width of the kernel whose standard deviation is closest to the given one.
+			 */
+			static double_t find_width(double_t deviation);
+
+			/** Generate the kernel for an integer width, between which the kernel cache interpolates.
+			 */
+			static std::vector<float> generate_kernel(std::size_t width);
 		};
 
 		class gaussian_linear_factory : public ::streamfx::gfx::blur::ifactory {
@@ -77,17 +92,18 @@ namespace streamfx::gfx {
 			static ::streamfx::gfx::blur::gaussian_linear_factory& get();
 		};
 
-		class gaussian_linear : public ::streamfx::gfx::blur::base {
+		class gaussian_linear : public ::streamfx::gfx::blur::base, public ::streamfx::gfx::blur::base_region {
 			protected:
 			std::shared_ptr<::streamfx::gfx::blur::gaussian_linear_data> _data;
 
-			double_t                                           _size;
-			std::pair<double_t, double_t>                      _step_scale;
-			std::shared_ptr<::streamfx::obs::gs::texture>      _input_texture;
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget;
-
-			private:
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget2;
+			double_t                                                _size;
+			std::pair<double_t, double_t>                           _step_scale;
+			std::shared_ptr<::streamfx::obs::gs::texture>           _input_texture;
+			std::weak_ptr<::streamfx::obs::gs::texture>             _output_texture; // Borrowed until the caller releases it.
+			std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> _pool;
+			::streamfx::gfx::blur::region                            _region;
+			::streamfx::gfx::blur::kernel_span                      _kernel;
+			double_t                                                _kernel_size; // Size '_kernel' was retrieved for.
 
 			public:
 			gaussian_linear();
@@ -112,6 +128,13 @@ namespace streamfx::gfx {
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> render() override;
 
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> get() override;
+
+			virtual void set_region(::streamfx::gfx::blur::region area) override;
+
+			virtual ::streamfx::gfx::blur::region get_region() override;
+
+			protected:
+			::streamfx::gfx::blur::kernel_span const& get_kernel();
 		};
 
 		class gaussian_linear_directional : public ::streamfx::gfx::blur::gaussian_linear, public ::streamfx::gfx::blur::base_angle {
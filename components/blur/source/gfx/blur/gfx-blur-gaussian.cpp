@@ -5,28 +5,30 @@
 
 #include "gfx-blur-gaussian.hpp"
 #include "common.hpp"
+#include "gfx-blur-scale.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-helper.hpp"
 #include "plugin.hpp"
+#include "util/util-benchmark.hpp"
 
 #include "warning-disable.hpp"
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include "warning-enable.hpp"
 
 // TODO: It may be possible to optimize to run much faster: https://rastergrid.com/blog/2010/09/efficient-gaussian-blur-with-linear-sampling/
 
-#define ST_KERNEL_SIZE 128u
-#define ST_OVERSAMPLE_MULTIPLIER 2
-#define ST_MAX_BLUR_SIZE ST_KERNEL_SIZE / ST_OVERSAMPLE_MULTIPLIER
+#define ST_OVERSAMPLE_MULTIPLIER ::streamfx::gfx::blur::gaussian_data::oversample
+#define ST_MAX_BLUR_SIZE (::streamfx::gfx::blur::gaussian_data::kernel_size / ST_OVERSAMPLE_MULTIPLIER)
 
-streamfx::gfx::blur::gaussian_data::gaussian_data() : _gfx_util(::streamfx::gfx::util::get())
-{
-	using namespace streamfx::util;
-
-	std::array<double, ST_KERNEL_SIZE> kernel_dbl;
-	std::vector<float>                 kernel(ST_KERNEL_SIZE);
+// Sizes from which the Area blur renders at half and quarter resolution on its own. Compared to a blur of a hard edge
+// at full resolution, the result differs by at most 4 levels at these sizes, and less for any larger size.
+#define ST_HALF_THRESHOLD 12.
+#define ST_QUARTER_THRESHOLD 24.
 
+streamfx::gfx::blur::gaussian_data::gaussian_data() : _paired(false), _gfx_util(::streamfx::gfx::util::get()), _kernels(::streamfx::gfx::blur::kernel_cache::instance())
+{
 	{
 		auto gctx = streamfx::obs::gs::context();
 
@@ -34,62 +36,12 @@ streamfx::gfx::blur::gaussian_data::gaussian_data() : _gfx_util(::streamfx::gfx:
 			auto file = streamfx::data_file_path("effects/blur/gaussian.effect");
 			try {
 				_effect = streamfx::obs::gs::effect::create(file);
+				_paired = _effect.has_technique("DrawPaired");
 			} catch (const std::exception& ex) {
 				DLOG_ERROR("Error loading '%s': %s", file.generic_u8string().c_str(), ex.what());
 			}
 		}
 	}
-
-	//#define ST_USE_PASCAL_TRIANGLE
-
-	// Pre-calculate Kernel Information for all Kernel sizes
-	for (size_t size = 1; size <= ST_MAX_BLUR_SIZE; size++) {
-#ifdef ST_USE_PASCAL_TRIANGLE
-		// The Pascal Triangle can be used to generate Gaussian Kernels, which is
-		// significantly faster than doing the same task with searching. It is also
-		// much more accurate at the same time, so it is a 2-in-1 solution.
-
-		// Generate the required row and sum.
-		size_t offset   = size;
-		size_t row      = size * 2;
-		auto   triangle = math::pascal_triangle<double>(row);
-		double sum      = pow(2, row);
-
-		// Convert all integers to floats.
-		double accum = 0.;
-		for (size_t idx = offset; idx < std::min<size_t>(triangle.size(), ST_KERNEL_SIZE); idx++) {
-			double v                 = static_cast<double>(triangle[idx]) / sum;
-			kernel_dbl[idx - offset] = v;
-			// Accumulator needed as we end up with float inaccuracies above a certain threshold.
-			accum += v * (idx > offset ? 2 : 1);
-		}
-
-		// Rescale all values back into useful ranges.
-		accum = 1. / accum;
-		for (size_t idx = offset; idx < ST_KERNEL_SIZE; idx++) {
-			kernel[idx - offset] = kernel_dbl[idx - offset] * accum;
-		}
-#else
-		size_t oversample = size * ST_OVERSAMPLE_MULTIPLIER;
-
-		// Generate initial weights and calculate a total from them.
-		double total = 0.;
-		for (size_t idx = 0; (idx < oversample) && (idx < ST_KERNEL_SIZE); idx++) {
-			kernel_dbl[idx] = math::gaussian<double>(static_cast<double>(idx), static_cast<double>(size));
-			total += kernel_dbl[idx] * (idx > 0 ? 2 : 1);
-		}
-
-		// Scale the weights according to the total gathered, and convert to float.
-		for (size_t idx = 0; (idx < oversample) && (idx < ST_KERNEL_SIZE); idx++) {
-			kernel_dbl[idx] /= total;
-			kernel[idx] = static_cast<float>(kernel_dbl[idx]);
-		}
-
-#endif
-
-		// Store Kernel
-		_kernels.insert_or_assign(size, kernel);
-	}
 }
 
 streamfx::gfx::blur::gaussian_data::~gaussian_data()
@@ -103,15 +55,20 @@ streamfx::obs::gs::effect streamfx::gfx::blur::gaussian_data::get_effect()
 	return _effect;
 }
 
+bool streamfx::gfx::blur::gaussian_data::has_paired()
+{
+	return _paired;
+}
+
 std::shared_ptr<streamfx::gfx::util> streamfx::gfx::blur::gaussian_data::get_gfx_util()
 {
 	return _gfx_util;
 }
 
-std::vector<float> const& streamfx::gfx::blur::gaussian_data::get_kernel(std::size_t width)
+::streamfx::gfx::blur::kernel_span streamfx::gfx::blur::gaussian_data::get_kernel(double_t width)
 {
-	width = std::clamp<size_t>(width, 1, ST_MAX_BLUR_SIZE);
-	return _kernels.at(width);
+	width = std::clamp<double_t>(width, 1., ST_MAX_BLUR_SIZE);
+	return _kernels->get(::streamfx::gfx::blur::kernel_cache::type::GAUSSIAN, width, &::streamfx::gfx::blur::gaussian_data::generate_kernel);
 }
 
 streamfx::gfx::blur::gaussian_factory::gaussian_factory() {}
@@ -251,12 +208,7 @@ std::shared_ptr<::streamfx::gfx::blur::gaussian_data> streamfx::gfx::blur::gauss
 	return instance;
 }
 
-streamfx::gfx::blur::gaussian::gaussian() : _data(::streamfx::gfx::blur::gaussian_factory::get().data()), _size(1.), _step_scale({1., 1.})
-{
-	auto gctx      = streamfx::obs::gs::context();
-	_rendertarget  = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-	_rendertarget2 = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-}
+streamfx::gfx::blur::gaussian::gaussian() : _data(::streamfx::gfx::blur::gaussian_factory::get().data()), _size(1.), _step_scale({1., 1.}), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _region(), _resolution(::streamfx::gfx::blur::resolution::Automatic), _kernel(), _kernel_size(0.), _p_image("pImage"), _p_image_texel("pImageTexel"), _p_step_scale("pStepScale"), _p_size("pSize"), _p_kernel("pKernel"), _p_angle("pAngle"), _p_center("pCenter") {}
 
 streamfx::gfx::blur::gaussian::~gaussian() {}
 
@@ -314,15 +266,34 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian::ren
 	auto gdmp = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Gaussian Blur");
 #endif
 
-	streamfx::obs::gs::effect effect = _data->get_effect();
-
-	if (!effect || ((_step_scale.first + _step_scale.second) < std::numeric_limits<double_t>::epsilon())) {
+	if (!_data->get_effect() || ((_step_scale.first + _step_scale.second) < std::numeric_limits<double_t>::epsilon())) {
 		return _input_texture;
 	}
 
-	auto    kernel = _data->get_kernel(size_t(_size));
-	float width  = float(_input_texture->get_width());
-	float height = float(_input_texture->get_height());
+	std::shared_ptr<::streamfx::obs::gs::texture> output;
+	if (std::size_t levels = get_levels(); levels > 0) {
+		// Downsampling already blurs a little, so only the variance still missing afterwards is left for the kernel.
+		double_t scale = double_t(uint64_t(1) << levels);
+		double_t size  = std::sqrt(std::max(_size * _size - ::streamfx::gfx::blur::get_downsample_variance(levels), 1.)) / scale;
+
+		auto level = ::streamfx::gfx::blur::downsample(_pool, _input_texture, levels);
+		level      = render_area(level, std::max(size, 1.), ::streamfx::gfx::blur::downsample_region(_region, levels, level->get_width(), level->get_height()));
+		output     = ::streamfx::gfx::blur::upsample(_pool, level, _input_texture->get_width(), _input_texture->get_height(), _region);
+	} else {
+		output = render_area(_input_texture, _size, _region);
+	}
+
+	_output_texture = output;
+	return output;
+}
+
+std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian::render_area(std::shared_ptr<::streamfx::obs::gs::texture> input, double_t size, ::streamfx::gfx::blur::region area)
+{
+	streamfx::obs::gs::effect effect = _data->get_effect();
+
+	auto const& kernel = get_kernel(size);
+	float       width  = float(input->get_width());
+	float       height = float(input->get_height());
 
 	// Setup
 	gs_set_cull_mode(GS_NEITHER);
@@ -338,58 +309,114 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian::ren
 	gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
-	effect.get_parameter("pStepScale").set_float2(float(_step_scale.first), float(_step_scale.second));
-	effect.get_parameter("pSize").set_float(float(_size * ST_OVERSAMPLE_MULTIPLIER));
-	effect.get_parameter("pKernel").set_value(kernel.data(), ST_KERNEL_SIZE);
+	_p_step_scale(effect).set_float2(float(_step_scale.first), float(_step_scale.second));
+	_p_size(effect).set_float(float(size * ST_OVERSAMPLE_MULTIPLIER));
+	_p_kernel(effect).set_value(kernel.data(), kernel.size());
+
+	// Reading texels in pairs is only exact while every step is exactly one texel.
+	const char* technique = ((_step_scale.first == 1.) && (_step_scale.second == 1.) && _data->has_paired()) ? "DrawPaired" : "Draw";
 
 	// First Pass
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
 	if (_step_scale.first > std::numeric_limits<double_t>::epsilon()) {
-		effect.get_parameter("pImage").set_texture(_input_texture);
-		effect.get_parameter("pImageTexel").set_float2(float(1.f / width), 0.f);
+		_p_image(effect).set_texture(input);
+		_p_image_texel(effect).set_float2(float(1.f / width), 0.f);
 
+		rt = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Horizontal");
 #endif
 
-			auto op = _rendertarget2->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
-			while (gs_effect_loop(effect.get_object(), "Draw")) {
+			auto op = rt->render(uint32_t(width), uint32_t(height));
+			// The second pass reads above and below every texel it renders, so those have to be rendered here too.
+			uint32_t radius = static_cast<uint32_t>(std::ceil(size * ST_OVERSAMPLE_MULTIPLIER * _step_scale.second)) + 1;
+			area.dilate(0, radius, uint32_t(width), uint32_t(height)).apply(uint32_t(width), uint32_t(height));
+			while (gs_effect_loop(effect.get_object(), technique)) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
-
-		std::swap(_rendertarget, _rendertarget2);
 	}
 
 	// Second Pass
 	if (_step_scale.second > std::numeric_limits<double_t>::epsilon()) {
-		effect.get_parameter("pImage").set_texture(_rendertarget->get_texture());
-		effect.get_parameter("pImageTexel").set_float2(0.f, float(1.f / height));
+		_p_image(effect).set_texture(rt ? rt->get_texture() : input);
+		_p_image_texel(effect).set_float2(0.f, float(1.f / height));
 
+		// The first pass stays borrowed until this one is done reading from it.
+		auto rt2 = _pool->acquire(uint32_t(width), uint32_t(height));
 		{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Vertical");
 #endif
 
-			auto op = _rendertarget2->render(uint32_t(width), uint32_t(height));
-			gs_ortho(0, 1., 0, 1., 0, 1.);
-			while (gs_effect_loop(effect.get_object(), "Draw")) {
+			auto op = rt2->render(uint32_t(width), uint32_t(height));
+			area.apply(uint32_t(width), uint32_t(height));
+			while (gs_effect_loop(effect.get_object(), technique)) {
 				_data->get_gfx_util()->draw_fullscreen_triangle();
 			}
 		}
-
-		std::swap(_rendertarget, _rendertarget2);
+		rt = std::move(rt2);
 	}
 
 	gs_blend_state_pop();
 
-	return this->get();
+	if (!rt) {
+		return input;
+	}
+	return streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 }
 
 std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian::get()
 {
-	return _rendertarget->get_texture();
+	return _output_texture.lock();
+}
+
+void streamfx::gfx::blur::gaussian::set_region(::streamfx::gfx::blur::region area)
+{
+	_region = area;
+}
+
+::streamfx::gfx::blur::region streamfx::gfx::blur::gaussian::get_region()
+{
+	return _region;
+}
+
+void streamfx::gfx::blur::gaussian::set_resolution(::streamfx::gfx::blur::resolution value)
+{
+	_resolution = value;
+}
+
+::streamfx::gfx::blur::resolution streamfx::gfx::blur::gaussian::get_resolution()
+{
+	return _resolution;
+}
+
+::streamfx::gfx::blur::kernel_span const& streamfx::gfx::blur::gaussian::get_kernel(double_t size)
+{
+	// Only look the kernel up again when the size changed, so that binding it every frame costs nothing.
+	if (_kernel.empty() || (_kernel_size != size)) {
+		_kernel      = _data->get_kernel(size);
+		_kernel_size = size;
+	}
+	return _kernel;
+}
+
+std::size_t streamfx::gfx::blur::gaussian::get_levels()
+{
+	if (_resolution != ::streamfx::gfx::blur::resolution::Automatic) {
+		return static_cast<std::size_t>(_resolution);
+	}
+
+	// A different step scale changes how far the kernel reaches, which the thresholds do not account for.
+	if ((_step_scale.first != 1.) || (_step_scale.second != 1.)) {
+		return 0;
+	} else if (_size >= ST_QUARTER_THRESHOLD) {
+		return 2;
+	} else if (_size >= ST_HALF_THRESHOLD) {
+		return 1;
+	}
+	return 0;
 }
 
 streamfx::gfx::blur::gaussian_directional::gaussian_directional() : m_angle(0.) {}
@@ -425,9 +452,9 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_dire
 		return _input_texture;
 	}
 
-	auto    kernel = _data->get_kernel(size_t(_size));
-	float width  = float(_input_texture->get_width());
-	float height = float(_input_texture->get_height());
+	auto const& kernel = get_kernel(_size);
+	float       width  = float(_input_texture->get_width());
+	float       height = float(_input_texture->get_height());
 
 	// Setup
 	gs_set_cull_mode(GS_NEITHER);
@@ -443,15 +470,16 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_dire
 	gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
-	effect.get_parameter("pImage").set_texture(_input_texture);
-	effect.get_parameter("pImageTexel").set_float2(float(1.f / width * cos(m_angle)), float(1.f / height * sin(m_angle)));
-	effect.get_parameter("pStepScale").set_float2(float(_step_scale.first), float(_step_scale.second));
-	effect.get_parameter("pSize").set_float(float(_size * ST_OVERSAMPLE_MULTIPLIER));
-	effect.get_parameter("pKernel").set_value(kernel.data(), ST_KERNEL_SIZE);
+	_p_image(effect).set_texture(_input_texture);
+	_p_image_texel(effect).set_float2(float(1.f / width * cos(m_angle)), float(1.f / height * sin(m_angle)));
+	_p_step_scale(effect).set_float2(float(_step_scale.first), float(_step_scale.second));
+	_p_size(effect).set_float(float(_size * ST_OVERSAMPLE_MULTIPLIER));
+	_p_kernel(effect).set_value(kernel.data(), kernel.size());
 
+	auto rt = _pool->acquire(uint32_t(width), uint32_t(height));
 	{
-		auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-		gs_ortho(0, 1., 0, 1., 0, 1.);
+		auto op = rt->render(uint32_t(width), uint32_t(height));
+		_region.apply(uint32_t(width), uint32_t(height));
 		while (gs_effect_loop(effect.get_object(), "Draw")) {
 			_data->get_gfx_util()->draw_fullscreen_triangle();
 		}
@@ -459,7 +487,9 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_dire
 
 	gs_blend_state_pop();
 
-	return this->get();
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
 
 ::streamfx::gfx::blur::type streamfx::gfx::blur::gaussian_rotational::get_type()
@@ -481,9 +511,9 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_rota
 		return _input_texture;
 	}
 
-	auto    kernel = _data->get_kernel(size_t(_size));
-	float width  = float(_input_texture->get_width());
-	float height = float(_input_texture->get_height());
+	auto const& kernel = get_kernel(_size);
+	float       width  = float(_input_texture->get_width());
+	float       height = float(_input_texture->get_height());
 
 	// Setup
 	gs_set_cull_mode(GS_NEITHER);
@@ -499,18 +529,19 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_rota
 	gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
-	effect.get_parameter("pImage").set_texture(_input_texture);
-	effect.get_parameter("pImageTexel").set_float2(float(1.f / width), float(1.f / height));
-	effect.get_parameter("pStepScale").set_float2(float(_step_scale.first), float(_step_scale.second));
-	effect.get_parameter("pSize").set_float(float(_size * ST_OVERSAMPLE_MULTIPLIER));
-	effect.get_parameter("pAngle").set_float(float(m_angle / _size));
-	effect.get_parameter("pCenter").set_float2(float(m_center.first), float(m_center.second));
-	effect.get_parameter("pKernel").set_value(kernel.data(), ST_KERNEL_SIZE);
+	_p_image(effect).set_texture(_input_texture);
+	_p_image_texel(effect).set_float2(float(1.f / width), float(1.f / height));
+	_p_step_scale(effect).set_float2(float(_step_scale.first), float(_step_scale.second));
+	_p_size(effect).set_float(float(_size * ST_OVERSAMPLE_MULTIPLIER));
+	_p_angle(effect).set_float(float(m_angle / _size));
+	_p_center(effect).set_float2(float(m_center.first), float(m_center.second));
+	_p_kernel(effect).set_value(kernel.data(), kernel.size());
 
 	// First Pass
+	auto rt = _pool->acquire(uint32_t(width), uint32_t(height));
 	{
-		auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-		gs_ortho(0, 1., 0, 1., 0, 1.);
+		auto op = rt->render(uint32_t(width), uint32_t(height));
+		_region.apply(uint32_t(width), uint32_t(height));
 		while (gs_effect_loop(effect.get_object(), "Rotate")) {
 			_data->get_gfx_util()->draw_fullscreen_triangle();
 		}
@@ -518,7 +549,9 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_rota
 
 	gs_blend_state_pop();
 
-	return this->get();
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
 
 void streamfx::gfx::blur::gaussian_rotational::set_center(double_t x, double_t y)
@@ -557,7 +590,7 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_zoom
 #endif
 
 	streamfx::obs::gs::effect effect = _data->get_effect();
-	auto                      kernel = _data->get_kernel(size_t(_size));
+	auto const&               kernel = get_kernel(_size);
 
 	if (!effect || ((_step_scale.first + _step_scale.second) < std::numeric_limits<double_t>::epsilon())) {
 		return _input_texture;
@@ -580,17 +613,18 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_zoom
 	gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
 	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
 
-	effect.get_parameter("pImage").set_texture(_input_texture);
-	effect.get_parameter("pImageTexel").set_float2(float(1.f / width), float(1.f / height));
-	effect.get_parameter("pStepScale").set_float2(float(_step_scale.first), float(_step_scale.second));
-	effect.get_parameter("pSize").set_float(float(_size));
-	effect.get_parameter("pCenter").set_float2(float(m_center.first), float(m_center.second));
-	effect.get_parameter("pKernel").set_value(kernel.data(), ST_KERNEL_SIZE);
+	_p_image(effect).set_texture(_input_texture);
+	_p_image_texel(effect).set_float2(float(1.f / width), float(1.f / height));
+	_p_step_scale(effect).set_float2(float(_step_scale.first), float(_step_scale.second));
+	_p_size(effect).set_float(float(_size));
+	_p_center(effect).set_float2(float(m_center.first), float(m_center.second));
+	_p_kernel(effect).set_value(kernel.data(), kernel.size());
 
 	// First Pass
+	auto rt = _pool->acquire(uint32_t(width), uint32_t(height));
 	{
-		auto op = _rendertarget->render(uint32_t(width), uint32_t(height));
-		gs_ortho(0, 1., 0, 1., 0, 1.);
+		auto op = rt->render(uint32_t(width), uint32_t(height));
+		_region.apply(uint32_t(width), uint32_t(height));
 		while (gs_effect_loop(effect.get_object(), "Zoom")) {
 			_data->get_gfx_util()->draw_fullscreen_triangle();
 		}
@@ -598,7 +632,9 @@ std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::gaussian_zoom
 
 	gs_blend_state_pop();
 
-	return this->get();
+	auto output     = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	_output_texture = output;
+	return output;
 }
 
 void streamfx::gfx::blur::gaussian_zoom::set_center(double_t x, double_t y)
@@ -612,3 +648,95 @@ void streamfx::gfx::blur::gaussian_zoom::get_center(double_t& x, double_t& y)
 	x = m_center.first;
 	y = m_center.second;
 }
+
+namespace {
+	// Parameters bound by one Area blur per frame, in the order they are bound.
+	constexpr std::string_view benchmark_parameters[] = {"pStepScale", "pSize", "pKernel", "pImage", "pImageTexel", "pImage", "pImageTexel"};
+	constexpr size_t           benchmark_filters      = 20;
+
+	streamfx::obs::gs::effect benchmark_effect()
+	{
+		auto effect = std::make_shared<::streamfx::gfx::blur::gaussian_data>()->get_effect();
+		if (!effect) {
+			throw std::runtime_error("Failed to load effect.");
+		}
+		return effect;
+	}
+} // namespace
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		streamfx::util::benchmark::add("blur.gaussian.data", 10, []() -> streamfx::util::benchmark::function_t {
+			return []() { std::make_shared<::streamfx::gfx::blur::gaussian_data>(); };
+		});
+		streamfx::util::benchmark::add("blur.gaussian.kernel", 1000, []() -> streamfx::util::benchmark::function_t {
+			auto data = std::make_shared<::streamfx::gfx::blur::gaussian_data>();
+			return [data]() {
+				for (size_t width = 1; width <= ST_MAX_BLUR_SIZE; width++) {
+					data->get_kernel(double_t(width));
+				}
+			};
+		});
+		streamfx::util::benchmark::add("blur.gaussian.kernel.fractional", 1000, []() -> streamfx::util::benchmark::function_t {
+			auto data = std::make_shared<::streamfx::gfx::blur::gaussian_data>();
+			return [data]() {
+				for (double_t width = 1.; width <= ST_MAX_BLUR_SIZE; width += 0.25) {
+					data->get_kernel(width);
+				}
+			};
+		});
+		streamfx::util::benchmark::add("blur.gaussian.kernel.uncached", 100, []() -> streamfx::util::benchmark::function_t {
+			auto data  = std::make_shared<::streamfx::gfx::blur::gaussian_data>();
+			auto cache = ::streamfx::gfx::blur::kernel_cache::instance();
+			return [data, cache]() {
+				// Cost of the first frame after a filter changed its size to one nobody used before.
+				cache->clear();
+				data->get_kernel(double_t(ST_MAX_BLUR_SIZE));
+			};
+		});
+
+		// Parameter binding cost per frame for a scene with 20 blur filters, by lookup method.
+		streamfx::util::benchmark::add("blur.gaussian.parameters.linear", 1000, []() -> streamfx::util::benchmark::function_t {
+			auto effect = benchmark_effect();
+			return [effect]() mutable {
+				for (size_t filter = 0; filter < benchmark_filters; filter++) {
+					for (auto name : benchmark_parameters) {
+						// Same as the lookup before names were hashed.
+						for (std::size_t idx = 0; idx < effect.count_parameters(); idx++) {
+							if (strcmp(effect.get()->params.array[idx].name, name.data()) == 0) {
+								streamfx::obs::gs::effect_parameter(effect.get()->params.array + idx, effect);
+								break;
+							}
+						}
+					}
+				}
+			};
+		});
+		streamfx::util::benchmark::add("blur.gaussian.parameters.hashed", 1000, []() -> streamfx::util::benchmark::function_t {
+			auto effect = benchmark_effect();
+			return [effect]() mutable {
+				for (size_t filter = 0; filter < benchmark_filters; filter++) {
+					for (auto name : benchmark_parameters) {
+						effect.get_parameter(name);
+					}
+				}
+			};
+		});
+		streamfx::util::benchmark::add("blur.gaussian.parameters.handle", 1000, []() -> streamfx::util::benchmark::function_t {
+			auto effect  = benchmark_effect();
+			auto handles = std::make_shared<std::vector<streamfx::obs::gs::effect_parameter_handle>>();
+			for (size_t filter = 0; filter < benchmark_filters; filter++) {
+				for (auto name : benchmark_parameters) {
+					handles->emplace_back(name);
+				}
+			}
+			return [effect, handles]() mutable {
+				for (auto& handle : *handles) {
+					handle(effect);
+				}
+			};
+		});
+	},
+	[]() { // Finalizer
+	},
+	streamfx::loader_priority::NORMAL);
@@ -5,9 +5,10 @@
 #pragma once
 #include "common.hpp"
 #include "gfx-blur-base.hpp"
+#include "gfx-blur-kernel-cache.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 
 #include "warning-disable.hpp"
@@ -18,19 +19,31 @@
 namespace streamfx::gfx {
 	namespace blur {
 		class gaussian_data {
-			streamfx::obs::gs::effect            _effect;
-			std::shared_ptr<streamfx::gfx::util> _gfx_util;
-			std::map<size_t, std::vector<float>> _kernels;
+			streamfx::obs::gs::effect                            _effect;
+			bool                                                 _paired;
+			std::shared_ptr<streamfx::gfx::util>                 _gfx_util;
+			std::shared_ptr<::streamfx::gfx::blur::kernel_cache> _kernels;
 
 			public:
+			static constexpr std::size_t kernel_size = 128; // As many weights as the effect reads.
+			static constexpr std::size_t oversample  = 2;   // Samples taken per texel of the size.
+
 			gaussian_data();
 			virtual ~gaussian_data();
 
 			streamfx::obs::gs::effect get_effect();
 
+			/** Whether the effect can read the texels of an Area blur in pairs, which needs half as many samples.
+			 */
+			bool has_paired();
+
 			std::shared_ptr<streamfx::gfx::util> get_gfx_util();
 
-			std::vector<float> const& get_kernel(std::size_t width);
+			::streamfx::gfx::blur::kernel_span get_kernel(double_t width);
+
+			/** Generate the kernel for an integer size, between which the kernel cache interpolates.
+			 */
+			static std::vector<float> generate_kernel(std::size_t size);
 		};
 
 		class gaussian_factory : public ::streamfx::gfx::blur::ifactory {
@@ -77,17 +90,27 @@ namespace streamfx::gfx {
 			static ::streamfx::gfx::blur::gaussian_factory& get();
 		};
 
-		class gaussian : public ::streamfx::gfx::blur::base {
+		class gaussian : public ::streamfx::gfx::blur::base, public ::streamfx::gfx::blur::base_region, public ::streamfx::gfx::blur::base_resolution {
 			protected:
 			std::shared_ptr<::streamfx::gfx::blur::gaussian_data> _data;
 
-			double_t                                           _size;
-			std::pair<double_t, double_t>                      _step_scale;
-			std::shared_ptr<::streamfx::obs::gs::texture>      _input_texture;
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget;
-
-			private:
-			std::shared_ptr<::streamfx::obs::gs::rendertarget> _rendertarget2;
+			double_t                                                _size;
+			std::pair<double_t, double_t>                           _step_scale;
+			std::shared_ptr<::streamfx::obs::gs::texture>           _input_texture;
+			std::weak_ptr<::streamfx::obs::gs::texture>             _output_texture; // Borrowed until the caller releases it.
+			std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> _pool;
+			::streamfx::gfx::blur::region                            _region;
+			::streamfx::gfx::blur::resolution                        _resolution;
+			::streamfx::gfx::blur::kernel_span                      _kernel;
+			double_t                                                _kernel_size; // Size '_kernel' was retrieved for.
+
+			::streamfx::obs::gs::effect_parameter_handle _p_image;
+			::streamfx::obs::gs::effect_parameter_handle _p_image_texel;
+			::streamfx::obs::gs::effect_parameter_handle _p_step_scale;
+			::streamfx::obs::gs::effect_parameter_handle _p_size;
+			::streamfx::obs::gs::effect_parameter_handle _p_kernel;
+			::streamfx::obs::gs::effect_parameter_handle _p_angle;
+			::streamfx::obs::gs::effect_parameter_handle _p_center;
 
 			public:
 			gaussian();
@@ -112,6 +135,21 @@ namespace streamfx::gfx {
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> render() override;
 
 			virtual std::shared_ptr<::streamfx::obs::gs::texture> get() override;
+
+			virtual void set_region(::streamfx::gfx::blur::region area) override;
+
+			virtual ::streamfx::gfx::blur::region get_region() override;
+
+			virtual void set_resolution(::streamfx::gfx::blur::resolution value) override;
+
+			virtual ::streamfx::gfx::blur::resolution get_resolution() override;
+
+			protected:
+			::streamfx::gfx::blur::kernel_span const& get_kernel(double_t size);
+
+			std::size_t get_levels();
+
+			std::shared_ptr<::streamfx::obs::gs::texture> render_area(std::shared_ptr<::streamfx::obs::gs::texture> input, double_t size, ::streamfx::gfx::blur::region area);
 		};
 
 		class gaussian_directional : public ::streamfx::gfx::blur::gaussian, public ::streamfx::gfx::blur::base_angle {
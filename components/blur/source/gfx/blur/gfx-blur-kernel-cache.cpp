@@ -0,0 +1,127 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gfx-blur-kernel-cache.hpp"
+
+#include "warning-disable.hpp"
+#include <cmath>
+#include "warning-enable.hpp"
+
+// Sizes are quantized to this many steps per integer, which is far below what is visible in the result.
+#define ST_FRACTIONS 16u
+
+// Enough to hold every integer size of both Gaussian blurs at once.
+#define ST_CAPACITY 192u
+
+streamfx::gfx::blur::kernel_span::kernel_span() : _kernel() {}
+
+streamfx::gfx::blur::kernel_span::kernel_span(std::shared_ptr<const std::vector<float>> kernel) : _kernel(std::move(kernel)) {}
+
+const float* streamfx::gfx::blur::kernel_span::data() const
+{
+	return _kernel ? _kernel->data() : nullptr;
+}
+
+std::size_t streamfx::gfx::blur::kernel_span::size() const
+{
+	return _kernel ? _kernel->size() : 0;
+}
+
+float streamfx::gfx::blur::kernel_span::operator[](std::size_t idx) const
+{
+	return (*_kernel)[idx];
+}
+
+bool streamfx::gfx::blur::kernel_span::empty() const
+{
+	return size() == 0;
+}
+
+streamfx::gfx::blur::kernel_cache::kernel_cache() : _lock(), _entries(), _index() {}
+
+streamfx::gfx::blur::kernel_cache::~kernel_cache() {}
+
+std::shared_ptr<const std::vector<float>> streamfx::gfx::blur::kernel_cache::find(key_t key)
+{
+	std::lock_guard<std::mutex> lg(_lock);
+	if (auto kv = _index.find(key); kv != _index.end()) {
+		_entries.splice(_entries.begin(), _entries, kv->second);
+		return kv->second->kernel;
+	}
+	return nullptr;
+}
+
+std::shared_ptr<const std::vector<float>> streamfx::gfx::blur::kernel_cache::insert(key_t key, std::shared_ptr<const std::vector<float>> kernel)
+{
+	std::lock_guard<std::mutex> lg(_lock);
+
+	// Another thread may have generated the same kernel in the meantime, in which case theirs is kept.
+	if (auto kv = _index.find(key); kv != _index.end()) {
+		_entries.splice(_entries.begin(), _entries, kv->second);
+		return kv->second->kernel;
+	}
+
+	_entries.push_front({key, kernel});
+	_index.emplace(key, _entries.begin());
+	while (_entries.size() > ST_CAPACITY) {
+		_index.erase(_entries.back().key);
+		_entries.pop_back();
+	}
+	return kernel;
+}
+
+std::shared_ptr<const std::vector<float>> streamfx::gfx::blur::kernel_cache::get_quantized(type kind, uint32_t size, generator_t generator)
+{
+	key_t key{kind, size};
+	if (auto kernel = find(key); kernel) {
+		return kernel;
+	}
+
+	// Generate outside of the lock, as this can take a while for large kernels.
+	uint32_t fraction = size % ST_FRACTIONS;
+	if (fraction == 0) {
+		return insert(key, std::make_shared<const std::vector<float>>(generator(size / ST_FRACTIONS)));
+	}
+
+	// Both neighbours are normalized, so a weighted sum of the two with weights adding up to one is as well.
+	auto   lower  = get_quantized(kind, size - fraction, generator);
+	auto   upper  = get_quantized(kind, size - fraction + ST_FRACTIONS, generator);
+	float  weight = static_cast<float>(fraction) / static_cast<float>(ST_FRACTIONS);
+	size_t length = std::max(lower->size(), upper->size());
+
+	std::vector<float> kernel(length, 0.f);
+	for (size_t idx = 0; idx < length; idx++) {
+		float a     = (idx < lower->size()) ? (*lower)[idx] : 0.f;
+		float b     = (idx < upper->size()) ? (*upper)[idx] : 0.f;
+		kernel[idx] = a + (b - a) * weight;
+	}
+	return insert(key, std::make_shared<const std::vector<float>>(std::move(kernel)));
+}
+
+streamfx::gfx::blur::kernel_span streamfx::gfx::blur::kernel_cache::get(type kind, double_t size, generator_t generator)
+{
+	size = std::max(size, 1.);
+	return kernel_span(get_quantized(kind, static_cast<uint32_t>(std::lround(size * ST_FRACTIONS)), generator));
+}
+
+void streamfx::gfx::blur::kernel_cache::clear()
+{
+	std::lock_guard<std::mutex> lg(_lock);
+	_index.clear();
+	_entries.clear();
+}
+
+std::shared_ptr<::streamfx::gfx::blur::kernel_cache> streamfx::gfx::blur::kernel_cache::instance()
+{
+	static std::weak_ptr<::streamfx::gfx::blur::kernel_cache> winst;
+	static std::mutex                                         mtx;
+
+	std::unique_lock<decltype(mtx)> lock(mtx);
+	auto                            instance = winst.lock();
+	if (!instance) {
+		instance = std::shared_ptr<::streamfx::gfx::blur::kernel_cache>(new ::streamfx::gfx::blur::kernel_cache());
+		winst    = instance;
+	}
+	return instance;
+}
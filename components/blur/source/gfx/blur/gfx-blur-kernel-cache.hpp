@@ -0,0 +1,89 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+
+#include "warning-disable.hpp"
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "warning-enable.hpp"
+
+namespace streamfx::gfx {
+	namespace blur {
+		/** Read-only view of a cached kernel, which stays valid for as long as the view exists.
+		 */
+		class kernel_span {
+			std::shared_ptr<const std::vector<float>> _kernel;
+
+			public:
+			kernel_span();
+			kernel_span(std::shared_ptr<const std::vector<float>> kernel);
+
+			const float* data() const;
+
+			std::size_t size() const;
+
+			float operator[](std::size_t idx) const;
+
+			bool empty() const;
+		};
+
+		/** Kernels shared by all Gaussian blur implementations.
+		 *
+		 * Kernels are generated on first use instead of all at once, and only the most recently used ones are kept.
+		 * Sizes between two integers are quantized to a fraction and interpolated from the neighbouring kernels.
+		 */
+		class kernel_cache {
+			public:
+			enum class type {
+				GAUSSIAN,
+				GAUSSIAN_LINEAR,
+			};
+
+			// Generates the normalized kernel for an integer size.
+			typedef std::vector<float> (*generator_t)(std::size_t size);
+
+			private:
+			typedef std::pair<type, uint32_t> key_t;
+
+			struct entry {
+				key_t                                     key;
+				std::shared_ptr<const std::vector<float>> kernel;
+			};
+
+			std::mutex                                  _lock;
+			std::list<entry>                            _entries; // Most recently used kernels are at the front.
+			std::map<key_t, std::list<entry>::iterator> _index;
+
+			private:
+			kernel_cache();
+
+			std::shared_ptr<const std::vector<float>> find(key_t key);
+
+			std::shared_ptr<const std::vector<float>> insert(key_t key, std::shared_ptr<const std::vector<float>> kernel);
+
+			std::shared_ptr<const std::vector<float>> get_quantized(type kind, uint32_t size, generator_t generator);
+
+			public:
+			~kernel_cache();
+
+			/** Retrieve the kernel for the given size, generating it if it is not cached.
+			 *
+			 * 'generator' must always be the same for the same 'kind'.
+			 */
+			kernel_span get(type kind, double_t size, generator_t generator);
+
+			/** Drop all cached kernels. Kernels still in use remain valid.
+			 */
+			void clear();
+
+			public /* Singleton */:
+			static std::shared_ptr<::streamfx::gfx::blur::kernel_cache> instance();
+		};
+	} // namespace blur
+} // namespace streamfx::gfx
@@ -0,0 +1,163 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2019-2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+// Everything the blurs calculate without a graphics device, so that it can be checked without one.
+
+#include "common.hpp"
+#include "gfx-blur-gaussian-linear.hpp"
+#include "gfx-blur-gaussian.hpp"
+#include "gfx-blur-scale.hpp"
+
+#include "warning-disable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "warning-enable.hpp"
+
+// Gaussian
+#define ST_GAUSSIAN_KERNEL_SIZE ::streamfx::gfx::blur::gaussian_data::kernel_size
+#define ST_GAUSSIAN_OVERSAMPLE ::streamfx::gfx::blur::gaussian_data::oversample
+
+//#define ST_USE_PASCAL_TRIANGLE
+
+std::vector<float> streamfx::gfx::blur::gaussian_data::generate_kernel(std::size_t size)
+{
+	using namespace streamfx::util;
+
+	std::array<double, ST_GAUSSIAN_KERNEL_SIZE> kernel_dbl;
+	std::vector<float>                          kernel(ST_GAUSSIAN_KERNEL_SIZE);
+
+#ifdef ST_USE_PASCAL_TRIANGLE
+	// The Pascal Triangle can be used to generate Gaussian Kernels, which is
+	// significantly faster than doing the same task with searching. It is also
+	// much more accurate at the same time, so it is a 2-in-1 solution.
+
+	// Generate the required row and sum.
+	size_t offset   = size;
+	size_t row      = size * 2;
+	auto   triangle = math::pascal_triangle<double>(row);
+	double sum      = pow(2, row);
+
+	// Convert all integers to floats.
+	double accum = 0.;
+	for (size_t idx = offset; idx < std::min<size_t>(triangle.size(), ST_GAUSSIAN_KERNEL_SIZE); idx++) {
+		double v                 = static_cast<double>(triangle[idx]) / sum;
+		kernel_dbl[idx - offset] = v;
+		// Accumulator needed as we end up with float inaccuracies above a certain threshold.
+		accum += v * (idx > offset ? 2 : 1);
+	}
+
+	// Rescale all values back into useful ranges.
+	accum = 1. / accum;
+	for (size_t idx = offset; idx < ST_GAUSSIAN_KERNEL_SIZE; idx++) {
+		kernel[idx - offset] = kernel_dbl[idx - offset] * accum;
+	}
+#else
+	size_t oversample = size * ST_GAUSSIAN_OVERSAMPLE;
+
+	// Generate initial weights and calculate a total from them.
+	double total = 0.;
+	for (size_t idx = 0; (idx < oversample) && (idx < ST_GAUSSIAN_KERNEL_SIZE); idx++) {
+		kernel_dbl[idx] = math::gaussian<double>(static_cast<double>(idx), static_cast<double>(size));
+		total += kernel_dbl[idx] * (idx > 0 ? 2 : 1);
+	}
+
+	// Scale the weights according to the total gathered, and convert to float.
+	for (size_t idx = 0; (idx < oversample) && (idx < ST_GAUSSIAN_KERNEL_SIZE); idx++) {
+		kernel_dbl[idx] /= total;
+		kernel[idx] = static_cast<float>(kernel_dbl[idx]);
+	}
+#endif
+
+	return kernel;
+}
+
+// Gaussian Linear
+// FIXME: This breaks when the kernel size is changed, due to the way the Gaussian
+//  function first goes up at the point, and then once we pass the critical point
+//  will go down again and it is not handled well. This is a pretty basic
+//  approximation anyway at the moment.
+#define ST_LINEAR_KERNEL_SIZE ::streamfx::gfx::blur::gaussian_linear_data::kernel_size
+#define ST_LINEAR_MAX_SIZE (ST_LINEAR_KERNEL_SIZE - 1)
+#define ST_LINEAR_SEARCH_DENSITY double_t(1. / 500.)
+#define ST_LINEAR_SEARCH_THRESHOLD double_t(1. / (ST_LINEAR_KERNEL_SIZE * 5))
+#define ST_LINEAR_SEARCH_EXTENSION 1
+
+namespace {
+	double_t find_deviation(double_t kernel_size)
+	{
+		// Search for the smallest width at which the Gaussian function just outside of the kernel reaches the
+		// threshold. For a fixed position the function only rises with the width until the width matches the
+		// position, so the search can be a bisection instead of a scan.
+		double_t x    = kernel_size + ST_LINEAR_SEARCH_EXTENSION;
+		double_t low  = ST_LINEAR_SEARCH_DENSITY;
+		double_t high = x;
+		if (streamfx::util::math::gaussian<double_t>(x, high) <= ST_LINEAR_SEARCH_THRESHOLD) {
+			return 1.;
+		}
+		while ((high - low) > ST_LINEAR_SEARCH_DENSITY) {
+			double_t mid = (low + high) / 2.;
+			if (streamfx::util::math::gaussian<double_t>(x, mid) > ST_LINEAR_SEARCH_THRESHOLD) {
+				high = mid;
+			} else {
+				low = mid;
+			}
+		}
+		return high;
+	}
+} // namespace
+
+std::vector<float> streamfx::gfx::blur::gaussian_linear_data::generate_kernel(std::size_t kernel_size)
+{
+	std::vector<double_t> kernel_math(ST_LINEAR_KERNEL_SIZE);
+	std::vector<float>    kernel_data(ST_LINEAR_KERNEL_SIZE);
+	double_t              actual_width = find_deviation(double_t(kernel_size));
+
+	// Calculate and normalize
+	double_t sum = 0;
+	for (std::size_t p = 0; p <= kernel_size; p++) {
+		kernel_math[p] = streamfx::util::math::gaussian<double_t>(double_t(p), actual_width);
+		sum += kernel_math[p] * (p > 0 ? 2 : 1);
+	}
+
+	// Normalize to fill the entire 0..1 range over the width.
+	double_t inverse_sum = 1.0 / sum;
+	for (std::size_t p = 0; p <= kernel_size; p++) {
+		kernel_data.at(p) = float(kernel_math[p] * inverse_sum);
+	}
+
+	return kernel_data;
+}
+
+double_t streamfx::gfx::blur::gaussian_linear_data::get_deviation(double_t width)
+{
+	return find_deviation(std::clamp<double_t>(width, 1., ST_LINEAR_MAX_SIZE));
+}
+
+double_t streamfx::gfx::blur::gaussian_linear_data::find_width(double_t deviation)
+{
+	// The deviation only grows with the width, so the closest width can be found with a bisection.
+	auto low  = size_t(1);
+	auto high = size_t(ST_LINEAR_MAX_SIZE);
+	while (low < high) {
+		size_t mid = (low + high) / 2;
+		if (get_deviation(double_t(mid)) < deviation) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	if ((low > 1) && ((deviation - get_deviation(double_t(low - 1))) < (get_deviation(double_t(low)) - deviation))) {
+		low--;
+	}
+	return double_t(low);
+}
+
+// Scaling
+double_t streamfx::gfx::blur::get_downsample_variance(std::size_t levels)
+{
+	// Averaging blocks of 2^n texels is a box filter of that width, with a variance of (w² - 1) / 12.
+	double_t scale = double_t(uint64_t(1) << levels);
+	return (scale * scale - 1.) / 12.;
+}
@@ -0,0 +1,105 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gfx-blur-scale.hpp"
+#include "obs/gs/gs-helper.hpp"
+
+#include "warning-disable.hpp"
+#include <algorithm>
+#include "warning-enable.hpp"
+
+namespace {
+	void draw_scaled(gs_effect_t* effect, std::shared_ptr<::streamfx::obs::gs::texture> const& texture, uint32_t width, uint32_t height, ::streamfx::gfx::blur::region const& area)
+	{
+		// The default effect samples linearly, so halving the size averages each 2x2 block of texels.
+		gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture->get_object());
+		area.apply(width, height);
+		gs_matrix_push();
+		gs_matrix_scale3f(1.f / static_cast<float>(width), 1.f / static_cast<float>(height), 1.f);
+		while (gs_effect_loop(effect, "Draw")) {
+			gs_draw_sprite(texture->get_object(), 0, width, height);
+		}
+		gs_matrix_pop();
+	}
+
+	void push_state()
+	{
+		gs_blend_state_push();
+		gs_reset_blend_state();
+		gs_enable_color(true, true, true, true);
+		gs_enable_blending(false);
+		gs_enable_depth_test(false);
+		gs_enable_stencil_test(false);
+		gs_enable_stencil_write(false);
+		gs_set_cull_mode(GS_NEITHER);
+		gs_depth_function(GS_ALWAYS);
+		gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+	}
+} // namespace
+
+std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::downsample(std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> const& pool, std::shared_ptr<::streamfx::obs::gs::texture> const& texture, std::size_t levels)
+{
+	gs_effect_t* effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	uint32_t     width  = texture->get_width();
+	uint32_t     height = texture->get_height();
+
+	push_state();
+
+	// Each level is only borrowed until the next smaller one has been rendered from it.
+	std::shared_ptr<::streamfx::obs::gs::texture> level = texture;
+	for (std::size_t n = 1; n <= levels; n++) {
+#if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
+		auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Down %" PRIuMAX, n);
+#endif
+
+		uint32_t lwidth  = std::max<uint32_t>(width >> n, 1);
+		uint32_t lheight = std::max<uint32_t>(height >> n, 1);
+		auto     rt      = pool->acquire(lwidth, lheight);
+		{
+			auto op = rt->render(lwidth, lheight);
+			draw_scaled(effect, level, lwidth, lheight, ::streamfx::gfx::blur::region{});
+		}
+		level = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	}
+
+	gs_blend_state_pop();
+
+	return level;
+}
+
+std::shared_ptr<::streamfx::obs::gs::texture> streamfx::gfx::blur::upsample(std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> const& pool, std::shared_ptr<::streamfx::obs::gs::texture> const& texture, uint32_t width, uint32_t height, ::streamfx::gfx::blur::region const& area)
+{
+	gs_effect_t* effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+
+	push_state();
+
+	auto rt = pool->acquire(width, height);
+	{
+#if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
+		auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_azure_radiance, "Up");
+#endif
+
+		auto op = rt->render(width, height);
+		draw_scaled(effect, texture, width, height, area);
+	}
+
+	gs_blend_state_pop();
+
+	return streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+}
+
+::streamfx::gfx::blur::region streamfx::gfx::blur::downsample_region(::streamfx::gfx::blur::region const& area, std::size_t levels, uint32_t width, uint32_t height)
+{
+	if (area.empty()) {
+		return area;
+	}
+
+	// Bilinear filtering also reads the texels right next to the area when scaling back up.
+	uint32_t scale  = uint32_t(1) << levels;
+	uint32_t left   = area.x / scale;
+	uint32_t top    = area.y / scale;
+	uint32_t right  = (area.x + area.width + scale - 1) / scale;
+	uint32_t bottom = (area.y + area.height + scale - 1) / scale;
+	return ::streamfx::gfx::blur::region{left, top, right - left, bottom - top}.dilate(1, 1, width, height);
+}
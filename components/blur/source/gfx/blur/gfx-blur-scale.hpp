@@ -0,0 +1,38 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+#include "gfx-blur-base.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
+#include "obs/gs/gs-texture.hpp"
+
+#include "warning-disable.hpp"
+#include <memory>
+#include "warning-enable.hpp"
+
+// Helpers for blurring at a lower resolution than the input, shared by all blurs that support it.
+
+namespace streamfx::gfx {
+	namespace blur {
+		/** Halve the size of the texture the given number of times.
+		 *
+		 * Every halving averages each 2x2 block of texels, which blurs the image a little by itself. The variance
+		 * that adds is returned by get_downsample_variance().
+		 */
+		std::shared_ptr<::streamfx::obs::gs::texture> downsample(std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> const& pool, std::shared_ptr<::streamfx::obs::gs::texture> const& texture, std::size_t levels);
+
+		/** Scale the texture up to the given size with bilinear filtering, only rendering the given area.
+		 */
+		std::shared_ptr<::streamfx::obs::gs::texture> upsample(std::shared_ptr<::streamfx::obs::gs::rendertarget_pool> const& pool, std::shared_ptr<::streamfx::obs::gs::texture> const& texture, uint32_t width, uint32_t height, ::streamfx::gfx::blur::region const& area);
+
+		/** Area of a texture downsampled by the given number of levels that is needed to upsample the area again.
+		 */
+		::streamfx::gfx::blur::region downsample_region(::streamfx::gfx::blur::region const& area, std::size_t levels, uint32_t width, uint32_t height);
+
+		/** Variance in texels of the full size texture that downsampling by the given number of levels adds.
+		 */
+		double_t get_downsample_variance(std::size_t levels);
+	} // namespace blur
+} // namespace streamfx::gfx
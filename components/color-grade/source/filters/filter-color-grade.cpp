@@ -113,7 +113,7 @@ static constexpr std::string_view HELP_URL = "https://github.com/Xaymar/obs-Stre
 
 color_grade_instance::~color_grade_instance() {}
 
-color_grade_instance::color_grade_instance(obs_data_t* data, obs_source_t* self) : obs::source_instance(data, self), _effect(), _gfx_util(::streamfx::gfx::util::get()), _lift(), _gamma(), _gain(), _offset(), _tint_detection(), _tint_luma(), _tint_exponent(), _tint_low(), _tint_mid(), _tint_hig(), _correction(), _lut_enabled(true), _lut_depth(), _ccache_rt(), _ccache_texture(), _ccache_fresh(false), _lut_initialized(false), _lut_dirty(true), _lut_producer(), _lut_consumer(), _lut_rt(), _lut_texture(), _cache_rt(), _cache_texture(), _cache_fresh(false)
+color_grade_instance::color_grade_instance(obs_data_t* data, obs_source_t* self) : obs::source_instance(data, self), _effect(), _gfx_util(::streamfx::gfx::util::get()), _lift(), _gamma(), _gain(), _offset(), _tint_detection(), _tint_luma(), _tint_exponent(), _tint_low(), _tint_mid(), _tint_hig(), _correction(), _lut_enabled(true), _lut_depth(), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _ccache_texture(), _ccache_fresh(false), _lut_initialized(false), _lut_dirty(true), _lut_producer(), _lut_consumer(), _lut_rt(), _lut_texture(), _cache_texture(), _cache_fresh(false)
 {
 	{
 		auto gctx = streamfx::obs::gs::context();
@@ -138,24 +138,11 @@ color_grade_instance::color_grade_instance(obs_data_t* data, obs_source_t* self)
 			D_LOG_WARNING("Failed to initialize LUT rendering, falling back to direct rendering.\n%s", ex.what());
 			_lut_initialized = false;
 		}
-
-		// Allocate render target for rendering.
-		try {
-			allocate_rendertarget(GS_RGBA);
-		} catch (std::exception const& ex) {
-			D_LOG_ERROR("Failed to acquire render target for rendering: %s", ex.what());
-			throw;
-		}
 	}
 
 	update(data);
 }
 
-void color_grade_instance::allocate_rendertarget(gs_color_format format)
-{
-	_cache_rt = std::make_unique<streamfx::obs::gs::rendertarget>(format, GS_ZS_NONE);
-}
-
 float fix_gamma_value(double_t v)
 {
 	if (v < 0.0) {
@@ -333,6 +320,8 @@ void color_grade_instance::video_tick(float)
 {
 	_ccache_fresh = false;
 	_cache_fresh  = false;
+	_ccache_texture.reset();
+	_cache_texture.reset();
 }
 
 void color_grade_instance::video_render(gs_effect_t* shader)
@@ -363,13 +352,9 @@ void color_grade_instance::video_render(gs_effect_t* shader)
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 		streamfx::obs::gs::debug_marker gdmp{streamfx::obs::gs::debug_color_cache, "Cache '%s'", obs_source_get_name(target)};
 #endif
-		// If the input cache render target doesn't exist, create it.
-		if (!_ccache_rt) {
-			_ccache_rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-		}
-
+		auto rt = _pool->acquire(width, height);
 		{
-			auto op = _ccache_rt->render(width, height);
+			auto op = rt->render(width, height);
 			gs_ortho(0, static_cast<float>(width), 0, static_cast<float>(height), 0, 1);
 
 			// Blank out the input cache.
@@ -403,7 +388,7 @@ void color_grade_instance::video_render(gs_effect_t* shader)
 		}
 
 		// Try and retrieve the input cache as a texture for later use.
-		_ccache_rt->get_texture(_ccache_texture);
+		_ccache_texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 		if (!_ccache_texture) {
 			throw std::runtime_error("Failed to cache original source.");
 		}
@@ -426,14 +411,10 @@ void color_grade_instance::video_render(gs_effect_t* shader)
 				_cache_fresh = false;
 			}
 
-			// Reallocate the rendertarget if necessary.
-			if (_cache_rt->get_color_format() != GS_RGBA) {
-				allocate_rendertarget(GS_RGBA);
-			}
-
 			if (!_cache_fresh) {
+				auto rt = _pool->acquire(width, height);
 				{ // Render the source to the cache.
-					auto op = _cache_rt->render(width, height);
+					auto op = rt->render(width, height);
 					gs_ortho(0, 1., 0, 1., 0, 1);
 
 					// Blank out the input cache.
@@ -467,7 +448,7 @@ void color_grade_instance::video_render(gs_effect_t* shader)
 				}
 
 				// Try and retrieve the render cache as a texture.
-				_cache_rt->get_texture(_cache_texture);
+				_cache_texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 
 				// Mark the render cache as valid.
 				_cache_fresh = true;
@@ -484,13 +465,9 @@ void color_grade_instance::video_render(gs_effect_t* shader)
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 		streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_convert, "Direct Rendering"};
 #endif
-		// Reallocate the rendertarget if necessary.
-		if (_cache_rt->get_color_format() != GS_RGBA) {
-			allocate_rendertarget(GS_RGBA);
-		}
-
+		auto rt = _pool->acquire(width, height);
 		{ // Render the source to the cache.
-			auto op = _cache_rt->render(width, height);
+			auto op = rt->render(width, height);
 			gs_ortho(0, 1, 0, 1, 0, 1);
 
 			prepare_effect();
@@ -526,7 +503,7 @@ void color_grade_instance::video_render(gs_effect_t* shader)
 		}
 
 		// Try and retrieve the render cache as a texture.
-		_cache_rt->get_texture(_cache_texture);
+		_cache_texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 
 		// Mark the render cache as valid.
 		_cache_fresh = true;
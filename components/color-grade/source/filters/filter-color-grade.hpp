@@ -7,7 +7,7 @@
 #include "gfx/lut/gfx-lut-consumer.hpp"
 #include "gfx/lut/gfx-lut-producer.hpp"
 #include "gfx/lut/gfx-lut.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 #include "obs/gs/gs-vertexbuffer.hpp"
 #include "obs/obs-source-factory.hpp"
@@ -51,10 +51,12 @@ namespace streamfx::filter::color_grade {
 		bool                            _lut_enabled;
 		streamfx::gfx::lut::color_depth _lut_depth;
 
+		// Render Targets, borrowed until the next tick.
+		std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+
 		// Capture Cache
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _ccache_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _ccache_texture;
-		bool                                             _ccache_fresh;
+		std::shared_ptr<streamfx::obs::gs::texture> _ccache_texture;
+		bool                                        _ccache_fresh;
 
 		// LUT work flow
 		bool                                             _lut_initialized;
@@ -65,16 +67,13 @@ namespace streamfx::filter::color_grade {
 		std::shared_ptr<streamfx::obs::gs::texture>      _lut_texture;
 
 		// Render Cache
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _cache_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _cache_texture;
-		bool                                             _cache_fresh;
+		std::shared_ptr<streamfx::obs::gs::texture> _cache_texture;
+		bool                                        _cache_fresh;
 
 		public:
 		color_grade_instance(obs_data_t* data, obs_source_t* self);
 		virtual ~color_grade_instance();
 
-		void allocate_rendertarget(gs_color_format format);
-
 		virtual void load(obs_data_t* data) override;
 		virtual void migrate(obs_data_t* data, uint64_t version) override;
 		virtual void update(obs_data_t* data) override;
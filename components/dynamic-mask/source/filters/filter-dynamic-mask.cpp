@@ -103,18 +103,17 @@ dynamic_mask_instance::dynamic_mask_instance(obs_data_t* settings, obs_source_t*
 	  _input_child(), //
 	  _input_vs(), //
 	  _input_ac(), //
+	  _pool(streamfx::obs::gs::rendertarget_pool::instance()), //
+	  _captures(streamfx::gfx::source_capture_cache::instance()), //
 	  _have_base(false), //
-	  _base_rt(), //
 	  _base_tex(), //
 	  _base_color_space(GS_CS_SRGB), //
 	  _base_color_format(GS_RGBA), //
 	  _have_input(false), //
-	  _input_rt(), //
 	  _input_tex(), //
 	  _input_color_space(GS_CS_SRGB), //
 	  _input_color_format(GS_RGBA), //
 	  _have_final(false), //
-	  _final_rt(), //
 	  _final_tex(), //
 	  _channels(), //
 	  _precalc(), //
@@ -284,6 +283,9 @@ void dynamic_mask_instance::video_tick(float time)
 
 	_have_final = false;
 	_final_srgb = _base_srgb;
+	_base_tex.reset();
+	_input_tex.reset();
+	_final_tex.reset();
 }
 
 void dynamic_mask_instance::video_render(gs_effect_t* in_effect)
@@ -314,11 +316,6 @@ void dynamic_mask_instance::video_render(gs_effect_t* in_effect)
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 		streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_cache, "Base Texture"};
 #endif
-		// Ensure the Render Target matches the expected format.
-		if (!_base_rt || (_base_rt->get_color_format() != _base_color_format)) {
-			_base_rt = std::make_shared<streamfx::obs::gs::rendertarget>(_base_color_format, GS_ZS_NONE);
-		}
-
 		bool previous_srgb  = gs_framebuffer_srgb_enabled();
 		auto previous_lsrgb = gs_get_linear_srgb();
 		gs_set_linear_srgb(_base_srgb);
@@ -327,8 +324,9 @@ void dynamic_mask_instance::video_render(gs_effect_t* in_effect)
 		// Begin rendering the source with a certain color space.
 		if (obs_source_process_filter_begin_with_color_space(_self, _base_color_format, _base_color_space, OBS_ALLOW_DIRECT_RENDERING)) {
 			try {
+				auto rt = _pool->acquire(width, height, _base_color_format);
 				{
-					auto op = _base_rt->render(width, height, _base_color_space);
+					auto op = rt->render(width, height, _base_color_space);
 
 					// Push a new blend state to stack.
 					gs_blend_state_push();
@@ -373,7 +371,7 @@ void dynamic_mask_instance::video_render(gs_effect_t* in_effect)
 				}
 
 				_have_base = true;
-				_base_rt->get_texture(_base_tex);
+				_base_tex  = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 			} catch (const std::exception& ex) {
 				_self.process_filter_end(default_effect, width, height);
 				DLOG_ERROR("Failed to capture base texture: %s", ex.what());
@@ -399,63 +397,15 @@ void dynamic_mask_instance::video_render(gs_effect_t* in_effect)
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_source, "Input '%s'", input.name().data()};
 #endif
-			// Ensure the Render Target matches the expected format.
-			if (!_input_rt || (_input_rt->get_color_format() != _input_color_format)) {
-				_input_rt = std::make_shared<streamfx::obs::gs::rendertarget>(_input_color_format, GS_ZS_NONE);
-			}
-
 			auto previous_lsrgb = gs_get_linear_srgb();
 			gs_set_linear_srgb(_input_srgb);
 			bool previous_srgb = gs_framebuffer_srgb_enabled();
 			gs_enable_framebuffer_srgb(false);
 
 			try {
-				{
-					auto op = _input_rt->render(input.width(), input.height(), _input_color_space);
-
-					// Push a new blend state to stack.
-					gs_blend_state_push();
-					gs_reset_blend_state();
-					gs_enable_blending(false);
-					gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
-					try {
-						// Enable all channels.
-						gs_enable_color(true, true, true, true);
-
-						// Disable culling.
-						gs_set_cull_mode(GS_NEITHER);
-
-						// Disable depth testing.
-						gs_enable_depth_test(false);
-						gs_depth_function(GS_ALWAYS);
-
-						// Disable stencil testing
-						gs_enable_stencil_test(false);
-						gs_enable_stencil_write(false);
-						gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
-						gs_stencil_op(GS_STENCIL_BOTH, GS_KEEP, GS_KEEP, GS_KEEP);
-
-						// Set up rendering matrix.
-						gs_ortho(0, static_cast<float>(input.width()), 0, static_cast<float>(input.height()), -1., 1.);
-
-						{ // Clear to black.
-							vec4 clr = {0., 0., 0., 0.};
-							gs_clear(GS_CLEAR_COLOR, &clr, 0., 0);
-						}
-
-						// Render the source.
-						obs_source_video_render(input);
-
-						// Pop the old blend state.
-						gs_blend_state_pop();
-					} catch (...) {
-						gs_blend_state_pop();
-						throw;
-					}
-				}
-
-				_have_input = true;
-				_input_rt->get_texture(_input_tex);
+				// Other filters using the same source as their input this frame share a single capture of it.
+				_input_tex  = _captures->capture(input, input.width(), input.height(), _input_color_format, _input_color_space);
+				_have_input = (_input_tex != nullptr);
 			} catch (const std::exception& ex) {
 				DLOG_ERROR("Failed to capture input texture: %s", ex.what());
 			} catch (...) {
@@ -473,19 +423,15 @@ void dynamic_mask_instance::video_render(gs_effect_t* in_effect)
 		streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_render, "Final Calculation"};
 #endif
 
-		// Ensure the Render Target matches the expected format.
-		if (!_final_rt || (_final_rt->get_color_format() != _base_color_format)) {
-			_final_rt = std::make_shared<streamfx::obs::gs::rendertarget>(_base_color_format, GS_ZS_NONE);
-		}
-
 		bool previous_srgb  = gs_framebuffer_srgb_enabled();
 		auto previous_lsrgb = gs_get_linear_srgb();
 		gs_enable_framebuffer_srgb(_final_srgb);
 		gs_set_linear_srgb(_final_srgb);
 
 		try {
+			auto rt = _pool->acquire(width, height, _base_color_format);
 			{
-				auto op = _final_rt->render(width, height);
+				auto op = rt->render(width, height);
 
 				// Push a new blend state to stack.
 				gs_blend_state_push();
@@ -536,7 +482,7 @@ void dynamic_mask_instance::video_render(gs_effect_t* in_effect)
 				}
 			}
 
-			_final_tex  = _final_rt->get_texture();
+			_final_tex  = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 			_have_final = true;
 		} catch (const std::exception& ex) {
 			DLOG_ERROR("Failed to render final texture: %s", ex.what());
@@ -4,9 +4,11 @@
 
 #pragma once
 #include "common.hpp"
+#include "gfx/gfx-source-capture-cache.hpp"
 #include "gfx/gfx-source-texture.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/obs-source-active-child.hpp"
 #include "obs/obs-source-active-reference.hpp"
 #include "obs/obs-source-factory.hpp"
@@ -49,25 +51,26 @@ namespace streamfx::filter::dynamic_mask {
 		std::shared_ptr<streamfx::obs::source_showing_reference> _input_vs;
 		std::shared_ptr<streamfx::obs::source_active_reference>  _input_ac;
 
+		// Render Targets, borrowed until the next tick.
+		std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+		std::shared_ptr<streamfx::gfx::source_capture_cache>  _captures;
+
 		// Base texture for filtering
-		bool                                             _have_base;
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _base_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _base_tex;
-		gs_color_space                                   _base_color_space;
-		gs_color_format                                  _base_color_format;
-		bool                                             _base_srgb;
-
-		bool                                             _have_input;
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _input_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _input_tex;
-		gs_color_space                                   _input_color_space;
-		gs_color_format                                  _input_color_format;
-		bool                                             _input_srgb;
-
-		bool                                             _have_final;
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _final_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _final_tex;
-		bool                                             _final_srgb;
+		bool                                        _have_base;
+		std::shared_ptr<streamfx::obs::gs::texture> _base_tex;
+		gs_color_space                              _base_color_space;
+		gs_color_format                             _base_color_format;
+		bool                                        _base_srgb;
+
+		bool                                        _have_input;
+		std::shared_ptr<streamfx::obs::gs::texture> _input_tex;
+		gs_color_space                              _input_color_space;
+		gs_color_format                             _input_color_format;
+		bool                                        _input_srgb;
+
+		bool                                        _have_final;
+		std::shared_ptr<streamfx::obs::gs::texture> _final_tex;
+		bool                                        _final_srgb;
 
 		int64_t _debug_texture;
 
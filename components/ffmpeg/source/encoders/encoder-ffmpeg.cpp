@@ -24,6 +24,7 @@ extern "C" {
 
 #include "warning-disable.hpp"
 #include <libavcodec/avcodec.h>
+#include <libavutil/cpu.h>
 #include <libavutil/dict.h>
 #include <libavutil/frame.h>
 #include <libavutil/opt.h>
@@ -46,6 +47,9 @@ extern "C" {
 #define ST_KEY_FFMPEG_FRAMERATE "FFmpeg.Framerate"
 #define ST_I18N_FFMPEG_GPU ST_I18N_FFMPEG ".GPU"
 #define ST_KEY_FFMPEG_GPU "FFmpeg.GPU"
+#define ST_I18N_FFMPEG_SCALER ST_I18N_FFMPEG ".Scaler"
+#define ST_I18N_FFMPEG_SCALER_(x) ST_I18N_FFMPEG_SCALER "." x
+#define ST_KEY_FFMPEG_SCALER "FFmpeg.Scaler"
 
 #define ST_I18N_KEYFRAMES ST_I18N_FFMPEG ".KeyFrames"
 #define ST_I18N_KEYFRAMES_INTERVALTYPE ST_I18N_KEYFRAMES ".IntervalType"
@@ -55,6 +59,9 @@ extern "C" {
 #define ST_KEY_KEYFRAMES_INTERVAL_SECONDS "KeyFrames.Interval.Seconds"
 #define ST_KEY_KEYFRAMES_INTERVAL_FRAMES "KeyFrames.Interval.Frames"
 
+// Maximum number of frames waiting for the encode thread before OBS is blocked.
+#define ST_ENCODE_QUEUE_SIZE 8
+
 using namespace streamfx::encoder::ffmpeg;
 using namespace streamfx::encoder::codec;
 
@@ -71,9 +78,13 @@ ffmpeg_instance::ffmpeg_instance(obs_data_t* settings, obs_encoder_t* self, bool
 
 	  _hwapi(), _hwinst(),
 
-	  _lag_in_frames(0), _sent_frames(0), _have_first_frame(false), _extra_data(), _sei_data(),
+	  _framerate_divisor(1), _have_first_frame(false), _extra_data(), _sei_data(),
+
+	  _frame_pool(::streamfx::ffmpeg::avframe_pool::instance()), _free_frames_lock(), _free_frames(), _used_frames(), _free_frames_last_used(),
+
+	  _encode_thread(), _encode_lock(), _encode_cv(), _encode_stop(false), _encode_error(0), _input_frames(), _output_packets(), _free_packets(), _context_lock(),
 
-	  _free_frames(), _used_frames(), _free_frames_last_used()
+	  _wrapped_buffers(0), _copy_avoided(0), _copy_avoided_since(std::chrono::high_resolution_clock::now())
 {
 	// Initialize GPU Stuff
 	if (is_hw) {
@@ -102,10 +113,6 @@ ffmpeg_instance::ffmpeg_instance(obs_data_t* settings, obs_encoder_t* self, bool
 		throw std::runtime_error("Failed to create encoder context.");
 	}
 
-	// Allocate a small packet for later use.
-	_packet = {av_packet_alloc(), [](AVPacket* ptr) { av_packet_free(&ptr); }};
-	av_new_packet(_packet.get(), 8 * 1024 * 1024); // 8 MiB is usually enough for compressed data.
-
 	// Initialize
 	if (is_hw) {
 		initialize_hw(settings);
@@ -130,18 +137,53 @@ ffmpeg_instance::ffmpeg_instance(obs_data_t* settings, obs_encoder_t* self, bool
 	if (res < 0) {
 		throw std::runtime_error(::streamfx::ffmpeg::tools::get_error_description(res));
 	}
+
+	// Warm up the frame pool to cover everything that can be in flight at once.
+	if (!_hwinst) {
+		size_t lag = ST_ENCODE_QUEUE_SIZE + 1 + static_cast<size_t>(std::max(_context->max_b_frames, 0));
+		if ((_context->active_thread_type & FF_THREAD_FRAME) != 0) {
+			lag += static_cast<size_t>(std::max(_context->thread_count, 0));
+		}
+		_frame_pool->precache(_context->width, _context->height, _context->pix_fmt, lag);
+	}
+
+	// Start the encode thread, which from now on owns the encoder.
+	_encode_thread = std::thread([this]() { encode_thread(); });
 }
 
 ffmpeg_instance::~ffmpeg_instance()
 {
+	// The encode thread finishes all queued frames before it stops, unless the encoder failed.
+	if (_encode_thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lg(_encode_lock);
+			_encode_stop = true;
+		}
+		_encode_cv.notify_all();
+		_encode_thread.join();
+	}
+
+	// Nothing can be handed to OBS anymore, so whatever is still queued is lost.
+	std::deque<std::shared_ptr<AVFrame>> frames;
+	size_t                               packets = 0;
+	{
+		std::lock_guard<std::mutex> lg(_encode_lock);
+		frames.swap(_input_frames);
+		packets = _output_packets.size();
+		_output_packets.clear();
+	}
+	size_t discarded_frames = frames.size();
+	frames.clear(); // Wrapped frames take the lock when released.
+
 	auto gctx = streamfx::obs::gs::context();
 	if (_context) {
 		// Flush encoders that require it.
 		if ((_codec->capabilities & AV_CODEC_CAP_DELAY) != 0) {
+			std::shared_ptr<AVPacket> packet{av_packet_alloc(), [](AVPacket* ptr) { av_packet_free(&ptr); }};
 			avcodec_send_frame(_context, nullptr);
-			while (avcodec_receive_packet(_context, _packet.get()) >= 0) {
-				avcodec_send_frame(_context, nullptr);
-				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			while (avcodec_receive_packet(_context, packet.get()) >= 0) {
+				av_packet_unref(packet.get());
+				packets++;
 			}
 		}
 
@@ -149,9 +191,16 @@ ffmpeg_instance::~ffmpeg_instance()
 		avcodec_free_context(&_context);
 	}
 
-	av_packet_unref(_packet.get());
-
 	_scaler.finalize();
+
+	if ((discarded_frames > 0) || (packets > 0)) {
+		DLOG_WARNING("[%s] Discarded %zu frame(s) and %zu packet(s) that were still being encoded when the encoder was stopped.", _codec->name, discarded_frames, packets);
+	}
+
+	if (!_hwinst) {
+		auto stats = _frame_pool->get_statistics();
+		DLOG_INFO("[%s] Frame Pool: %.1f%% hit rate, %" PRIu64 " eviction(s), %zu MiB peak of %zu MiB budget", _codec->name, stats.hit_rate() * 100., stats.evictions, stats.peak_bytes >> 20, stats.budget_bytes >> 20);
+	}
 }
 
 void ffmpeg_instance::get_properties(obs_properties_t* props)
@@ -165,6 +214,7 @@ void ffmpeg_instance::get_properties(obs_properties_t* props)
 
 	obs_property_set_enabled(obs_properties_get(props, ST_KEY_FFMPEG_THREADS), false);
 	obs_property_set_enabled(obs_properties_get(props, ST_KEY_FFMPEG_GPU), false);
+	obs_property_set_enabled(obs_properties_get(props, ST_KEY_FFMPEG_SCALER), false);
 }
 
 void ffmpeg_instance::migrate(obs_data_t* settings, uint64_t version)
@@ -183,6 +233,9 @@ bool ffmpeg_instance::update(obs_data_t* settings)
 		support_reconfig = _handler->is_reconfigurable(_factory, support_reconfig_threads, support_reconfig_gpu, support_reconfig_keyframes);
 	}
 
+	// The encode thread must not use the context while it is being reconfigured.
+	std::lock_guard<std::mutex> lg(_context_lock);
+
 	if (!_context->internal) {
 		// FFmpeg Options
 		_context->debug                 = 0;
@@ -277,8 +330,17 @@ bool ffmpeg_instance::update(obs_data_t* settings)
 		} else {
 			DLOG_INFO("[%s]     Input: %" PRId32 "x%" PRId32 " %s %s %s", _codec->name, _scaler.get_source_width(), _scaler.get_source_height(), ::streamfx::ffmpeg::tools::get_pixel_format_name(_scaler.get_source_format()), ::streamfx::ffmpeg::tools::get_color_space_name(_scaler.get_source_colorspace()), _scaler.is_source_full_range() ? "Full" : "Partial");
 			DLOG_INFO("[%s]     Output: %" PRId32 "x%" PRId32 " %s %s %s", _codec->name, _scaler.get_target_width(), _scaler.get_target_height(), ::streamfx::ffmpeg::tools::get_pixel_format_name(_scaler.get_target_format()), ::streamfx::ffmpeg::tools::get_color_space_name(_scaler.get_target_colorspace()), _scaler.is_target_full_range() ? "Full" : "Partial");
-			if (!_hwinst)
+			if (_scaler.is_repacking()) {
+				DLOG_INFO("[%s]     Conversion: Repacking with %s in %zu slice(s)", _codec->name, ::streamfx::ffmpeg::repack::get_instruction_set(), _scaler.get_slice_count());
+			} else {
+				DLOG_INFO("[%s]     Conversion: Preset %" PRId64 " in %zu slice(s)", _codec->name, obs_data_get_int(settings, ST_KEY_FFMPEG_SCALER), _scaler.get_slice_count());
+			}
+			if (!_hwinst) {
+				// Only software frames come from the pool.
+				auto stats = _frame_pool->get_statistics();
+				DLOG_INFO("[%s]     Frame Pool: %.1f%% hit rate, %" PRIu64 " eviction(s), %zu MiB peak of %zu MiB budget", _codec->name, stats.hit_rate() * 100., stats.evictions, stats.peak_bytes >> 20, stats.budget_bytes >> 20);
 				DLOG_INFO("[%s]     On GPU Index: %lli", _codec->name, obs_data_get_int(settings, ST_KEY_FFMPEG_GPU));
+			}
 		}
 		DLOG_INFO("[%s]     Framerate: %" PRId32 "/%" PRId32 " (%f FPS)", _codec->name, _context->time_base.den, _context->time_base.num, static_cast<double_t>(_context->time_base.den) / static_cast<double_t>(_context->time_base.num));
 
@@ -339,7 +401,8 @@ bool ffmpeg_instance::encode_video(struct encoder_frame* frame, struct encoder_p
 		return true;
 	}
 
-	std::shared_ptr<AVFrame> vframe = pop_free_frame(); // Retrieve an empty frame.
+	bool                     wrapped = can_wrap_frame(frame);
+	std::shared_ptr<AVFrame> vframe  = wrapped ? wrap_frame(frame) : pop_free_frame(); // Retrieve an empty frame.
 
 	// Convert frame.
 	{
@@ -351,7 +414,9 @@ bool ffmpeg_instance::encode_video(struct encoder_frame* frame, struct encoder_p
 		vframe->color_trc       = _context->color_trc;
 		vframe->pts             = frame->pts;
 
-		if ((_scaler.is_source_full_range() == _scaler.is_target_full_range()) && (_scaler.get_source_colorspace() == _scaler.get_target_colorspace()) && (_scaler.get_source_format() == _scaler.get_target_format())) {
+		if (wrapped) {
+			// Encoder reads directly from the OBS frame.
+		} else if ((_scaler.is_source_full_range() == _scaler.is_target_full_range()) && (_scaler.get_source_colorspace() == _scaler.get_target_colorspace()) && (_scaler.get_source_format() == _scaler.get_target_format())) {
 			copy_data(frame, vframe.get());
 		} else {
 			int res = _scaler.convert(reinterpret_cast<uint8_t**>(frame->data), reinterpret_cast<int*>(frame->linesize), 0, _context->height, vframe->data, vframe->linesize);
@@ -365,6 +430,12 @@ bool ffmpeg_instance::encode_video(struct encoder_frame* frame, struct encoder_p
 	if (!encode_avframe(vframe, packet, received_packet))
 		return false;
 
+	if (wrapped) {
+		// OBS reuses the frame memory once we return, so the encoder must be done with it.
+		vframe.reset();
+		wait_for_wrapped_frames();
+	}
+
 	return true;
 }
 
@@ -438,7 +509,12 @@ void ffmpeg_instance::initialize_sw(obs_data_t* settings)
 	_scaler.set_target_format(pix_fmt_target);
 
 	// Create Scaler
-	if (!_scaler.initialize(SWS_SINC | SWS_FULL_CHR_H_INT | SWS_FULL_CHR_H_INP | SWS_ACCURATE_RND | SWS_BITEXACT)) {
+	if (int64_t threads = obs_data_get_int(settings, ST_KEY_FFMPEG_THREADS); threads > 0) {
+		_scaler.set_threads(static_cast<size_t>(threads));
+	} else {
+		_scaler.set_threads(std::thread::hardware_concurrency());
+	}
+	if (!_scaler.initialize(static_cast<::streamfx::ffmpeg::swscale::preset>(obs_data_get_int(settings, ST_KEY_FFMPEG_SCALER)))) {
 		std::stringstream sstr;
 		sstr << "Initializing scaler failed for conversion from '" << ::streamfx::ffmpeg::tools::get_pixel_format_name(_scaler.get_source_format()) << "' to '" << ::streamfx::ffmpeg::tools::get_pixel_format_name(_scaler.get_target_format()) << "' with color space '" << ::streamfx::ffmpeg::tools::get_color_space_name(_scaler.get_source_colorspace()) << "' and " << (_scaler.is_source_full_range() ? "full" : "partial") << " range.";
 		throw std::runtime_error(sstr.str());
@@ -482,6 +558,18 @@ void ffmpeg_instance::initialize_hw(obs_data_t*)
 
 void ffmpeg_instance::push_free_frame(std::shared_ptr<AVFrame> frame)
 {
+	if (frame->buf[0] && (av_buffer_get_opaque(frame->buf[0]) == this)) {
+		// Wrapped OBS memory must never be reused.
+		return;
+	}
+
+	if (!_hwinst) {
+		_frame_pool->push(frame);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lg(_free_frames_lock);
+
 	auto now = std::chrono::high_resolution_clock::now();
 	if (_free_frames.size() > 0) {
 		if ((now - _free_frames_last_used) < std::chrono::seconds(1)) {
@@ -495,31 +583,24 @@ void ffmpeg_instance::push_free_frame(std::shared_ptr<AVFrame> frame)
 
 std::shared_ptr<AVFrame> ffmpeg_instance::pop_free_frame()
 {
-	std::shared_ptr<AVFrame> frame;
-	if (_free_frames.size() > 0) {
-		// Re-use existing frames first.
-		frame = _free_frames.top();
-		_free_frames.pop();
-	} else {
-		if (_hwinst) {
-			frame = _hwinst->allocate_frame(_context->hw_frames_ctx);
-		} else {
-			frame = std::shared_ptr<AVFrame>(av_frame_alloc(), [](AVFrame* frame) {
-				av_frame_unref(frame);
-				av_frame_free(&frame);
-			});
-
-			frame->width  = _context->width;
-			frame->height = _context->height;
-			frame->format = _context->pix_fmt;
+	if (!_hwinst) {
+		return _frame_pool->pop(_context->width, _context->height, _context->pix_fmt);
+	}
 
-			int res = av_frame_get_buffer(frame.get(), 32);
-			if (res < 0) {
-				throw std::runtime_error(::streamfx::ffmpeg::tools::get_error_description(res));
-			}
+	std::shared_ptr<AVFrame> frame;
+	{
+		std::lock_guard<std::mutex> lg(_free_frames_lock);
+		if (_free_frames.size() > 0) {
+			// Re-use existing frames first.
+			frame = _free_frames.top();
+			_free_frames.pop();
 		}
 	}
 
+	if (!frame) {
+		frame = _hwinst->allocate_frame(_context->hw_frames_ctx);
+	}
+
 	return frame;
 }
 
@@ -535,6 +616,96 @@ std::shared_ptr<AVFrame> ffmpeg_instance::pop_used_frame()
 	return frame;
 }
 
+bool ffmpeg_instance::can_wrap_frame(struct encoder_frame* frame)
+{
+	if (_hwinst || (_scaler.is_source_full_range() != _scaler.is_target_full_range()) || (_scaler.get_source_colorspace() != _scaler.get_target_colorspace()) || (_scaler.get_source_format() != _scaler.get_target_format())) {
+		return false;
+	}
+
+	// Encoders which delay or frame-thread their work keep references to frames beyond the current call.
+	if (((_codec->capabilities & AV_CODEC_CAP_DELAY) != 0) || ((_context->active_thread_type & FF_THREAD_FRAME) != 0)) {
+		return false;
+	}
+
+	// SIMD code in the encoder may rely on FFmpeg's own alignment.
+	size_t alignment = av_cpu_max_align();
+	for (std::size_t idx = 0; idx < MAX_AV_PLANES; idx++) {
+		if (!frame->data[idx]) {
+			break;
+		}
+		if (((reinterpret_cast<uintptr_t>(frame->data[idx]) % alignment) != 0) || ((frame->linesize[idx] % alignment) != 0)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::shared_ptr<AVFrame> ffmpeg_instance::wrap_frame(struct encoder_frame* frame)
+{
+	std::shared_ptr<AVFrame> vframe = std::shared_ptr<AVFrame>(av_frame_alloc(), [](AVFrame* frame) {
+		av_frame_unref(frame);
+		av_frame_free(&frame);
+	});
+	vframe->width  = _context->width;
+	vframe->height = _context->height;
+	vframe->format = _context->pix_fmt;
+
+	int h_chroma_shift, v_chroma_shift;
+	av_pix_fmt_get_chroma_sub_sample(_context->pix_fmt, &h_chroma_shift, &v_chroma_shift);
+
+	for (std::size_t idx = 0; (idx < MAX_AV_PLANES) && (idx < AV_NUM_DATA_POINTERS); idx++) {
+		if (!frame->data[idx]) {
+			break;
+		}
+
+		std::size_t plane_height = static_cast<size_t>(vframe->height) >> (idx ? v_chroma_shift : 0);
+		std::size_t plane_size   = static_cast<size_t>(frame->linesize[idx]) * plane_height;
+
+		vframe->buf[idx] = av_buffer_create(
+			frame->data[idx], plane_size,
+			[](void* opaque, uint8_t*) {
+				auto self = reinterpret_cast<ffmpeg_instance*>(opaque);
+				{
+					std::lock_guard<std::mutex> lg(self->_encode_lock);
+					self->_wrapped_buffers--;
+				}
+				self->_encode_cv.notify_all();
+			},
+			this, AV_BUFFER_FLAG_READONLY);
+		if (!vframe->buf[idx]) {
+			throw std::bad_alloc();
+		}
+		{
+			std::lock_guard<std::mutex> lg(_encode_lock);
+			_wrapped_buffers++;
+		}
+
+		vframe->data[idx]     = frame->data[idx];
+		vframe->linesize[idx] = static_cast<int>(frame->linesize[idx]);
+		_copy_avoided += plane_size;
+	}
+
+	return vframe;
+}
+
+void ffmpeg_instance::wait_for_wrapped_frames()
+{
+	{
+		std::unique_lock<std::mutex> ul(_encode_lock);
+		_encode_cv.wait(ul, [this]() { return (_wrapped_buffers == 0) || (_encode_error != 0); });
+	}
+
+	// Report how much copying was avoided.
+	auto now     = std::chrono::high_resolution_clock::now();
+	auto elapsed = std::chrono::duration_cast<std::chrono::duration<double_t>>(now - _copy_avoided_since);
+	if (elapsed >= std::chrono::seconds(60)) {
+		DLOG_INFO("[%s] Zero copy avoided copying %.2f MiB/s.", _codec->name, (static_cast<double_t>(_copy_avoided) / elapsed.count()) / 1048576.);
+		_copy_avoided       = 0;
+		_copy_avoided_since = now;
+	}
+}
+
 bool ffmpeg_instance::get_extra_data(uint8_t** data, size_t* size)
 {
 	if (!_have_first_frame)
@@ -563,20 +734,50 @@ void ffmpeg_instance::get_video_info(struct video_scale_info* info)
 	}
 }
 
-int ffmpeg_instance::receive_packet(bool* received_packet, struct encoder_packet* packet)
+int ffmpeg_instance::receive_packet()
 {
-	int res = 0;
-
-	av_packet_unref(_packet.get());
+	std::shared_ptr<AVPacket> packet;
+	{
+		std::lock_guard<std::mutex> lg(_encode_lock);
+		if (_free_packets.size() > 0) {
+			packet = _free_packets.top();
+			_free_packets.pop();
+		}
+	}
+	if (!packet) {
+		packet = {av_packet_alloc(), [](AVPacket* ptr) { av_packet_free(&ptr); }};
+	}
 
+	int res = 0;
 	{
-		auto gctx = streamfx::obs::gs::context();
-		res       = avcodec_receive_packet(_context, _packet.get());
+		// Only hardware encoders share resources with libobs.
+		std::unique_ptr<streamfx::obs::gs::context> gctx;
+		if (_hwinst) {
+			gctx = std::make_unique<streamfx::obs::gs::context>();
+		}
+		res = avcodec_receive_packet(_context, packet.get());
 	}
 	if (res != 0) {
+		std::lock_guard<std::mutex> lg(_encode_lock);
+		_free_packets.push(packet);
 		return res;
 	}
 
+	// Push free frame back into pool.
+	if (_used_frames.size() > 0) {
+		push_free_frame(pop_used_frame());
+	}
+
+	{
+		std::lock_guard<std::mutex> lg(_encode_lock);
+		_output_packets.push_back(packet);
+	}
+
+	return res;
+}
+
+void ffmpeg_instance::process_packet(struct encoder_packet* packet, bool* received_packet)
+{
 	if (!_have_first_frame) {
 		if (_codec->id == AV_CODEC_ID_H264) {
 			uint8_t*    tmp_packet;
@@ -674,21 +875,21 @@ int ffmpeg_instance::receive_packet(bool* received_packet, struct encoder_packet
 			}
 		}
 	}
-
-	// Push free frame back into pool.
-	push_free_frame(pop_used_frame());
-
-	return res;
 }
 
 int ffmpeg_instance::send_frame(std::shared_ptr<AVFrame> const frame)
 {
 	int res = 0;
 	{
-		auto gctx = streamfx::obs::gs::context();
-		res       = avcodec_send_frame(_context, frame.get());
+		// Only hardware encoders share resources with libobs.
+		std::unique_ptr<streamfx::obs::gs::context> gctx;
+		if (_hwinst) {
+			gctx = std::make_unique<streamfx::obs::gs::context>();
+		}
+		res = avcodec_send_frame(_context, frame.get());
 	}
-	if (res == 0) {
+	if ((res == 0) && !(frame->buf[0] && (av_buffer_get_opaque(frame->buf[0]) == this))) {
+		// Wrapped frames are held by the encoder itself, and released as soon as it is done with them.
 		push_used_frame(frame);
 	}
 
@@ -697,76 +898,96 @@ int ffmpeg_instance::send_frame(std::shared_ptr<AVFrame> const frame)
 
 bool ffmpeg_instance::encode_avframe(std::shared_ptr<AVFrame> frame, encoder_packet* packet, bool* received_packet)
 {
-	bool sent_frame  = false;
-	bool recv_packet = false;
-	bool should_lag  = (_sent_frames >= _lag_in_frames);
-
-	auto loop_begin = std::chrono::high_resolution_clock::now();
-	auto loop_end   = loop_begin + std::chrono::milliseconds(50);
-
-	while ((!sent_frame || (should_lag && !recv_packet)) && !(std::chrono::high_resolution_clock::now() > loop_end)) {
-		bool eagain_is_stupid = false;
-
-		if (!sent_frame) {
-			int res = send_frame(frame);
-			switch (res) {
-			case 0:
-				sent_frame = true;
-				frame      = nullptr;
-				break;
-			case AVERROR(EAGAIN):
-				// This means we should call receive_packet again, but what do we do with that data?
-				// Why can't we queue on both? Do I really have to implement threading for this stuff?
-				if (*received_packet == true) {
-					DLOG_WARNING("Skipped frame due to EAGAIN when a packet was already returned.");
-					sent_frame = true;
+	std::unique_lock<std::mutex> ul(_encode_lock);
+
+	// The packet handed to OBS last time is no longer in use.
+	if (_packet) {
+		av_packet_unref(_packet.get());
+		_free_packets.push(_packet);
+		_packet.reset();
+	}
+
+	// Queue the frame, waiting for the encode thread if it has fallen too far behind.
+	_encode_cv.wait(ul, [this]() { return (_input_frames.size() < ST_ENCODE_QUEUE_SIZE) || (_encode_error != 0); });
+	if (_encode_error != 0) {
+		DLOG_ERROR("Failed to encode frame: %s (%" PRId32 ").", ::streamfx::ffmpeg::tools::get_error_description(_encode_error), _encode_error);
+		ul.unlock();
+		push_free_frame(frame);
+		return false;
+	}
+	_input_frames.push_back(frame);
+	_encode_cv.notify_all();
+
+	// Hand out a finished packet, if there is one.
+	if (_output_packets.size() > 0) {
+		_packet = _output_packets.front();
+		_output_packets.pop_front();
+		ul.unlock();
+
+		process_packet(packet, received_packet);
+	}
+
+	return true;
+}
+
+void ffmpeg_instance::encode_thread()
+{
+	std::unique_lock<std::mutex> ul(_encode_lock);
+	while (true) {
+		_encode_cv.wait(ul, [this]() { return _encode_stop || (_input_frames.size() > 0); });
+		if (_input_frames.empty()) {
+			// Only stop once every queued frame was handed to the encoder.
+			break;
+		}
+
+		auto frame = _input_frames.front();
+		_input_frames.pop_front();
+		_encode_cv.notify_all();
+		ul.unlock();
+
+		int res = 0;
+		{
+			std::lock_guard<std::mutex> lg(_context_lock);
+
+			// Send the frame, draining finished packets whenever the encoder asks for it.
+			while ((res = send_frame(frame)) == AVERROR(EAGAIN)) {
+				if (int rres = receive_packet(); rres != 0) {
+					if (rres == AVERROR(EAGAIN)) {
+						DLOG_ERROR("Both send and receive returned EAGAIN, encoder is broken.");
+					}
+					res = rres;
+					break;
 				}
-				eagain_is_stupid = true;
-				break;
-			case AVERROR(EOF):
+			}
+			if (res != 0) {
+				push_free_frame(frame);
+			}
+			if (res == AVERROR(EOF)) {
 				DLOG_ERROR("Skipped frame due to end of stream.");
-				sent_frame = true;
-				break;
-			default:
-				DLOG_ERROR("Failed to encode frame: %s (%" PRId32 ").", ::streamfx::ffmpeg::tools::get_error_description(res), res);
-				return false;
+				res = 0;
 			}
-		}
 
-		if (!recv_packet) {
-			int res = receive_packet(received_packet, packet);
-			switch (res) {
-			case 0:
-				recv_packet = true;
-				break;
-			case AVERROR(EOF):
-				DLOG_ERROR("Received end of file.");
-				recv_packet = true;
-				break;
-			case AVERROR(EAGAIN):
-				if (sent_frame) {
-					recv_packet = true;
-				}
-				if (eagain_is_stupid) {
-					DLOG_ERROR("Both send and recieve returned EAGAIN, encoder is broken.");
-					return false;
+			// Collect everything the encoder has finished so far.
+			while (res == 0) {
+				if (int rres = receive_packet(); rres != 0) {
+					if ((rres != AVERROR(EAGAIN)) && (rres != AVERROR(EOF))) {
+						res = rres;
+					}
+					break;
 				}
-				break;
-			default:
-				DLOG_ERROR("Failed to receive packet: %s (%" PRId32 ").", ::streamfx::ffmpeg::tools::get_error_description(res), res);
-				return false;
 			}
 		}
 
-		if (!sent_frame || !recv_packet) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		// Wrapped frames release their buffers with the lock held, so the last reference must be gone before locking.
+		frame.reset();
+
+		ul.lock();
+		if (res != 0) {
+			_encode_error = res;
+			_encode_cv.notify_all();
+			break;
 		}
 	}
-
-	if (!sent_frame)
-		push_free_frame(frame);
-
-	return true;
 }
 
 bool ffmpeg_instance::is_hardware_encode()
@@ -1001,6 +1222,7 @@ void ffmpeg_factory::get_defaults2(obs_data_t* settings)
 		obs_data_set_default_string(settings, ST_KEY_FFMPEG_CUSTOMSETTINGS, "");
 		obs_data_set_default_int(settings, ST_KEY_FFMPEG_THREADS, 0);
 		obs_data_set_default_int(settings, ST_KEY_FFMPEG_GPU, -1);
+		obs_data_set_default_int(settings, ST_KEY_FFMPEG_SCALER, static_cast<int64_t>(::streamfx::ffmpeg::swscale::preset::QUALITY));
 	}
 }
 
@@ -1085,6 +1307,13 @@ obs_properties_t* ffmpeg_factory::get_properties2(instance_t* data)
 			auto p = obs_properties_add_int_slider(grp, ST_KEY_FFMPEG_THREADS, D_TRANSLATE(ST_I18N_FFMPEG_THREADS), 0, static_cast<int64_t>(std::thread::hardware_concurrency()) * 2, 1);
 		}
 
+		{ // Color Conversion
+			auto p = obs_properties_add_list(grp, ST_KEY_FFMPEG_SCALER, D_TRANSLATE(ST_I18N_FFMPEG_SCALER), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+			obs_property_list_add_int(p, D_TRANSLATE(ST_I18N_FFMPEG_SCALER_("Fast")), static_cast<int64_t>(::streamfx::ffmpeg::swscale::preset::FAST));
+			obs_property_list_add_int(p, D_TRANSLATE(ST_I18N_FFMPEG_SCALER_("Balanced")), static_cast<int64_t>(::streamfx::ffmpeg::swscale::preset::BALANCED));
+			obs_property_list_add_int(p, D_TRANSLATE(ST_I18N_FFMPEG_SCALER_("Quality")), static_cast<int64_t>(::streamfx::ffmpeg::swscale::preset::QUALITY));
+		}
+
 		{ // Frame Skipping
 			obs_video_info ovi;
 			if (!obs_get_video_info(&ovi)) {
@@ -6,6 +6,7 @@
 #pragma once
 #include "common.hpp"
 #include "encoders/ffmpeg/handler.hpp"
+#include "ffmpeg/avframe-pool.hpp"
 #include "ffmpeg/avframe-queue.hpp"
 #include "ffmpeg/hwapi/base.hpp"
 #include "ffmpeg/swscale.hpp"
@@ -13,6 +14,7 @@
 
 #include "warning-disable.hpp"
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -45,8 +47,6 @@ namespace streamfx::encoder::ffmpeg {
 		std::shared_ptr<::streamfx::ffmpeg::hwapi::base>     _hwapi;
 		std::shared_ptr<::streamfx::ffmpeg::hwapi::instance> _hwinst;
 
-		std::size_t _lag_in_frames;
-		std::size_t _sent_frames;
 		std::size_t _framerate_divisor;
 
 		// Extra Data
@@ -55,9 +55,27 @@ namespace streamfx::encoder::ffmpeg {
 		std::vector<uint8_t> _sei_data;
 
 		// Frame Stack and Queue
-		std::stack<std::shared_ptr<AVFrame>>           _free_frames;
-		std::queue<std::shared_ptr<AVFrame>>           _used_frames;
-		std::chrono::high_resolution_clock::time_point _free_frames_last_used;
+		std::shared_ptr<::streamfx::ffmpeg::avframe_pool> _frame_pool;
+		std::mutex                                        _free_frames_lock; // Hardware frames only, software frames come from the pool.
+		std::stack<std::shared_ptr<AVFrame>>              _free_frames;
+		std::queue<std::shared_ptr<AVFrame>>              _used_frames;
+		std::chrono::high_resolution_clock::time_point    _free_frames_last_used;
+
+		// Encode Thread
+		std::thread                           _encode_thread;
+		std::mutex                            _encode_lock;
+		std::condition_variable               _encode_cv;
+		bool                                  _encode_stop;
+		int                                   _encode_error;
+		std::deque<std::shared_ptr<AVFrame>>  _input_frames;
+		std::deque<std::shared_ptr<AVPacket>> _output_packets;
+		std::stack<std::shared_ptr<AVPacket>> _free_packets;
+		std::mutex                            _context_lock;
+
+		// Zero Copy
+		std::size_t                                    _wrapped_buffers;
+		uint64_t                                       _copy_avoided;
+		std::chrono::high_resolution_clock::time_point _copy_avoided_since;
 
 		public:
 		ffmpeg_instance(obs_data_t* settings, obs_encoder_t* self, bool is_hw);
@@ -92,12 +110,28 @@ namespace streamfx::encoder::ffmpeg {
 		void                     push_used_frame(std::shared_ptr<AVFrame> frame);
 		std::shared_ptr<AVFrame> pop_used_frame();
 
-		int receive_packet(bool* received_packet, struct encoder_packet* packet);
+		/** Check if the memory of an OBS frame can be handed to the encoder without copying it.
+		 *
+		 * OBS reuses the memory once encode_video returns, so this requires an encoder which does not hold
+		 * on to frames, in addition to matching formats and sufficient alignment.
+		 */
+		bool                     can_wrap_frame(struct encoder_frame* frame);
+		std::shared_ptr<AVFrame> wrap_frame(struct encoder_frame* frame);
+		void                     wait_for_wrapped_frames();
+
+		int receive_packet();
 
 		int send_frame(std::shared_ptr<AVFrame> frame);
 
+		void process_packet(struct encoder_packet* packet, bool* received_packet);
+
+		/** Queue a frame for the encode thread and return a finished packet, if there is one.
+		 */
 		bool encode_avframe(std::shared_ptr<AVFrame> frame, struct encoder_packet* packet, bool* received_packet);
 
+		private:
+		void encode_thread();
+
 		public: // Handler API
 		bool is_hardware_encode();
 
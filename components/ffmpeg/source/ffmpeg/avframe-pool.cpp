@@ -0,0 +1,200 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "avframe-pool.hpp"
+#include "configuration.hpp"
+#include "tools.hpp"
+#include "util/util-logging.hpp"
+
+#ifdef _DEBUG
+#define ST_PREFIX "<%s> "
+#define D_LOG_ERROR(x, ...) P_LOG_ERROR(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_WARNING(x, ...) P_LOG_WARN(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_INFO(x, ...) P_LOG_INFO(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_DEBUG(x, ...) P_LOG_DEBUG(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#else
+#define ST_PREFIX "<ffmpeg::avframe_pool> "
+#define D_LOG_ERROR(...) P_LOG_ERROR(ST_PREFIX __VA_ARGS__)
+#define D_LOG_WARNING(...) P_LOG_WARN(ST_PREFIX __VA_ARGS__)
+#define D_LOG_INFO(...) P_LOG_INFO(ST_PREFIX __VA_ARGS__)
+#define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
+#endif
+
+#define ST_CFG_BUDGET "ffmpeg.frame_pool.budget"
+
+// In MiB, enough to keep a few 4K encoders with deep lookahead supplied.
+#define ST_DEFAULT_BUDGET 2048
+
+using namespace streamfx::ffmpeg;
+
+double_t avframe_pool::statistics::hit_rate() const
+{
+	uint64_t total = hits + misses;
+	return (total > 0) ? (static_cast<double_t>(hits) / static_cast<double_t>(total)) : 0.;
+}
+
+void avframe_pool::deleter::operator()(AVFrame* frame)
+{
+	if (auto self = pool.lock(); self) {
+		self->_allocated_bytes -= bytes;
+	}
+	av_frame_unref(frame);
+	av_frame_free(&frame);
+}
+
+avframe_pool::avframe_pool() : _lock(), _buckets(), _age(0), _budget(size_t(ST_DEFAULT_BUDGET) << 20), _idle_bytes(0), _allocated_bytes(0), _peak_bytes(0), _hits(0), _misses(0), _evictions(0)
+{
+	if (auto config = streamfx::configuration::instance(); config) {
+		auto data = config->get();
+		if (obs_data_has_user_value(data.get(), ST_CFG_BUDGET)) {
+			_budget = static_cast<size_t>(std::max<long long>(obs_data_get_int(data.get(), ST_CFG_BUDGET), 0)) << 20;
+		}
+	}
+	D_LOG_DEBUG("Idle frames may use up to %zu MiB of memory.", _budget >> 20);
+}
+
+avframe_pool::~avframe_pool()
+{
+	D_LOG_DEBUG("Served %" PRIu64 " of %" PRIu64 " request(s) from the pool, with %zu MiB peak usage and %" PRIu64 " eviction(s).", _hits, _hits + _misses, _peak_bytes >> 20, _evictions);
+}
+
+std::shared_ptr<AVFrame> avframe_pool::create_frame(int32_t width, int32_t height, AVPixelFormat format)
+{
+	AVFrame* frame = av_frame_alloc();
+	if (!frame) {
+		throw std::bad_alloc();
+	}
+
+	frame->width  = width;
+	frame->height = height;
+	frame->format = format;
+	if (int res = av_frame_get_buffer(frame, 32); res < 0) {
+		av_frame_free(&frame);
+		throw std::runtime_error(tools::get_error_description(res));
+	}
+
+	size_t bytes = 0;
+	for (size_t idx = 0; (idx < AV_NUM_DATA_POINTERS) && frame->buf[idx]; idx++) {
+		bytes += frame->buf[idx]->size;
+	}
+
+	size_t allocated = (_allocated_bytes += bytes);
+	{
+		std::lock_guard<std::mutex> lg(_lock);
+		_peak_bytes = std::max(_peak_bytes, allocated);
+	}
+
+	return std::shared_ptr<AVFrame>(frame, deleter{weak_from_this(), bytes});
+}
+
+bool avframe_pool::make_room(size_t bytes)
+{
+	if (bytes > _budget) {
+		return false;
+	}
+
+	while ((_idle_bytes + bytes) > _budget) {
+		// Find the bucket holding the oldest idle frame.
+		auto oldest = _buckets.end();
+		for (auto kv = _buckets.begin(); kv != _buckets.end(); kv++) {
+			if (!kv->second.empty() && ((oldest == _buckets.end()) || (kv->second.front().age < oldest->second.front().age))) {
+				oldest = kv;
+			}
+		}
+		if (oldest == _buckets.end()) {
+			return false;
+		}
+
+		_idle_bytes -= oldest->second.front().bytes;
+		oldest->second.pop_front();
+		if (oldest->second.empty()) {
+			_buckets.erase(oldest);
+		}
+		_evictions++;
+	}
+	return true;
+}
+
+std::shared_ptr<AVFrame> avframe_pool::pop(int32_t width, int32_t height, AVPixelFormat format)
+{
+	{
+		std::lock_guard<std::mutex> lg(_lock);
+		if (auto kv = _buckets.find(key_t{width, height, format}); kv != _buckets.end()) {
+			// Reuse the most recently returned frame, as it is the most likely to still be in cache.
+			auto frame = kv->second.back().frame;
+			_idle_bytes -= kv->second.back().bytes;
+			kv->second.pop_back();
+			if (kv->second.empty()) {
+				_buckets.erase(kv);
+			}
+			_hits++;
+			return frame;
+		}
+		_misses++;
+	}
+
+	return create_frame(width, height, format);
+}
+
+void avframe_pool::push(std::shared_ptr<AVFrame> frame)
+{
+	auto info = std::get_deleter<deleter>(frame);
+	if (!info) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lg(_lock);
+	if (!make_room(info->bytes)) {
+		// Larger than the entire budget, let it be freed.
+		_evictions++;
+		return;
+	}
+
+	_buckets[key_t{frame->width, frame->height, static_cast<AVPixelFormat>(frame->format)}].push_back({frame, info->bytes, _age++});
+	_idle_bytes += info->bytes;
+}
+
+void avframe_pool::precache(int32_t width, int32_t height, AVPixelFormat format, size_t count)
+{
+	size_t idle = 0;
+	{
+		std::lock_guard<std::mutex> lg(_lock);
+		if (auto kv = _buckets.find(key_t{width, height, format}); kv != _buckets.end()) {
+			idle = kv->second.size();
+		}
+	}
+
+	for (; idle < count; idle++) {
+		auto frame = create_frame(width, height, format);
+		auto bytes = std::get_deleter<deleter>(frame)->bytes;
+
+		std::lock_guard<std::mutex> lg(_lock);
+		if ((_idle_bytes + bytes) > _budget) {
+			// Warming up must never evict frames someone else is about to use.
+			break;
+		}
+		_buckets[key_t{width, height, format}].push_back({frame, bytes, _age++});
+		_idle_bytes += bytes;
+	}
+}
+
+avframe_pool::statistics avframe_pool::get_statistics()
+{
+	std::lock_guard<std::mutex> lg(_lock);
+	return statistics{_hits, _misses, _evictions, _idle_bytes, _allocated_bytes.load(), _peak_bytes, _budget};
+}
+
+std::shared_ptr<avframe_pool> avframe_pool::instance()
+{
+	static std::weak_ptr<avframe_pool> winst;
+	static std::mutex                  mtx;
+
+	std::unique_lock<decltype(mtx)> lock(mtx);
+	auto                            instance = winst.lock();
+	if (!instance) {
+		instance = std::shared_ptr<avframe_pool>(new avframe_pool());
+		winst    = instance;
+	}
+	return instance;
+}
@@ -0,0 +1,103 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+
+#include "warning-disable.hpp"
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include "warning-enable.hpp"
+
+extern "C" {
+#include "warning-disable.hpp"
+#include <libavutil/frame.h>
+#include "warning-enable.hpp"
+}
+
+namespace streamfx::ffmpeg {
+	/** Pool of software frames shared by all encoders.
+	 *
+	 * Idle frames are kept in buckets by resolution and format, and never take up more memory than the
+	 * budget allows. Once the budget is exceeded, the least recently returned frames are evicted first,
+	 * regardless of which bucket they are in.
+	 */
+	class avframe_pool : public std::enable_shared_from_this<avframe_pool> {
+		public:
+		struct statistics {
+			uint64_t hits;
+			uint64_t misses;
+			uint64_t evictions;
+			size_t   idle_bytes;
+			size_t   allocated_bytes;
+			size_t   peak_bytes;
+			size_t   budget_bytes;
+
+			double_t hit_rate() const;
+		};
+
+		private:
+		typedef std::tuple<int32_t, int32_t, AVPixelFormat> key_t;
+
+		// Identifies frames created by the pool and keeps track of their memory.
+		struct deleter {
+			std::weak_ptr<avframe_pool> pool;
+			size_t                      bytes;
+
+			void operator()(AVFrame* frame);
+		};
+
+		struct entry {
+			std::shared_ptr<AVFrame> frame;
+			size_t                   bytes;
+			uint64_t                 age;
+		};
+
+		std::mutex                         _lock;
+		std::map<key_t, std::list<entry>> _buckets; // Most recently returned frames are at the back.
+		uint64_t                           _age;
+
+		size_t              _budget;
+		size_t              _idle_bytes;
+		std::atomic<size_t> _allocated_bytes; // Frames may be released without returning to the pool.
+		size_t              _peak_bytes;
+		uint64_t            _hits;
+		uint64_t            _misses;
+		uint64_t            _evictions;
+
+		private:
+		avframe_pool();
+
+		std::shared_ptr<AVFrame> create_frame(int32_t width, int32_t height, AVPixelFormat format);
+
+		/** Evict idle frames until 'bytes' more would fit into the budget. Must be called with the lock held.
+		 *
+		 * @return false if 'bytes' does not fit even with the pool empty.
+		 */
+		bool make_room(size_t bytes);
+
+		public:
+		~avframe_pool();
+
+		/** Retrieve a frame, reusing an idle one if possible.
+		 */
+		std::shared_ptr<AVFrame> pop(int32_t width, int32_t height, AVPixelFormat format);
+
+		/** Return a frame that is no longer in use. Frames not created by the pool are ignored.
+		 */
+		void push(std::shared_ptr<AVFrame> frame);
+
+		/** Allocate frames ahead of time, until 'count' are idle or the budget is reached.
+		 */
+		void precache(int32_t width, int32_t height, AVPixelFormat format, size_t count);
+
+		statistics get_statistics();
+
+		public /* Singleton */:
+		static std::shared_ptr<avframe_pool> instance();
+	};
+} // namespace streamfx::ffmpeg
@@ -0,0 +1,220 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "common.hpp"
+#include "avframe-queue.hpp"
+#include "plugin.hpp"
+#include "repack.hpp"
+#include "swscale.hpp"
+#include "tools.hpp"
+#include "util/util-benchmark.hpp"
+
+#include "warning-disable.hpp"
+#include <random>
+#include "warning-enable.hpp"
+
+extern "C" {
+#include "warning-disable.hpp"
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/opt.h>
+#include <libavutil/pixdesc.h>
+#include "warning-enable.hpp"
+}
+
+namespace {
+	constexpr std::pair<int32_t, int32_t> resolutions[]       = {{1280, 720}, {1920, 1080}};
+	constexpr std::pair<int32_t, int32_t> scale_resolutions[] = {{1920, 1080}, {3840, 2160}};
+
+	constexpr std::pair<AVPixelFormat, AVPixelFormat> repack_formats[] = {
+		{AV_PIX_FMT_NV12, AV_PIX_FMT_YUV420P}, {AV_PIX_FMT_YUV420P, AV_PIX_FMT_NV12}, {AV_PIX_FMT_P010, AV_PIX_FMT_YUV420P10}, {AV_PIX_FMT_YUV420P10, AV_PIX_FMT_P010}, {AV_PIX_FMT_P010, AV_PIX_FMT_P016},
+	};
+
+	std::string make_name(std::string_view prefix, std::pair<int32_t, int32_t> resolution)
+	{
+		return std::string{prefix} + "." + std::to_string(resolution.first) + "x" + std::to_string(resolution.second);
+	}
+
+	std::shared_ptr<streamfx::ffmpeg::avframe_queue> make_queue(std::pair<int32_t, int32_t> resolution, AVPixelFormat format, size_t count)
+	{
+		auto queue = std::make_shared<streamfx::ffmpeg::avframe_queue>();
+		queue->set_resolution(resolution.first, resolution.second);
+		queue->set_pixel_format(format);
+		queue->precache(count);
+		return queue;
+	}
+
+	void fill_frame(AVFrame* frame)
+	{
+		for (size_t plane = 0; (plane < AV_NUM_DATA_POINTERS) && frame->data[plane]; plane++) {
+			int32_t height = (plane == 0) ? frame->height : (frame->height + 1) / 2;
+			memset(frame->data[plane], 0x80, static_cast<size_t>(frame->linesize[plane]) * static_cast<size_t>(height));
+		}
+	}
+
+	int32_t plane_height(AVFrame* frame, size_t plane)
+	{
+		const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
+		return ((plane == 0) || (plane == 3)) ? frame->height : -((-frame->height) >> desc->log2_chroma_h);
+	}
+
+	void fill_noise(AVFrame* frame)
+	{
+		// Only produce values that are valid for the format, as the unused bits are not preserved by conversions.
+		const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
+		std::mt19937              generator(static_cast<uint32_t>(frame->width * frame->height));
+		for (size_t plane = 0; (plane < AV_NUM_DATA_POINTERS) && frame->data[plane]; plane++) {
+			for (int32_t row = 0, rows = plane_height(frame, plane); row < rows; row++) {
+				uint8_t* data = frame->data[plane] + static_cast<ptrdiff_t>(row) * frame->linesize[plane];
+				if (desc->comp[0].depth > 8) {
+					auto mask = static_cast<uint16_t>(((1 << desc->comp[0].depth) - 1) << desc->comp[0].shift);
+					for (int32_t idx = 0; idx < (frame->linesize[plane] / 2); idx++) {
+						reinterpret_cast<uint16_t*>(data)[idx] = static_cast<uint16_t>(generator()) & mask;
+					}
+				} else {
+					for (int32_t idx = 0; idx < frame->linesize[plane]; idx++) {
+						data[idx] = static_cast<uint8_t>(generator());
+					}
+				}
+			}
+		}
+	}
+
+	std::shared_ptr<streamfx::ffmpeg::swscale> make_scaler(std::pair<int32_t, int32_t> resolution, AVPixelFormat source, AVPixelFormat target, streamfx::ffmpeg::swscale::preset preset, size_t threads, bool repack)
+	{
+		auto scaler = std::make_shared<streamfx::ffmpeg::swscale>();
+		scaler->set_source_size(static_cast<uint32_t>(resolution.first), static_cast<uint32_t>(resolution.second));
+		scaler->set_source_format(source);
+		scaler->set_source_color(false, AVCOL_SPC_BT709);
+		scaler->set_target_size(static_cast<uint32_t>(resolution.first), static_cast<uint32_t>(resolution.second));
+		scaler->set_target_format(target);
+		scaler->set_target_color(false, AVCOL_SPC_BT709);
+		scaler->set_threads(threads);
+		scaler->set_repack(repack);
+		if (!scaler->initialize(preset)) {
+			throw std::runtime_error("Failed to initialize scaler.");
+		}
+		return scaler;
+	}
+
+	streamfx::util::benchmark::function_t setup_swscale(std::pair<int32_t, int32_t> resolution, streamfx::ffmpeg::swscale::preset preset, size_t threads)
+	{
+		auto scaler = make_scaler(resolution, AV_PIX_FMT_NV12, AV_PIX_FMT_YUV420P10, preset, threads, false);
+		auto source = make_queue(resolution, AV_PIX_FMT_NV12, 1)->pop();
+		auto target = make_queue(resolution, AV_PIX_FMT_YUV420P10, 1)->pop();
+		fill_frame(source.get());
+		return [scaler, source, target]() { scaler->convert(source->data, source->linesize, 0, source->height, target->data, target->linesize); };
+	}
+
+	streamfx::util::benchmark::function_t setup_repack(std::pair<int32_t, int32_t> resolution, std::pair<AVPixelFormat, AVPixelFormat> formats, bool repack)
+	{
+		auto scaler = make_scaler(resolution, formats.first, formats.second, streamfx::ffmpeg::swscale::preset::QUALITY, 1, repack);
+		auto source = make_queue(resolution, formats.first, 1)->pop();
+		auto target = make_queue(resolution, formats.second, 1)->pop();
+		fill_noise(source.get());
+
+		if (repack) {
+			if (!scaler->is_repacking()) {
+				throw std::runtime_error("No repacking conversion for these formats.");
+			}
+
+			// The output must be identical to what swscale produces, including odd rows and columns.
+			auto reference = make_scaler(resolution, formats.first, formats.second, streamfx::ffmpeg::swscale::preset::QUALITY, 1, false);
+			auto expected  = make_queue(resolution, formats.second, 1)->pop();
+			reference->convert(source->data, source->linesize, 0, source->height, expected->data, expected->linesize);
+			scaler->convert(source->data, source->linesize, 0, source->height, target->data, target->linesize);
+			for (size_t plane = 0; (plane < AV_NUM_DATA_POINTERS) && target->data[plane]; plane++) {
+				auto bytes = static_cast<size_t>(av_image_get_linesize(formats.second, target->width, static_cast<int>(plane)));
+				for (int32_t row = 0, rows = plane_height(target.get(), plane); row < rows; row++) {
+					if (memcmp(target->data[plane] + static_cast<ptrdiff_t>(row) * target->linesize[plane], expected->data[plane] + static_cast<ptrdiff_t>(row) * expected->linesize[plane], bytes) != 0) {
+						throw std::runtime_error("Output differs from swscale in plane " + std::to_string(plane) + ", row " + std::to_string(row) + ".");
+					}
+				}
+			}
+		}
+
+		return [scaler, source, target]() { scaler->convert(source->data, source->linesize, 0, source->height, target->data, target->linesize); };
+	}
+
+	streamfx::util::benchmark::function_t setup_encode(std::string_view codec_name, std::pair<int32_t, int32_t> resolution)
+	{
+		const AVCodec* codec = avcodec_find_encoder_by_name(codec_name.data());
+		if (!codec) {
+			throw std::runtime_error("Encoder is not available.");
+		}
+
+		auto context = std::shared_ptr<AVCodecContext>(avcodec_alloc_context3(codec), [](AVCodecContext* context) { avcodec_free_context(&context); });
+		context->width        = resolution.first;
+		context->height       = resolution.second;
+		context->pix_fmt      = AV_PIX_FMT_YUV420P;
+		context->time_base    = {1, 60};
+		context->framerate    = {60, 1};
+		context->gop_size     = 120;
+		context->max_b_frames = 0;
+		context->thread_count = 0;
+		context->color_range  = AVCOL_RANGE_MPEG;
+		context->colorspace   = AVCOL_SPC_BT709;
+		if (streamfx::ffmpeg::tools::avoption_exists(context->priv_data, "preset")) {
+			av_opt_set(context->priv_data, "preset", "veryfast", 0);
+		}
+		if (int res = avcodec_open2(context.get(), codec, nullptr); res < 0) {
+			throw std::runtime_error(streamfx::ffmpeg::tools::get_error_description(res));
+		}
+
+		auto queue  = make_queue(resolution, context->pix_fmt, 1);
+		auto frame  = queue->pop();
+		auto packet = std::shared_ptr<AVPacket>(av_packet_alloc(), [](AVPacket* packet) { av_packet_free(&packet); });
+		fill_frame(frame.get());
+
+		return [context, queue, frame, packet, pts = int64_t(0)]() mutable {
+			frame->pts = pts++;
+			if (int res = avcodec_send_frame(context.get(), frame.get()); res < 0) {
+				throw std::runtime_error(streamfx::ffmpeg::tools::get_error_description(res));
+			}
+			while (avcodec_receive_packet(context.get(), packet.get()) >= 0) {
+				av_packet_unref(packet.get());
+			}
+		};
+	}
+} // namespace
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		for (auto resolution : resolutions) {
+			streamfx::util::benchmark::add(make_name("ffmpeg.avframe_queue", resolution), 1000, [resolution]() -> streamfx::util::benchmark::function_t {
+				auto queue = make_queue(resolution, AV_PIX_FMT_NV12, 4);
+				return [queue]() {
+					auto frame = queue->pop();
+					queue->push(frame);
+				};
+			});
+
+			for (auto codec : {"libx264", "ffv1"}) {
+				streamfx::util::benchmark::add(make_name(std::string("ffmpeg.encode.") + codec, resolution), 100, [codec, resolution]() { return setup_encode(codec, resolution); });
+			}
+		}
+
+		// Conversion to 10-bit, for each preset and across thread counts to show how slicing scales.
+		for (auto resolution : scale_resolutions) {
+			for (auto preset : {streamfx::ffmpeg::swscale::preset::FAST, streamfx::ffmpeg::swscale::preset::BALANCED, streamfx::ffmpeg::swscale::preset::QUALITY}) {
+				for (size_t threads : {1, 2, 4, 8}) {
+					std::string name = make_name("ffmpeg.swscale." + std::to_string(static_cast<int32_t>(preset)) + "." + std::to_string(threads) + "t", resolution);
+					streamfx::util::benchmark::add(name, 50, [resolution, preset, threads]() { return setup_swscale(resolution, preset, threads); });
+				}
+			}
+		}
+
+		// Repacking against swscale doing the same work. The odd resolution checks the edges of the kernels.
+		for (auto resolution : {scale_resolutions[0], scale_resolutions[1], std::pair<int32_t, int32_t>{1279, 719}}) {
+			for (auto formats : repack_formats) {
+				std::string name = std::string("ffmpeg.repack.") + av_get_pix_fmt_name(formats.first) + "." + av_get_pix_fmt_name(formats.second);
+				streamfx::util::benchmark::add(make_name(name, resolution), 100, [resolution, formats]() { return setup_repack(resolution, formats, true); });
+				streamfx::util::benchmark::add(make_name(name + ".swscale", resolution), 100, [resolution, formats]() { return setup_repack(resolution, formats, false); });
+			}
+		}
+	},
+	[]() { // Finalizer
+	},
+	streamfx::loader_priority::NORMAL);
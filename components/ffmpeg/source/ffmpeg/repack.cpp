@@ -0,0 +1,444 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "repack.hpp"
+
+extern "C" {
+#include "warning-disable.hpp"
+#include <libavutil/cpu.h>
+#include "warning-enable.hpp"
+}
+
+#include "warning-disable.hpp"
+#if defined(D_PLATFORM_INSTR_X86)
+#define ST_REPACK_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#elif defined(D_PLATFORM_INSTR_ARM) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define ST_REPACK_NEON
+#include <arm_neon.h>
+#endif
+#include "warning-enable.hpp"
+
+// MSVC allows intrinsics of any instruction set, GCC and Clang must be told per function.
+#if defined(_MSC_VER)
+#define ST_TARGET_AVX2
+#else
+#define ST_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using namespace streamfx::ffmpeg;
+
+namespace {
+	// Row kernels, 'n' is the number of samples (or sample pairs when interleaving).
+	struct kernels_t {
+		const char* name;
+		void (*deinterleave8)(const uint8_t* src, uint8_t* u, uint8_t* v, size_t n);
+		void (*interleave8)(const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t n);
+		void (*deinterleave16)(const uint16_t* src, uint16_t* u, uint16_t* v, size_t n, int32_t shift); // u = src >> shift
+		void (*interleave16)(const uint16_t* u, const uint16_t* v, uint16_t* dst, size_t n, int32_t shift); // dst = u << shift
+		void (*shift16)(const uint16_t* src, uint16_t* dst, size_t n, int32_t left, int32_t right); // dst = (src << left) | (src >> right)
+	};
+
+	void deinterleave8_c(const uint8_t* src, uint8_t* u, uint8_t* v, size_t n)
+	{
+		for (size_t i = 0; i < n; i++) {
+			u[i] = src[i * 2];
+			v[i] = src[i * 2 + 1];
+		}
+	}
+
+	void interleave8_c(const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t n)
+	{
+		for (size_t i = 0; i < n; i++) {
+			dst[i * 2]     = u[i];
+			dst[i * 2 + 1] = v[i];
+		}
+	}
+
+	void deinterleave16_c(const uint16_t* src, uint16_t* u, uint16_t* v, size_t n, int32_t shift)
+	{
+		for (size_t i = 0; i < n; i++) {
+			u[i] = static_cast<uint16_t>(src[i * 2] >> shift);
+			v[i] = static_cast<uint16_t>(src[i * 2 + 1] >> shift);
+		}
+	}
+
+	void interleave16_c(const uint16_t* u, const uint16_t* v, uint16_t* dst, size_t n, int32_t shift)
+	{
+		for (size_t i = 0; i < n; i++) {
+			dst[i * 2]     = static_cast<uint16_t>(u[i] << shift);
+			dst[i * 2 + 1] = static_cast<uint16_t>(v[i] << shift);
+		}
+	}
+
+	void shift16_c(const uint16_t* src, uint16_t* dst, size_t n, int32_t left, int32_t right)
+	{
+		// Shifts of 16 or more clear the value, same as the vector instructions do.
+		for (size_t i = 0; i < n; i++) {
+			uint32_t value = src[i];
+			dst[i]         = static_cast<uint16_t>((value << left) | (value >> right));
+		}
+	}
+
+	constexpr kernels_t kernels_c = {"C", deinterleave8_c, interleave8_c, deinterleave16_c, interleave16_c, shift16_c};
+
+#ifdef ST_REPACK_X86
+	void deinterleave8_sse2(const uint8_t* src, uint8_t* u, uint8_t* v, size_t n)
+	{
+		const __m128i mask = _mm_set1_epi16(0x00FF);
+
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 16));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(u + i), _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(v + i), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+		}
+		deinterleave8_c(src + i * 2, u + i, v + i, n - i);
+	}
+
+	void interleave8_sse2(const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t n)
+	{
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_unpacklo_epi8(a, b));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 16), _mm_unpackhi_epi8(a, b));
+		}
+		interleave8_c(u + i, v + i, dst + i * 2, n - i);
+	}
+
+	void deinterleave16_sse2(const uint16_t* src, uint16_t* u, uint16_t* v, size_t n, int32_t shift)
+	{
+		const __m128i mask    = _mm_set1_epi32(0xFFFF);
+		const __m128i bias32  = _mm_set1_epi32(0x8000);
+		const __m128i bias16  = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+		const __m128i shift_u = _mm_cvtsi32_si128(shift);
+		const __m128i shift_v = _mm_cvtsi32_si128(shift + 16);
+
+		// SSE2 can only pack with signed saturation, so move the values into the signed range and back.
+		auto pack = [&](__m128i a, __m128i b) { return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(a, bias32), _mm_sub_epi32(b, bias32)), bias16); };
+
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 8));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(u + i), pack(_mm_srl_epi32(_mm_and_si128(a, mask), shift_u), _mm_srl_epi32(_mm_and_si128(b, mask), shift_u)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(v + i), pack(_mm_srl_epi32(a, shift_v), _mm_srl_epi32(b, shift_v)));
+		}
+		deinterleave16_c(src + i * 2, u + i, v + i, n - i, shift);
+	}
+
+	void interleave16_sse2(const uint16_t* u, const uint16_t* v, uint16_t* dst, size_t n, int32_t shift)
+	{
+		const __m128i count = _mm_cvtsi32_si128(shift);
+
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8) {
+			__m128i a = _mm_sll_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u + i)), count);
+			__m128i b = _mm_sll_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + i)), count);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_unpacklo_epi16(a, b));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 8), _mm_unpackhi_epi16(a, b));
+		}
+		interleave16_c(u + i, v + i, dst + i * 2, n - i, shift);
+	}
+
+	void shift16_sse2(const uint16_t* src, uint16_t* dst, size_t n, int32_t left, int32_t right)
+	{
+		const __m128i count_l = _mm_cvtsi32_si128(left);
+		const __m128i count_r = _mm_cvtsi32_si128(right);
+
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(_mm_sll_epi16(a, count_l), _mm_srl_epi16(a, count_r)));
+		}
+		shift16_c(src + i, dst + i, n - i, left, right);
+	}
+
+	constexpr kernels_t kernels_sse2 = {"SSE2", deinterleave8_sse2, interleave8_sse2, deinterleave16_sse2, interleave16_sse2, shift16_sse2};
+
+	// AVX2 packs and unpacks within each 128-bit lane, so results are permuted back into order.
+	ST_TARGET_AVX2 void deinterleave8_avx2(const uint8_t* src, uint8_t* u, uint8_t* v, size_t n)
+	{
+		const __m256i mask = _mm256_set1_epi16(0x00FF);
+
+		size_t i = 0;
+		for (; (i + 32) <= n; i += 32) {
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2 + 32));
+			__m256i x = _mm256_packus_epi16(_mm256_and_si256(a, mask), _mm256_and_si256(b, mask));
+			__m256i y = _mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(u + i), _mm256_permute4x64_epi64(x, 0xD8));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(v + i), _mm256_permute4x64_epi64(y, 0xD8));
+		}
+		deinterleave8_sse2(src + i * 2, u + i, v + i, n - i);
+	}
+
+	ST_TARGET_AVX2 void interleave8_avx2(const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t n)
+	{
+		size_t i = 0;
+		for (; (i + 32) <= n; i += 32) {
+			__m256i a  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(u + i));
+			__m256i b  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i));
+			__m256i lo = _mm256_unpacklo_epi8(a, b);
+			__m256i hi = _mm256_unpackhi_epi8(a, b);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+		}
+		interleave8_sse2(u + i, v + i, dst + i * 2, n - i);
+	}
+
+	ST_TARGET_AVX2 void deinterleave16_avx2(const uint16_t* src, uint16_t* u, uint16_t* v, size_t n, int32_t shift)
+	{
+		const __m256i mask    = _mm256_set1_epi32(0xFFFF);
+		const __m128i shift_u = _mm_cvtsi32_si128(shift);
+		const __m128i shift_v = _mm_cvtsi32_si128(shift + 16);
+
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16) {
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2 + 16));
+			__m256i x = _mm256_packus_epi32(_mm256_srl_epi32(_mm256_and_si256(a, mask), shift_u), _mm256_srl_epi32(_mm256_and_si256(b, mask), shift_u));
+			__m256i y = _mm256_packus_epi32(_mm256_srl_epi32(a, shift_v), _mm256_srl_epi32(b, shift_v));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(u + i), _mm256_permute4x64_epi64(x, 0xD8));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(v + i), _mm256_permute4x64_epi64(y, 0xD8));
+		}
+		deinterleave16_sse2(src + i * 2, u + i, v + i, n - i, shift);
+	}
+
+	ST_TARGET_AVX2 void interleave16_avx2(const uint16_t* u, const uint16_t* v, uint16_t* dst, size_t n, int32_t shift)
+	{
+		const __m128i count = _mm_cvtsi32_si128(shift);
+
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16) {
+			__m256i a  = _mm256_sll_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(u + i)), count);
+			__m256i b  = _mm256_sll_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i)), count);
+			__m256i lo = _mm256_unpacklo_epi16(a, b);
+			__m256i hi = _mm256_unpackhi_epi16(a, b);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+		}
+		interleave16_sse2(u + i, v + i, dst + i * 2, n - i, shift);
+	}
+
+	ST_TARGET_AVX2 void shift16_avx2(const uint16_t* src, uint16_t* dst, size_t n, int32_t left, int32_t right)
+	{
+		const __m128i count_l = _mm_cvtsi32_si128(left);
+		const __m128i count_r = _mm_cvtsi32_si128(right);
+
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16) {
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(_mm256_sll_epi16(a, count_l), _mm256_srl_epi16(a, count_r)));
+		}
+		shift16_sse2(src + i, dst + i, n - i, left, right);
+	}
+
+	constexpr kernels_t kernels_avx2 = {"AVX2", deinterleave8_avx2, interleave8_avx2, deinterleave16_avx2, interleave16_avx2, shift16_avx2};
+#endif
+
+#ifdef ST_REPACK_NEON
+	void deinterleave8_neon(const uint8_t* src, uint8_t* u, uint8_t* v, size_t n)
+	{
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16) {
+			uint8x16x2_t data = vld2q_u8(src + i * 2);
+			vst1q_u8(u + i, data.val[0]);
+			vst1q_u8(v + i, data.val[1]);
+		}
+		deinterleave8_c(src + i * 2, u + i, v + i, n - i);
+	}
+
+	void interleave8_neon(const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t n)
+	{
+		size_t i = 0;
+		for (; (i + 16) <= n; i += 16) {
+			uint8x16x2_t data;
+			data.val[0] = vld1q_u8(u + i);
+			data.val[1] = vld1q_u8(v + i);
+			vst2q_u8(dst + i * 2, data);
+		}
+		interleave8_c(u + i, v + i, dst + i * 2, n - i);
+	}
+
+	void deinterleave16_neon(const uint16_t* src, uint16_t* u, uint16_t* v, size_t n, int32_t shift)
+	{
+		// Negative shifts shift right.
+		const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(-shift));
+
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8) {
+			uint16x8x2_t data = vld2q_u16(src + i * 2);
+			vst1q_u16(u + i, vshlq_u16(data.val[0], count));
+			vst1q_u16(v + i, vshlq_u16(data.val[1], count));
+		}
+		deinterleave16_c(src + i * 2, u + i, v + i, n - i, shift);
+	}
+
+	void interleave16_neon(const uint16_t* u, const uint16_t* v, uint16_t* dst, size_t n, int32_t shift)
+	{
+		const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(shift));
+
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8) {
+			uint16x8x2_t data;
+			data.val[0] = vshlq_u16(vld1q_u16(u + i), count);
+			data.val[1] = vshlq_u16(vld1q_u16(v + i), count);
+			vst2q_u16(dst + i * 2, data);
+		}
+		interleave16_c(u + i, v + i, dst + i * 2, n - i, shift);
+	}
+
+	void shift16_neon(const uint16_t* src, uint16_t* dst, size_t n, int32_t left, int32_t right)
+	{
+		const int16x8_t count_l = vdupq_n_s16(static_cast<int16_t>(left));
+		const int16x8_t count_r = vdupq_n_s16(static_cast<int16_t>(-right));
+
+		size_t i = 0;
+		for (; (i + 8) <= n; i += 8) {
+			uint16x8_t data = vld1q_u16(src + i);
+			vst1q_u16(dst + i, vorrq_u16(vshlq_u16(data, count_l), vshlq_u16(data, count_r)));
+		}
+		shift16_c(src + i, dst + i, n - i, left, right);
+	}
+
+	constexpr kernels_t kernels_neon = {"NEON", deinterleave8_neon, interleave8_neon, deinterleave16_neon, interleave16_neon, shift16_neon};
+#endif
+
+	const kernels_t& kernels()
+	{
+		static const kernels_t& selected = []() -> const kernels_t& {
+			[[maybe_unused]] int flags = av_get_cpu_flags();
+#ifdef ST_REPACK_X86
+			if (flags & AV_CPU_FLAG_AVX2) {
+				return kernels_avx2;
+			} else if (flags & AV_CPU_FLAG_SSE2) {
+				return kernels_sse2;
+			}
+#endif
+#ifdef ST_REPACK_NEON
+			if (flags & AV_CPU_FLAG_NEON) {
+				return kernels_neon;
+			}
+#endif
+			return kernels_c;
+		}();
+		return selected;
+	}
+
+	template<typename T>
+	inline T* row_of(uint8_t* const data[], const int stride[], size_t plane, int32_t row)
+	{
+		return reinterpret_cast<T*>(data[plane] + static_cast<ptrdiff_t>(row) * stride[plane]);
+	}
+
+	template<typename T>
+	inline const T* row_of(const uint8_t* const data[], const int stride[], size_t plane, int32_t row)
+	{
+		return reinterpret_cast<const T*>(data[plane] + static_cast<ptrdiff_t>(row) * stride[plane]);
+	}
+
+	// All supported formats use 4:2:0 subsampling, so chroma covers half the rows and columns (rounded up).
+	inline std::pair<int32_t, int32_t> chroma_rows(int32_t row, int32_t rows)
+	{
+		return {row / 2, (row + rows + 1) / 2 - row / 2};
+	}
+
+	int32_t nv12_to_yuv420p(const uint8_t* const source_data[], const int source_stride[], uint8_t* const target_data[], const int target_stride[], int32_t width, int32_t row, int32_t rows)
+	{
+		auto& k = kernels();
+		for (int32_t y = row; y < (row + rows); y++) {
+			memcpy(row_of<uint8_t>(target_data, target_stride, 0, y), row_of<uint8_t>(source_data, source_stride, 0, y), static_cast<size_t>(width));
+		}
+		auto [crow, crows] = chroma_rows(row, rows);
+		for (int32_t y = crow; y < (crow + crows); y++) {
+			k.deinterleave8(row_of<uint8_t>(source_data, source_stride, 1, y), row_of<uint8_t>(target_data, target_stride, 1, y), row_of<uint8_t>(target_data, target_stride, 2, y), static_cast<size_t>((width + 1) / 2));
+		}
+		return rows;
+	}
+
+	int32_t yuv420p_to_nv12(const uint8_t* const source_data[], const int source_stride[], uint8_t* const target_data[], const int target_stride[], int32_t width, int32_t row, int32_t rows)
+	{
+		auto& k = kernels();
+		for (int32_t y = row; y < (row + rows); y++) {
+			memcpy(row_of<uint8_t>(target_data, target_stride, 0, y), row_of<uint8_t>(source_data, source_stride, 0, y), static_cast<size_t>(width));
+		}
+		auto [crow, crows] = chroma_rows(row, rows);
+		for (int32_t y = crow; y < (crow + crows); y++) {
+			k.interleave8(row_of<uint8_t>(source_data, source_stride, 1, y), row_of<uint8_t>(source_data, source_stride, 2, y), row_of<uint8_t>(target_data, target_stride, 1, y), static_cast<size_t>((width + 1) / 2));
+		}
+		return rows;
+	}
+
+	// P010 stores samples in the upper 10 bits, I010 (YUV420P10) in the lower 10 bits.
+	int32_t p010_to_yuv420p10(const uint8_t* const source_data[], const int source_stride[], uint8_t* const target_data[], const int target_stride[], int32_t width, int32_t row, int32_t rows)
+	{
+		auto& k = kernels();
+		for (int32_t y = row; y < (row + rows); y++) {
+			k.shift16(row_of<uint16_t>(source_data, source_stride, 0, y), row_of<uint16_t>(target_data, target_stride, 0, y), static_cast<size_t>(width), 16, 6);
+		}
+		auto [crow, crows] = chroma_rows(row, rows);
+		for (int32_t y = crow; y < (crow + crows); y++) {
+			k.deinterleave16(row_of<uint16_t>(source_data, source_stride, 1, y), row_of<uint16_t>(target_data, target_stride, 1, y), row_of<uint16_t>(target_data, target_stride, 2, y), static_cast<size_t>((width + 1) / 2), 6);
+		}
+		return rows;
+	}
+
+	int32_t yuv420p10_to_p010(const uint8_t* const source_data[], const int source_stride[], uint8_t* const target_data[], const int target_stride[], int32_t width, int32_t row, int32_t rows)
+	{
+		auto& k = kernels();
+		for (int32_t y = row; y < (row + rows); y++) {
+			k.shift16(row_of<uint16_t>(source_data, source_stride, 0, y), row_of<uint16_t>(target_data, target_stride, 0, y), static_cast<size_t>(width), 6, 16);
+		}
+		auto [crow, crows] = chroma_rows(row, rows);
+		for (int32_t y = crow; y < (crow + crows); y++) {
+			k.interleave16(row_of<uint16_t>(source_data, source_stride, 1, y), row_of<uint16_t>(source_data, source_stride, 2, y), row_of<uint16_t>(target_data, target_stride, 1, y), static_cast<size_t>((width + 1) / 2), 6);
+		}
+		return rows;
+	}
+
+	// Expands to 16 bits by replicating the upper bits into the lower ones, like swscale does.
+	int32_t p010_to_p016(const uint8_t* const source_data[], const int source_stride[], uint8_t* const target_data[], const int target_stride[], int32_t width, int32_t row, int32_t rows)
+	{
+		auto& k = kernels();
+		for (int32_t y = row; y < (row + rows); y++) {
+			k.shift16(row_of<uint16_t>(source_data, source_stride, 0, y), row_of<uint16_t>(target_data, target_stride, 0, y), static_cast<size_t>(width), 0, 10);
+		}
+		auto [crow, crows] = chroma_rows(row, rows);
+		for (int32_t y = crow; y < (crow + crows); y++) {
+			k.shift16(row_of<uint16_t>(source_data, source_stride, 1, y), row_of<uint16_t>(target_data, target_stride, 1, y), static_cast<size_t>((width + 1) / 2) * 2, 0, 10);
+		}
+		return rows;
+	}
+} // namespace
+
+repack::function_t repack::find(AVPixelFormat source, AVPixelFormat target)
+{
+	struct entry {
+		AVPixelFormat source;
+		AVPixelFormat target;
+		function_t    function;
+	};
+	static constexpr entry table[] = {
+		{AV_PIX_FMT_NV12, AV_PIX_FMT_YUV420P, nv12_to_yuv420p},     {AV_PIX_FMT_YUV420P, AV_PIX_FMT_NV12, yuv420p_to_nv12},
+		{AV_PIX_FMT_P010, AV_PIX_FMT_YUV420P10, p010_to_yuv420p10}, {AV_PIX_FMT_YUV420P10, AV_PIX_FMT_P010, yuv420p10_to_p010},
+		{AV_PIX_FMT_P010, AV_PIX_FMT_P016, p010_to_p016},
+	};
+
+	for (auto& kv : table) {
+		if ((kv.source == source) && (kv.target == target)) {
+			return kv.function;
+		}
+	}
+	return nullptr;
+}
+
+const char* repack::get_instruction_set()
+{
+	return kernels().name;
+}
@@ -0,0 +1,34 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+
+extern "C" {
+#include "warning-disable.hpp"
+#include <libavutil/pixfmt.h>
+#include "warning-enable.hpp"
+}
+
+namespace streamfx::ffmpeg::repack {
+	/** Convert rows [row, row + rows) of a frame between two formats of the same size.
+	 *
+	 * 'row' must be a multiple of the vertical chroma subsampling. Returns the number of rows converted.
+	 */
+	typedef int32_t (*function_t)(const uint8_t* const source_data[], const int source_stride[], uint8_t* const target_data[], const int target_stride[], int32_t width, int32_t row, int32_t rows);
+
+	/** Find a hand optimized conversion from one format to another.
+	 *
+	 * These only move, interleave or shift samples and never change their meaning, so they are only valid if
+	 * size, range and color space of source and target are identical. The result matches what swscale produces
+	 * for the same conversion.
+	 *
+	 * @return The conversion function, or nullptr if there is none for this pair of formats.
+	 */
+	function_t find(AVPixelFormat source, AVPixelFormat target);
+
+	/** Name of the instruction set the conversions were selected for, such as 'AVX2' or 'NEON'.
+	 */
+	const char* get_instruction_set();
+} // namespace streamfx::ffmpeg::repack
@@ -4,13 +4,37 @@
 // AUTOGENERATED COPYRIGHT HEADER END
 
 #include "swscale.hpp"
+#include "plugin.hpp"
 
 #include "warning-disable.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
 #include <stdexcept>
 #include "warning-enable.hpp"
 
+extern "C" {
+#include "warning-disable.hpp"
+#include <libavutil/pixdesc.h>
+#include "warning-enable.hpp"
+}
+
+// Slices smaller than this are not worth the synchronization overhead.
+#define ST_MINIMUM_SLICE_HEIGHT 64
+
 using namespace streamfx::ffmpeg;
 
+namespace {
+	int32_t plane_vertical_shift(AVPixelFormat format, std::size_t plane)
+	{
+		const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+		if (!desc || (plane == 0) || (plane == 3)) {
+			return 0;
+		}
+		return desc->log2_chroma_h;
+	}
+} // namespace
+
 swscale::swscale() = default;
 
 swscale::~swscale()
@@ -144,6 +168,49 @@ bool swscale::is_target_full_range()
 	return this->target_full_range;
 }
 
+void swscale::set_threads(std::size_t value)
+{
+	this->threads = std::max<std::size_t>(value, 1);
+}
+
+std::size_t swscale::get_threads()
+{
+	return this->threads;
+}
+
+std::size_t swscale::get_slice_count()
+{
+	return std::max<std::size_t>(this->slices.size(), 1);
+}
+
+void swscale::set_repack(bool enabled)
+{
+	this->allow_repack = enabled;
+}
+
+bool swscale::is_repacking()
+{
+	return this->repack != nullptr;
+}
+
+int swscale::get_flags(preset preset)
+{
+	switch (preset) {
+	case preset::FAST:
+		return SWS_FAST_BILINEAR;
+	case preset::BALANCED:
+		return SWS_BICUBIC | SWS_FULL_CHR_H_INT | SWS_FULL_CHR_H_INP;
+	case preset::QUALITY:
+	default:
+		return SWS_SINC | SWS_FULL_CHR_H_INT | SWS_FULL_CHR_H_INP | SWS_ACCURATE_RND | SWS_BITEXACT;
+	}
+}
+
+bool swscale::initialize(preset preset)
+{
+	return initialize(get_flags(preset));
+}
+
 bool swscale::initialize(int flags)
 {
 	if (this->context) {
@@ -163,11 +230,51 @@ bool swscale::initialize(int flags)
 
 	sws_setColorspaceDetails(this->context, sws_getCoefficients(source_colorspace), source_full_range ? 1 : 0, sws_getCoefficients(target_colorspace), target_full_range ? 1 : 0, 1L << 16 | 0L, 1L << 16 | 0L, 1L << 16 | 0L);
 
+	// Repacking only moves samples around, so it is only possible if nothing else changes.
+	if (allow_repack && (source_size == target_size) && (source_full_range == target_full_range) && (source_colorspace == target_colorspace)) {
+		this->repack = repack::find(source_format, target_format);
+	}
+
+	// Split into slices if rows can be converted independently.
+	int32_t source_shift = plane_vertical_shift(source_format, 1);
+	int32_t target_shift = plane_vertical_shift(target_format, 1);
+	if ((threads > 1) && (source_size == target_size) && (source_shift == target_shift)) {
+		int32_t height    = static_cast<int32_t>(source_size.second);
+		int32_t alignment = 1 << source_shift;
+		int32_t count     = static_cast<int32_t>(std::min<std::size_t>(threads, static_cast<std::size_t>(std::max(height / ST_MINIMUM_SLICE_HEIGHT, 1))));
+		int32_t rows      = (((height + count - 1) / count) + alignment - 1) & ~(alignment - 1);
+
+		for (int32_t row = 0; (count > 1) && (row < height); row += rows) {
+			int32_t     slice_rows = std::min(rows, height - row);
+			SwsContext* slice      = sws_getContext(static_cast<int>(source_size.first), slice_rows, source_format, static_cast<int>(target_size.first), slice_rows, target_format, flags, nullptr, nullptr, nullptr);
+			if (!slice) {
+				// Not fatal, the whole frame context still works.
+				for (auto ctx : slice_contexts) {
+					sws_freeContext(ctx);
+				}
+				slice_contexts.clear();
+				slices.clear();
+				break;
+			}
+
+			sws_setColorspaceDetails(slice, sws_getCoefficients(source_colorspace), source_full_range ? 1 : 0, sws_getCoefficients(target_colorspace), target_full_range ? 1 : 0, 1L << 16 | 0L, 1L << 16 | 0L, 1L << 16 | 0L);
+			slice_contexts.push_back(slice);
+			slices.emplace_back(row, slice_rows);
+		}
+	}
+
 	return true;
 }
 
 bool swscale::finalize()
 {
+	for (auto ctx : slice_contexts) {
+		sws_freeContext(ctx);
+	}
+	slice_contexts.clear();
+	slices.clear();
+	repack = nullptr;
+
 	if (this->context) {
 		sws_freeContext(this->context);
 		this->context = nullptr;
@@ -181,6 +288,70 @@ int32_t swscale::convert(const uint8_t* const source_data[], const int source_st
 	if (!this->context) {
 		return 0;
 	}
+
+	if ((slice_contexts.size() > 1) && (source_row == 0) && (source_rows == static_cast<int32_t>(source_size.second))) {
+		std::vector<int32_t> results(slices.size(), 0);
+
+		auto convert_slice = [&](std::size_t idx) {
+			if (this->repack) {
+				results[idx] = this->repack(source_data, source_stride, target_data, target_stride, static_cast<int32_t>(source_size.first), slices[idx].first, slices[idx].second);
+				return;
+			}
+
+			std::array<const uint8_t*, 4> source_planes = {nullptr, nullptr, nullptr, nullptr};
+			std::array<uint8_t*, 4>       target_planes = {nullptr, nullptr, nullptr, nullptr};
+			for (std::size_t plane = 0; plane < 4; plane++) {
+				if (source_data[plane]) {
+					source_planes[plane] = source_data[plane] + static_cast<ptrdiff_t>(slices[idx].first >> plane_vertical_shift(source_format, plane)) * source_stride[plane];
+				}
+				if (target_data[plane]) {
+					target_planes[plane] = target_data[plane] + static_cast<ptrdiff_t>(slices[idx].first >> plane_vertical_shift(target_format, plane)) * target_stride[plane];
+				}
+			}
+			results[idx] = sws_scale(slice_contexts[idx], source_planes.data(), source_stride, 0, slices[idx].second, target_planes.data(), target_stride);
+		};
+
+		// Slices are claimed by whoever gets to them first. This thread never waits for a slice that no worker picked
+		// up yet, and instead converts it itself, so a busy threadpool costs no more than converting it all here.
+		auto claimed = std::make_unique<std::atomic<bool>[]>(slices.size());
+		for (std::size_t idx = 0; idx < slices.size(); idx++) {
+			claimed[idx] = false;
+		}
+		auto claim = [&claimed, &convert_slice](std::size_t idx) {
+			if (!claimed[idx].exchange(true)) {
+				convert_slice(idx);
+			}
+		};
+
+		std::vector<std::shared_ptr<::streamfx::util::threadpool::task>> tasks;
+		tasks.reserve(slices.size() - 1);
+		for (std::size_t idx = 1; idx < slices.size(); idx++) {
+			tasks.push_back(::streamfx::threadpool()->push([&claim, idx](::streamfx::util::threadpool::task_data_t) { claim(idx); }, nullptr, ::streamfx::util::threadpool::priority::INTERACTIVE));
+		}
+		for (std::size_t idx = 0; idx < slices.size(); idx++) {
+			claim(idx);
+		}
+
+		// Waits for tasks that are still converting, and keeps those that have not started from ever touching this
+		// stack frame.
+		for (auto& task : tasks) {
+			task->cancel();
+		}
+
+		int32_t height = 0;
+		for (std::size_t idx = 0; idx < slices.size(); idx++) {
+			if (results[idx] <= 0) {
+				return results[idx];
+			}
+			height += results[idx];
+		}
+		return height;
+	}
+
+	if (this->repack && ((source_row % 2) == 0)) {
+		return this->repack(source_data, source_stride, target_data, target_stride, static_cast<int32_t>(source_size.first), source_row, source_rows);
+	}
+
 	int height = sws_scale(this->context, source_data, source_stride, source_row, source_rows, target_data, target_stride);
 	return height;
 }
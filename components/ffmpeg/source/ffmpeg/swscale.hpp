@@ -4,9 +4,11 @@
 
 #pragma once
 #include "common.hpp"
+#include "repack.hpp"
 
 #include "warning-disable.hpp"
 #include <utility>
+#include <vector>
 #include "warning-enable.hpp"
 
 extern "C" {
@@ -18,6 +20,14 @@ extern "C" {
 
 namespace streamfx::ffmpeg {
 	class swscale {
+		public:
+		enum class preset : int32_t {
+			FAST     = 0, // Bilinear, no accurate rounding.
+			BALANCED = 1, // Bicubic with full chroma interpolation.
+			QUALITY  = 2, // Sinc with accurate rounding and bit exact output.
+		};
+
+		private:
 		std::pair<uint32_t, uint32_t> source_size;
 		AVPixelFormat                 source_format     = AV_PIX_FMT_NONE;
 		bool                          source_full_range = false;
@@ -30,6 +40,15 @@ namespace streamfx::ffmpeg {
 
 		SwsContext* context = nullptr;
 
+		// Horizontal slices, each converted by its own context on the threadpool.
+		std::size_t                              threads = 1;
+		std::vector<SwsContext*>                 slice_contexts;
+		std::vector<std::pair<int32_t, int32_t>> slices;
+
+		// Hand optimized conversion used instead of swscale, if one exists.
+		bool                 allow_repack = true;
+		repack::function_t   repack       = nullptr;
+
 		public:
 		swscale();
 		~swscale();
@@ -60,9 +79,28 @@ namespace streamfx::ffmpeg {
 		void                          set_target_full_range(bool full_range);
 		bool                          is_target_full_range();
 
+		/** Set the maximum number of slices a frame is split into.
+		 *
+		 * Must be called before initialize(). Slicing is only used if the conversion does not resize the
+		 * image or change the vertical chroma subsampling, as only then are rows independent of each other.
+		 */
+		void        set_threads(std::size_t threads);
+		std::size_t get_threads();
+		std::size_t get_slice_count();
+
+		/** Allow replacing swscale with a hand optimized conversion, if there is one for the formats.
+		 *
+		 * Must be called before initialize(). Enabled by default, and only disabled to compare against swscale.
+		 */
+		void set_repack(bool enabled);
+		bool is_repacking();
+
 		bool initialize(int flags);
+		bool initialize(preset preset);
 		bool finalize();
 
+		static int get_flags(preset preset);
+
 		int32_t convert(const uint8_t* const source_data[], const int source_stride[], int32_t source_row, int32_t source_rows, uint8_t* const target_data[], const int target_stride[]);
 	};
 } // namespace streamfx::ffmpeg
@@ -259,7 +259,7 @@ void mirror_instance::on_audio(::streamfx::obs::source, const audio_data* audio,
 	}
 
 	// Create a clone of the audio data and push it to the thread pool.
-	streamfx::threadpool()->push(std::bind(&mirror_instance::audio_output, this, std::placeholders::_1), nullptr);
+	streamfx::threadpool()->push(std::bind(&mirror_instance::audio_output, this, std::placeholders::_1), nullptr, streamfx::util::threadpool::priority::REALTIME, std::chrono::milliseconds(20));
 }
 
 void mirror_instance::audio_output(std::shared_ptr<void> data)
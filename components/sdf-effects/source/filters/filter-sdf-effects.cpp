@@ -102,20 +102,16 @@ using namespace streamfx::filter::sdf_effects;
 
 static constexpr std::string_view HELP_URL = "https://github.com/Xaymar/obs-StreamFX/wiki/Filter-SDF-Effects";
 
-sdf_effects_instance::sdf_effects_instance(obs_data_t* settings, obs_source_t* self) : obs::source_instance(settings, self), _gfx_util(::streamfx::gfx::util::get()), _source_rendered(false), _sdf_scale(1.0), _sdf_threshold(), _output_rendered(false), _inner_shadow(false), _inner_shadow_color(), _inner_shadow_range_min(), _inner_shadow_range_max(), _inner_shadow_offset_x(), _inner_shadow_offset_y(), _outer_shadow(false), _outer_shadow_color(), _outer_shadow_range_min(), _outer_shadow_range_max(), _outer_shadow_offset_x(), _outer_shadow_offset_y(), _inner_glow(false), _inner_glow_color(), _inner_glow_width(), _inner_glow_sharpness(), _inner_glow_sharpness_inv(), _outer_glow(false), _outer_glow_color(), _outer_glow_width(), _outer_glow_sharpness(), _outer_glow_sharpness_inv(), _outline(false), _outline_color(), _outline_width(), _outline_offset(), _outline_sharpness(), _outline_sharpness_inv()
+sdf_effects_instance::sdf_effects_instance(obs_data_t* settings, obs_source_t* self) : obs::source_instance(settings, self), _gfx_util(::streamfx::gfx::util::get()), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _source_rendered(false), _sdf_scale(1.0), _sdf_threshold(), _output_rendered(false), _inner_shadow(false), _inner_shadow_color(), _inner_shadow_range_min(), _inner_shadow_range_max(), _inner_shadow_offset_x(), _inner_shadow_offset_y(), _outer_shadow(false), _outer_shadow_color(), _outer_shadow_range_min(), _outer_shadow_range_max(), _outer_shadow_offset_x(), _outer_shadow_offset_y(), _inner_glow(false), _inner_glow_color(), _inner_glow_width(), _inner_glow_sharpness(), _inner_glow_sharpness_inv(), _outer_glow(false), _outer_glow_color(), _outer_glow_width(), _outer_glow_sharpness(), _outer_glow_sharpness_inv(), _outline(false), _outline_color(), _outline_width(), _outline_offset(), _outline_sharpness(), _outline_sharpness_inv()
 {
 	{
 		auto gctx        = streamfx::obs::gs::context();
 		vec4 transparent = {0, 0, 0, 0};
 
-		_source_rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-		_sdf_write = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA32F, GS_ZS_NONE);
-		_sdf_read  = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA32F, GS_ZS_NONE);
-		_output_rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-
-		std::shared_ptr<streamfx::obs::gs::rendertarget> initialize_rts[] = {_source_rt, _sdf_write, _sdf_read, _output_rt};
-		for (auto rt : initialize_rts) {
-			auto op = rt->render(1, 1);
+		// The distance field starts out empty, everything else is drawn before it is used.
+		_sdf_read = _pool->acquire(1, 1, GS_RGBA32F);
+		{
+			auto op = _sdf_read->render(1, 1);
 			gs_clear(GS_CLEAR_COLOR | GS_CLEAR_DEPTH, &transparent, 0, 0);
 		}
 
@@ -279,6 +275,8 @@ void sdf_effects_instance::video_tick(float)
 	if (obs_source_t* target = obs_filter_get_target(_self); target != nullptr) {
 		_source_rendered = false;
 		_output_rendered = false;
+		_source_texture.reset();
+		_output_texture.reset();
 	}
 }
 
@@ -325,17 +323,20 @@ void sdf_effects_instance::video_render(gs_effect_t* effect)
 				streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_cache, "Cache"};
 #endif
 
-				auto op = _source_rt->render(baseW, baseH);
-				gs_ortho(0, static_cast<float>(baseW), 0, static_cast<float>(baseH), -1, 1);
-				gs_clear(GS_CLEAR_COLOR | GS_CLEAR_DEPTH, &color_transparent, 0, 0);
+				auto rt = _pool->acquire(baseW, baseH);
+				{
+					auto op = rt->render(baseW, baseH);
+					gs_ortho(0, static_cast<float>(baseW), 0, static_cast<float>(baseH), -1, 1);
+					gs_clear(GS_CLEAR_COLOR | GS_CLEAR_DEPTH, &color_transparent, 0, 0);
 
-				if (obs_source_process_filter_begin(_self, GS_RGBA, OBS_ALLOW_DIRECT_RENDERING)) {
-					obs_source_process_filter_end(_self, final_effect, baseW, baseH);
-				} else {
-					throw std::runtime_error("failed to process source");
+					if (obs_source_process_filter_begin(_self, GS_RGBA, OBS_ALLOW_DIRECT_RENDERING)) {
+						obs_source_process_filter_end(_self, final_effect, baseW, baseH);
+					} else {
+						throw std::runtime_error("failed to process source");
+					}
 				}
+				_source_texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 			}
-			_source_rt->get_texture(_source_texture);
 			if (!_source_texture) {
 				throw std::runtime_error("failed to draw source");
 			}
@@ -362,25 +363,26 @@ void sdf_effects_instance::video_render(gs_effect_t* effect)
 					sdfH = 1.0;
 				}
 
+				auto sdf_write = _pool->acquire(uint32_t(sdfW), uint32_t(sdfH), GS_RGBA32F);
 				{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 					streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_convert, "Update Distance Field"};
 #endif
 
-					auto op = _sdf_write->render(uint32_t(sdfW), uint32_t(sdfH));
+					auto op = sdf_write->render(uint32_t(sdfW), uint32_t(sdfH));
 					gs_ortho(0, 1, 0, 1, -1, 1);
 					gs_clear(GS_CLEAR_COLOR | GS_CLEAR_DEPTH, &color_transparent, 0, 0);
 
-					_sdf_producer_effect.get_parameter("_image").set_texture(_source_texture);
-					_sdf_producer_effect.get_parameter("_size").set_float2(float(sdfW), float(sdfH));
-					_sdf_producer_effect.get_parameter("_sdf").set_texture(_sdf_texture);
-					_sdf_producer_effect.get_parameter("_threshold").set_float(_sdf_threshold);
+					_producer_parameters.image(_sdf_producer_effect).set_texture(_source_texture);
+					_producer_parameters.size(_sdf_producer_effect).set_float2(float(sdfW), float(sdfH));
+					_producer_parameters.sdf(_sdf_producer_effect).set_texture(_sdf_texture);
+					_producer_parameters.threshold(_sdf_producer_effect).set_float(_sdf_threshold);
 
 					while (gs_effect_loop(_sdf_producer_effect.get_object(), "Draw")) {
 						_gfx_util->draw_fullscreen_triangle();
 					}
 				}
-				std::swap(_sdf_read, _sdf_write);
+				_sdf_read = std::move(sdf_write);
 				_sdf_read->get_texture(_sdf_texture);
 				if (!_sdf_texture) {
 					throw std::runtime_error("SDF Backbuffer empty");
@@ -420,12 +422,14 @@ void sdf_effects_instance::video_render(gs_effect_t* effect)
 		//   Outline
 
 		// Optimized Render path.
+		std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
 		try {
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 			streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_convert, "Calculate"};
 #endif
 
-			auto op = _output_rt->render(baseW, baseH);
+			rt      = _pool->acquire(baseW, baseH);
+			auto op = rt->render(baseW, baseH);
 			gs_ortho(0, 1, 0, 1, 0, 1);
 
 			gs_enable_blending(false);
@@ -441,62 +445,62 @@ void sdf_effects_instance::video_render(gs_effect_t* effect)
 			gs_enable_blending(true);
 			gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_ONE);
 			if (_outer_shadow) {
-				_sdf_consumer_effect.get_parameter("pSDFTexture").set_texture(_sdf_texture);
-				_sdf_consumer_effect.get_parameter("pSDFThreshold").set_float(_sdf_threshold);
-				_sdf_consumer_effect.get_parameter("pImageTexture").set_texture(_source_texture->get_object());
-				_sdf_consumer_effect.get_parameter("pShadowColor").set_float4(_outer_shadow_color);
-				_sdf_consumer_effect.get_parameter("pShadowMin").set_float(_outer_shadow_range_min);
-				_sdf_consumer_effect.get_parameter("pShadowMax").set_float(_outer_shadow_range_max);
-				_sdf_consumer_effect.get_parameter("pShadowOffset").set_float2(_outer_shadow_offset_x / float(baseW), _outer_shadow_offset_y / float(baseH));
+				_consumer_parameters.sdf_texture(_sdf_consumer_effect).set_texture(_sdf_texture);
+				_consumer_parameters.sdf_threshold(_sdf_consumer_effect).set_float(_sdf_threshold);
+				_consumer_parameters.image_texture(_sdf_consumer_effect).set_texture(_source_texture->get_object());
+				_consumer_parameters.shadow_color(_sdf_consumer_effect).set_float4(_outer_shadow_color);
+				_consumer_parameters.shadow_min(_sdf_consumer_effect).set_float(_outer_shadow_range_min);
+				_consumer_parameters.shadow_max(_sdf_consumer_effect).set_float(_outer_shadow_range_max);
+				_consumer_parameters.shadow_offset(_sdf_consumer_effect).set_float2(_outer_shadow_offset_x / float(baseW), _outer_shadow_offset_y / float(baseH));
 				while (gs_effect_loop(_sdf_consumer_effect.get_object(), "ShadowOuter")) {
 					_gfx_util->draw_fullscreen_triangle();
 				}
 			}
 			if (_inner_shadow) {
-				_sdf_consumer_effect.get_parameter("pSDFTexture").set_texture(_sdf_texture);
-				_sdf_consumer_effect.get_parameter("pSDFThreshold").set_float(_sdf_threshold);
-				_sdf_consumer_effect.get_parameter("pImageTexture").set_texture(_source_texture->get_object());
-				_sdf_consumer_effect.get_parameter("pShadowColor").set_float4(_inner_shadow_color);
-				_sdf_consumer_effect.get_parameter("pShadowMin").set_float(_inner_shadow_range_min);
-				_sdf_consumer_effect.get_parameter("pShadowMax").set_float(_inner_shadow_range_max);
-				_sdf_consumer_effect.get_parameter("pShadowOffset").set_float2(_inner_shadow_offset_x / float(baseW), _inner_shadow_offset_y / float(baseH));
+				_consumer_parameters.sdf_texture(_sdf_consumer_effect).set_texture(_sdf_texture);
+				_consumer_parameters.sdf_threshold(_sdf_consumer_effect).set_float(_sdf_threshold);
+				_consumer_parameters.image_texture(_sdf_consumer_effect).set_texture(_source_texture->get_object());
+				_consumer_parameters.shadow_color(_sdf_consumer_effect).set_float4(_inner_shadow_color);
+				_consumer_parameters.shadow_min(_sdf_consumer_effect).set_float(_inner_shadow_range_min);
+				_consumer_parameters.shadow_max(_sdf_consumer_effect).set_float(_inner_shadow_range_max);
+				_consumer_parameters.shadow_offset(_sdf_consumer_effect).set_float2(_inner_shadow_offset_x / float(baseW), _inner_shadow_offset_y / float(baseH));
 				while (gs_effect_loop(_sdf_consumer_effect.get_object(), "ShadowInner")) {
 					_gfx_util->draw_fullscreen_triangle();
 				}
 			}
 			if (_outer_glow) {
-				_sdf_consumer_effect.get_parameter("pSDFTexture").set_texture(_sdf_texture);
-				_sdf_consumer_effect.get_parameter("pSDFThreshold").set_float(_sdf_threshold);
-				_sdf_consumer_effect.get_parameter("pImageTexture").set_texture(_source_texture->get_object());
-				_sdf_consumer_effect.get_parameter("pGlowColor").set_float4(_outer_glow_color);
-				_sdf_consumer_effect.get_parameter("pGlowWidth").set_float(_outer_glow_width);
-				_sdf_consumer_effect.get_parameter("pGlowSharpness").set_float(_outer_glow_sharpness);
-				_sdf_consumer_effect.get_parameter("pGlowSharpnessInverse").set_float(_outer_glow_sharpness_inv);
+				_consumer_parameters.sdf_texture(_sdf_consumer_effect).set_texture(_sdf_texture);
+				_consumer_parameters.sdf_threshold(_sdf_consumer_effect).set_float(_sdf_threshold);
+				_consumer_parameters.image_texture(_sdf_consumer_effect).set_texture(_source_texture->get_object());
+				_consumer_parameters.glow_color(_sdf_consumer_effect).set_float4(_outer_glow_color);
+				_consumer_parameters.glow_width(_sdf_consumer_effect).set_float(_outer_glow_width);
+				_consumer_parameters.glow_sharpness(_sdf_consumer_effect).set_float(_outer_glow_sharpness);
+				_consumer_parameters.glow_sharpness_inverse(_sdf_consumer_effect).set_float(_outer_glow_sharpness_inv);
 				while (gs_effect_loop(_sdf_consumer_effect.get_object(), "GlowOuter")) {
 					_gfx_util->draw_fullscreen_triangle();
 				}
 			}
 			if (_inner_glow) {
-				_sdf_consumer_effect.get_parameter("pSDFTexture").set_texture(_sdf_texture);
-				_sdf_consumer_effect.get_parameter("pSDFThreshold").set_float(_sdf_threshold);
-				_sdf_consumer_effect.get_parameter("pImageTexture").set_texture(_source_texture->get_object());
-				_sdf_consumer_effect.get_parameter("pGlowColor").set_float4(_inner_glow_color);
-				_sdf_consumer_effect.get_parameter("pGlowWidth").set_float(_inner_glow_width);
-				_sdf_consumer_effect.get_parameter("pGlowSharpness").set_float(_inner_glow_sharpness);
-				_sdf_consumer_effect.get_parameter("pGlowSharpnessInverse").set_float(_inner_glow_sharpness_inv);
+				_consumer_parameters.sdf_texture(_sdf_consumer_effect).set_texture(_sdf_texture);
+				_consumer_parameters.sdf_threshold(_sdf_consumer_effect).set_float(_sdf_threshold);
+				_consumer_parameters.image_texture(_sdf_consumer_effect).set_texture(_source_texture->get_object());
+				_consumer_parameters.glow_color(_sdf_consumer_effect).set_float4(_inner_glow_color);
+				_consumer_parameters.glow_width(_sdf_consumer_effect).set_float(_inner_glow_width);
+				_consumer_parameters.glow_sharpness(_sdf_consumer_effect).set_float(_inner_glow_sharpness);
+				_consumer_parameters.glow_sharpness_inverse(_sdf_consumer_effect).set_float(_inner_glow_sharpness_inv);
 				while (gs_effect_loop(_sdf_consumer_effect.get_object(), "GlowInner")) {
 					_gfx_util->draw_fullscreen_triangle();
 				}
 			}
 			if (_outline) {
-				_sdf_consumer_effect.get_parameter("pSDFTexture").set_texture(_sdf_texture);
-				_sdf_consumer_effect.get_parameter("pSDFThreshold").set_float(_sdf_threshold);
-				_sdf_consumer_effect.get_parameter("pImageTexture").set_texture(_source_texture->get_object());
-				_sdf_consumer_effect.get_parameter("pOutlineColor").set_float4(_outline_color);
-				_sdf_consumer_effect.get_parameter("pOutlineWidth").set_float(_outline_width);
-				_sdf_consumer_effect.get_parameter("pOutlineOffset").set_float(_outline_offset);
-				_sdf_consumer_effect.get_parameter("pOutlineSharpness").set_float(_outline_sharpness);
-				_sdf_consumer_effect.get_parameter("pOutlineSharpnessInverse").set_float(_outline_sharpness_inv);
+				_consumer_parameters.sdf_texture(_sdf_consumer_effect).set_texture(_sdf_texture);
+				_consumer_parameters.sdf_threshold(_sdf_consumer_effect).set_float(_sdf_threshold);
+				_consumer_parameters.image_texture(_sdf_consumer_effect).set_texture(_source_texture->get_object());
+				_consumer_parameters.outline_color(_sdf_consumer_effect).set_float4(_outline_color);
+				_consumer_parameters.outline_width(_sdf_consumer_effect).set_float(_outline_width);
+				_consumer_parameters.outline_offset(_sdf_consumer_effect).set_float(_outline_offset);
+				_consumer_parameters.outline_sharpness(_sdf_consumer_effect).set_float(_outline_sharpness);
+				_consumer_parameters.outline_sharpness_inverse(_sdf_consumer_effect).set_float(_outline_sharpness_inv);
 				while (gs_effect_loop(_sdf_consumer_effect.get_object(), "Outline")) {
 					_gfx_util->draw_fullscreen_triangle();
 				}
@@ -504,7 +508,9 @@ void sdf_effects_instance::video_render(gs_effect_t* effect)
 		} catch (...) {
 		}
 
-		_output_rt->get_texture(_output_texture);
+		if (rt) {
+			_output_texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+		}
 
 		gs_blend_state_pop();
 		_output_rendered = true;
@@ -6,7 +6,7 @@
 #include "common.hpp"
 #include "gfx/gfx-util.hpp"
 #include "obs/gs/gs-effect.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-sampler.hpp"
 #include "obs/gs/gs-texture.hpp"
 #include "obs/gs/gs-vertexbuffer.hpp"
@@ -18,22 +18,48 @@ namespace streamfx::filter::sdf_effects {
 		streamfx::obs::gs::effect            _sdf_consumer_effect;
 		std::shared_ptr<streamfx::gfx::util> _gfx_util;
 
+		// Effect Parameters
+		struct {
+			streamfx::obs::gs::effect_parameter_handle image{"_image"};
+			streamfx::obs::gs::effect_parameter_handle size{"_size"};
+			streamfx::obs::gs::effect_parameter_handle sdf{"_sdf"};
+			streamfx::obs::gs::effect_parameter_handle threshold{"_threshold"};
+		} _producer_parameters;
+		struct {
+			streamfx::obs::gs::effect_parameter_handle sdf_texture{"pSDFTexture"};
+			streamfx::obs::gs::effect_parameter_handle sdf_threshold{"pSDFThreshold"};
+			streamfx::obs::gs::effect_parameter_handle image_texture{"pImageTexture"};
+			streamfx::obs::gs::effect_parameter_handle shadow_color{"pShadowColor"};
+			streamfx::obs::gs::effect_parameter_handle shadow_min{"pShadowMin"};
+			streamfx::obs::gs::effect_parameter_handle shadow_max{"pShadowMax"};
+			streamfx::obs::gs::effect_parameter_handle shadow_offset{"pShadowOffset"};
+			streamfx::obs::gs::effect_parameter_handle glow_color{"pGlowColor"};
+			streamfx::obs::gs::effect_parameter_handle glow_width{"pGlowWidth"};
+			streamfx::obs::gs::effect_parameter_handle glow_sharpness{"pGlowSharpness"};
+			streamfx::obs::gs::effect_parameter_handle glow_sharpness_inverse{"pGlowSharpnessInverse"};
+			streamfx::obs::gs::effect_parameter_handle outline_color{"pOutlineColor"};
+			streamfx::obs::gs::effect_parameter_handle outline_width{"pOutlineWidth"};
+			streamfx::obs::gs::effect_parameter_handle outline_offset{"pOutlineOffset"};
+			streamfx::obs::gs::effect_parameter_handle outline_sharpness{"pOutlineSharpness"};
+			streamfx::obs::gs::effect_parameter_handle outline_sharpness_inverse{"pOutlineSharpnessInverse"};
+		} _consumer_parameters;
+
+		// Render Targets, borrowed until the next tick.
+		std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+
 		// Input
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _source_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _source_texture;
-		bool                                             _source_rendered;
+		std::shared_ptr<streamfx::obs::gs::texture> _source_texture;
+		bool                                        _source_rendered;
 
-		// Distance Field
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _sdf_write;
+		// Distance Field, which is refined over multiple frames and thus kept between them.
 		std::shared_ptr<streamfx::obs::gs::rendertarget> _sdf_read;
 		std::shared_ptr<streamfx::obs::gs::texture>      _sdf_texture;
 		double_t                                         _sdf_scale;
-		float                                          _sdf_threshold;
+		float                                            _sdf_threshold;
 
 		// Effects
-		bool                                             _output_rendered;
-		std::shared_ptr<streamfx::obs::gs::texture>      _output_texture;
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _output_rt;
+		bool                                        _output_rendered;
+		std::shared_ptr<streamfx::obs::gs::texture> _output_texture;
 		/// Inner Shadow
 		bool    _inner_shadow;
 		vec4    _inner_shadow_color;
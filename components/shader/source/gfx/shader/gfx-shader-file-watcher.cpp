@@ -0,0 +1,155 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gfx-shader-file-watcher.hpp"
+#include "plugin.hpp"
+#include "util/util-logging.hpp"
+
+#include "warning-disable.hpp"
+#include <vector>
+#include "warning-enable.hpp"
+
+#ifdef _DEBUG
+#define ST_PREFIX "<%s> "
+#define D_LOG_ERROR(x, ...) P_LOG_ERROR(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_WARNING(x, ...) P_LOG_WARN(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_INFO(x, ...) P_LOG_INFO(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_DEBUG(x, ...) P_LOG_DEBUG(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#else
+#define ST_PREFIX "<gfx::shader::file_watcher> "
+#define D_LOG_ERROR(...) P_LOG_ERROR(ST_PREFIX __VA_ARGS__)
+#define D_LOG_WARNING(...) P_LOG_WARN(ST_PREFIX __VA_ARGS__)
+#define D_LOG_INFO(...) P_LOG_INFO(ST_PREFIX __VA_ARGS__)
+#define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
+#endif
+
+// Time between checks of the watched files.
+#define ST_INTERVAL std::chrono::milliseconds(333)
+
+using namespace streamfx::gfx::shader;
+
+file_watcher::subscription::subscription() : _changed(false) {}
+
+bool file_watcher::subscription::changed()
+{
+	return _changed;
+}
+
+file_watcher::file_watcher() : _lock(), _files(), _task(), _next_check(std::chrono::steady_clock::now()) {}
+
+file_watcher::~file_watcher() = default;
+
+void file_watcher::check()
+{
+	// Copy the last known state of all files, so that no file is accessed with the lock held.
+	std::vector<std::pair<std::filesystem::path, streamfx::obs::gs::effect_file_stamp>> files;
+	{
+		std::unique_lock<decltype(_lock)> lock(_lock);
+		for (auto iter = _files.begin(); iter != _files.end();) {
+			iter->second.subscribers.remove_if([](const std::weak_ptr<subscription>& v) { return v.expired(); });
+			if (iter->second.subscribers.empty()) {
+				iter = _files.erase(iter);
+			} else {
+				files.emplace_back(iter->first, iter->second.stamp);
+				++iter;
+			}
+		}
+	}
+
+	for (auto& kv : files) {
+		streamfx::obs::gs::effect_file_stamp stamp;
+		try {
+			// Only read files again that the file system reports as modified.
+			std::error_code ec;
+			auto            time = std::filesystem::last_write_time(kv.first, ec);
+			if (ec) {
+				if (!kv.second.exists) {
+					continue;
+				}
+			} else if (kv.second.exists && (time == kv.second.time) && (std::filesystem::file_size(kv.first) == kv.second.size)) {
+				continue;
+			}
+
+			stamp = streamfx::obs::gs::effect_file_stamp::read(kv.first);
+		} catch (const std::exception& ex) {
+			D_LOG_WARNING("Failed to check '%s' for changes: %s", kv.first.generic_u8string().c_str(), ex.what());
+			continue;
+		}
+
+		std::unique_lock<decltype(_lock)> lock(_lock);
+		auto                              iter = _files.find(kv.first);
+		if (iter == _files.end()) {
+			continue;
+		}
+
+		// A file that was written without changing its content only needs its new time remembered.
+		bool changed       = (iter->second.stamp != stamp);
+		iter->second.stamp = stamp;
+		if (changed) {
+			D_LOG_DEBUG("'%s' changed, notifying %zu subscriber(s).", kv.first.generic_u8string().c_str(), iter->second.subscribers.size());
+			for (auto& weak : iter->second.subscribers) {
+				if (auto sub = weak.lock(); sub) {
+					sub->_changed = true;
+				}
+			}
+		}
+	}
+}
+
+std::shared_ptr<file_watcher::subscription> file_watcher::watch(const streamfx::obs::gs::effect_dependencies_t& files)
+{
+	auto sub = std::make_shared<subscription>();
+
+	std::unique_lock<decltype(_lock)> lock(_lock);
+	for (auto& kv : files) {
+		auto [iter, inserted] = _files.try_emplace(kv.first);
+		if (inserted) {
+			iter->second.stamp = kv.second;
+		} else if (iter->second.stamp != kv.second) {
+			// Everyone who read the file before saw different content than was just read.
+			iter->second.stamp = kv.second;
+			for (auto& weak : iter->second.subscribers) {
+				if (auto other = weak.lock(); other) {
+					other->_changed = true;
+				}
+			}
+		}
+		iter->second.subscribers.push_back(sub);
+	}
+
+	return sub;
+}
+
+void file_watcher::poll()
+{
+	auto now = std::chrono::steady_clock::now();
+
+	std::unique_lock<decltype(_lock)> lock(_lock);
+	if ((now < _next_check) || (_task && !_task->is_completed()) || _files.empty()) {
+		return;
+	}
+	_next_check = now + ST_INTERVAL;
+
+	_task = streamfx::threadpool()->push(
+		[wself = weak_from_this()](streamfx::util::threadpool::task_data_t) {
+			if (auto self = wself.lock(); self) {
+				self->check();
+			}
+		},
+		nullptr, streamfx::util::threadpool::priority::BACKGROUND);
+}
+
+std::shared_ptr<streamfx::gfx::shader::file_watcher> file_watcher::instance()
+{
+	static std::weak_ptr<streamfx::gfx::shader::file_watcher> winst;
+	static std::mutex                                         mtx;
+
+	std::unique_lock<decltype(mtx)> lock(mtx);
+	auto                            instance = winst.lock();
+	if (!instance) {
+		instance = std::shared_ptr<streamfx::gfx::shader::file_watcher>(new streamfx::gfx::shader::file_watcher());
+		winst    = instance;
+	}
+	return instance;
+}
@@ -0,0 +1,77 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+#include "obs/gs/gs-effect.hpp"
+#include "util/util-threadpool.hpp"
+
+#include "warning-disable.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "warning-enable.hpp"
+
+namespace streamfx::gfx::shader {
+	/** Watches the files that shaders were read from, including everything they include.
+	 *
+	 * Every file is checked once per interval on a worker thread, no matter how many shaders read it. Only a change
+	 * to the content of a file is reported, and only to the shaders that read that file.
+	 */
+	class file_watcher : public std::enable_shared_from_this<file_watcher> {
+		public:
+		class subscription {
+			std::atomic<bool> _changed;
+
+			public:
+			subscription();
+
+			/** Whether any of the watched files changed since they were read.
+			 */
+			bool changed();
+
+			friend class file_watcher;
+		};
+
+		private:
+		struct file {
+			streamfx::obs::gs::effect_file_stamp   stamp; // Last known state of the file.
+			std::list<std::weak_ptr<subscription>> subscribers;
+		};
+
+		std::mutex                                        _lock;
+		std::map<std::filesystem::path, file>             _files;
+		std::shared_ptr<streamfx::util::threadpool::task> _task;
+		std::chrono::steady_clock::time_point             _next_check;
+
+		private:
+		file_watcher();
+
+		/** Check all watched files for changes, on a worker thread.
+		 */
+		void check();
+
+		public:
+		~file_watcher();
+
+		/** Watch the given files for changes to the content they had when they were read.
+		 *
+		 * The files are watched for as long as the subscription is kept alive.
+		 */
+		std::shared_ptr<subscription> watch(const streamfx::obs::gs::effect_dependencies_t& files);
+
+		/** Start checking the watched files if they have not been checked recently.
+		 *
+		 * Meant to be called every tick by everything that holds a subscription. Returns immediately.
+		 */
+		void poll();
+
+		public /* Singleton */:
+		static std::shared_ptr<streamfx::gfx::shader::file_watcher> instance();
+	};
+} // namespace streamfx::gfx::shader
@@ -59,7 +59,7 @@ streamfx::gfx::shader::texture_field_type streamfx::gfx::shader::get_texture_fie
 	return texture_field_type::Input;
 }
 
-streamfx::gfx::shader::texture_parameter::texture_parameter(streamfx::gfx::shader::shader* parent, streamfx::obs::gs::effect_parameter param, std::string prefix) : parameter(parent, param, prefix), _field_type(texture_field_type::Input), _keys(), _values(), _type(texture_type::File), _active(false), _visible(false), _dirty(true), _dirty_ts(std::chrono::high_resolution_clock::now()), _file_path(), _file_texture(), _source_name(), _source(), _source_child(), _source_active(), _source_visible(), _source_rendertarget()
+streamfx::gfx::shader::texture_parameter::texture_parameter(streamfx::gfx::shader::shader* parent, streamfx::obs::gs::effect_parameter param, std::string prefix) : parameter(parent, param, prefix), _field_type(texture_field_type::Input), _keys(), _values(), _type(texture_type::File), _active(false), _visible(false), _dirty(true), _dirty_ts(std::chrono::high_resolution_clock::now()), _file_path(), _file_texture(), _source_name(), _source(), _source_child(), _source_active(), _source_visible(), _source_cache(), _source_texture()
 {
 	char string_buffer[256];
 
@@ -249,7 +249,7 @@ void streamfx::gfx::shader::texture_parameter::update(obs_data_t* settings)
 	}
 }
 
-void streamfx::gfx::shader::texture_parameter::assign()
+void streamfx::gfx::shader::texture_parameter::prepare()
 {
 	if (is_automatic())
 		return;
@@ -263,7 +263,8 @@ void streamfx::gfx::shader::texture_parameter::assign()
 			_source_child.reset();
 			_source_active.reset();
 			_source_visible.reset();
-			_source_rendertarget.reset();
+			_source_cache.reset();
+			_source_texture.reset();
 			_file_texture.reset();
 
 			if (((field_type() == texture_field_type::Input) && (_type == texture_type::File)) || (field_type() == texture_field_type::Enum)) {
@@ -290,15 +291,12 @@ void streamfx::gfx::shader::texture_parameter::assign()
 					visible = ::streamfx::obs::source_showing_reference::add_showing_reference(source);
 				}
 
-				// Create the necessary render target to capture the source.
-				auto rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-
 				// Propagate all of this into the storage.
-				_source_rendertarget = rt;
-				_source_visible      = std::move(visible);
-				_source_active       = std::move(active);
-				_source_child        = child;
-				_source              = source;
+				_source_cache   = streamfx::gfx::source_capture_cache::instance();
+				_source_visible = std::move(visible);
+				_source_active  = std::move(active);
+				_source_child   = child;
+				_source         = source;
 			}
 
 			_dirty = false;
@@ -310,41 +308,25 @@ void streamfx::gfx::shader::texture_parameter::assign()
 	}
 
 	// If this is a source and active or visible, capture it.
-	if ((_type == texture_type::Source) && (_active || _visible) && _source_rendertarget) {
+	if ((_type == texture_type::Source) && (_active || _visible) && _source_cache) {
 		auto source = _source.lock();
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 		::streamfx::obs::gs::debug_marker profiler1{::streamfx::obs::gs::debug_color_capture, "Parameter '%s'", get_key().data()};
 		::streamfx::obs::gs::debug_marker profiler2{::streamfx::obs::gs::debug_color_capture, "Capture '%s'", source.name().data()};
 #endif
-		uint32_t width  = source.width();
-		uint32_t height = source.height();
-
-		auto op = _source_rendertarget->render(width, height);
-
-		gs_matrix_push();
-		gs_ortho(0, static_cast<float>(width), 0, static_cast<float>(height), 0, 1);
-
-		// ToDo: Figure out if this breaks some sources.
-		gs_blend_state_push();
-		gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
-		gs_enable_blending(false);
-
-		gs_enable_color(true, true, true, true);
-
-		obs_source_video_render(source.get());
-
-		gs_blend_state_pop();
-		gs_matrix_pop();
+		// Other parameters and filters showing the same source this frame share a single capture of it.
+		_source_texture = _source_cache->capture(source.get(), source.width(), source.height());
 	}
+}
+
+void streamfx::gfx::shader::texture_parameter::assign()
+{
+	if (is_automatic())
+		return;
 
 	if (_type == texture_type::Source) {
-		if (_source_rendertarget) {
-			auto tex = _source_rendertarget->get_texture();
-			if (tex) {
-				get_parameter().set_texture(_source_rendertarget->get_texture(), false);
-			} else {
-				get_parameter().set_texture(nullptr, false);
-			}
+		if (_source_texture) {
+			get_parameter().set_texture(_source_texture, false);
 		} else {
 			get_parameter().set_texture(nullptr, false);
 		}
@@ -358,6 +340,12 @@ void streamfx::gfx::shader::texture_parameter::assign()
 	}
 }
 
+bool streamfx::gfx::shader::texture_parameter::is_dynamic()
+{
+	// Files never change once loaded, unlike sources. Until then, they may finish loading in any frame.
+	return _dirty || ((_type == texture_type::Source) && (field_type() == texture_field_type::Input));
+}
+
 void streamfx::gfx::shader::texture_parameter::visible(bool visible)
 {
 	_visible = visible;
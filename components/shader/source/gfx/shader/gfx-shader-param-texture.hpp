@@ -7,7 +7,7 @@
 #pragma once
 #include "common.hpp"
 #include "gfx-shader-param.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "gfx/gfx-source-capture-cache.hpp"
 #include "obs/gs/gs-texture.hpp"
 #include "obs/obs-source-active-child.hpp"
 #include "obs/obs-source-active-reference.hpp"
@@ -71,7 +71,8 @@ namespace streamfx::gfx {
 			std::shared_ptr<streamfx::obs::source_active_child>      _source_child;
 			std::shared_ptr<streamfx::obs::source_active_reference>  _source_active;
 			std::shared_ptr<streamfx::obs::source_showing_reference> _source_visible;
-			std::shared_ptr<streamfx::obs::gs::rendertarget>         _source_rendertarget;
+			std::shared_ptr<streamfx::gfx::source_capture_cache>     _source_cache;
+			std::shared_ptr<streamfx::obs::gs::texture>              _source_texture;
 
 			public:
 			texture_parameter(streamfx::gfx::shader::shader* parent, streamfx::obs::gs::effect_parameter param, std::string prefix);
@@ -85,8 +86,12 @@ namespace streamfx::gfx {
 
 			void update(obs_data_t* settings) override;
 
+			void prepare() override;
+
 			void assign() override;
 
+			bool is_dynamic() override;
+
 			void visible(bool visible) override;
 
 			void active(bool enabled) override;
@@ -165,8 +165,15 @@ void streamfx::gfx::shader::parameter::properties(obs_properties_t* props, obs_d
 
 void streamfx::gfx::shader::parameter::update(obs_data_t* settings) {}
 
+void streamfx::gfx::shader::parameter::prepare() {}
+
 void streamfx::gfx::shader::parameter::assign() {}
 
+bool streamfx::gfx::shader::parameter::is_dynamic()
+{
+	return false;
+}
+
 void streamfx::gfx::shader::parameter::visible(bool visible) {}
 
 void streamfx::gfx::shader::parameter::active(bool active) {}
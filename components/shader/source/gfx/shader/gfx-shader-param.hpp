@@ -75,8 +75,16 @@ namespace streamfx::gfx {
 
 			virtual void update(obs_data_t* settings);
 
+			/** Render whatever the parameter needs for this frame, before any parameter is assigned.
+			 */
+			virtual void prepare();
+
 			virtual void assign();
 
+			/** Whether the value changes from frame to frame on its own, like the content of a source does.
+			 */
+			virtual bool is_dynamic();
+
 			virtual void visible(bool visible);
 
 			virtual void active(bool enabled);
@@ -35,16 +35,46 @@
 #define ST_I18N_PARAMETERS ST_I18N ".Parameters"
 #define ST_KEY_PARAMETERS "Shader.Parameters"
 
+// Built-in parameters whose value changes from frame to frame on their own.
+static constexpr std::string_view dynamic_parameters[] = {
+	"Time", "Random", "TransitionTime", "InputA", "image", "tex_a", "InputB", "image2", "tex_b",
+};
+
+// Each mode assigns a different set of built-in parameters, so effects are only shared between shaders of one mode.
+static std::string_view get_mode_key(streamfx::gfx::shader::shader_mode mode)
+{
+	switch (mode) {
+	case streamfx::gfx::shader::shader_mode::Source:
+		return "Source";
+	case streamfx::gfx::shader::shader_mode::Filter:
+		return "Filter";
+	case streamfx::gfx::shader::shader_mode::Transition:
+		return "Transition";
+	}
+	return {};
+}
+
+struct streamfx::gfx::shader::shader::reload {
+	// Input
+	std::filesystem::path file;
+	int                   device_type;
+
+	// Output
+	std::string                              code;
+	streamfx::obs::gs::effect_dependencies_t dependencies;
+	std::string                              error;
+};
+
 streamfx::gfx::shader::shader::shader(obs_source_t* self, shader_mode mode)
 	: _self(self), _gfx_util(::streamfx::gfx::util::get()), _mode(mode), _base_width(1), _base_height(1), _active(true),
 
-	  _shader(), _shader_file(), _shader_tech("Draw"), _shader_file_mt(), _shader_file_sz(), _shader_file_tick(0),
+	  _shader(), _shader_file(), _shader_tech("Draw"), _watcher(streamfx::gfx::shader::file_watcher::instance()), _shader_watch(), _reload(), _reload_task(),
 
 	  _width_type(size_type::Percent), _width_value(1.0), _height_type(size_type::Percent), _height_value(1.0),
 
 	  _have_current_params(false), _time(0), _time_loop(0), _loops(0), _random(), _random_seed(0),
 
-	  _rt_up_to_date(false), _rt(std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA_UNORM, GS_ZS_NONE))
+	  _rt_up_to_date(false), _rt_static(false), _rt_width(0), _rt_height(0), _rt(std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA_UNORM, GS_ZS_NONE))
 {
 	// Initialize random values.
 	_random.seed(static_cast<unsigned long long>(_random_seed));
@@ -57,28 +87,12 @@ streamfx::gfx::shader::shader::~shader() = default;
 
 bool streamfx::gfx::shader::shader::is_shader_different(const std::filesystem::path& file)
 {
-	try {
-		if (std::filesystem::exists(file)) {
-			// Check if the file name differs.
-			if (file != _shader_file)
-				return true;
-		}
-
-		if (std::filesystem::exists(_shader_file)) {
-			// Is the file write time different?
-			if (std::filesystem::last_write_time(_shader_file) != _shader_file_mt)
-				return true;
-
-			// Is the file size different?
-			if (std::filesystem::file_size(_shader_file) != _shader_file_sz)
-				return true;
-		}
+	// Check if the file name differs.
+	if (file != _shader_file)
+		return true;
 
-		return false;
-	} catch (const std::exception& ex) {
-		DLOG_ERROR("Loading shader '%s' failed with error: %s", file.c_str(), ex.what());
-		return false;
-	}
+	// Did the file or anything it includes change?
+	return _shader_watch && _shader_watch->changed();
 }
 
 bool streamfx::gfx::shader::shader::is_technique_different(std::string_view tech)
@@ -101,64 +115,16 @@ bool streamfx::gfx::shader::shader::load_shader(const std::filesystem::path& fil
 
 		// Update Shader
 		if (shader_dirty) {
-			_shader           = streamfx::obs::gs::effect(file);
-			_shader_file_mt   = std::filesystem::last_write_time(file);
-			_shader_file_sz   = std::filesystem::file_size(file);
-			_shader_file      = file;
-			_shader_file_tick = 0;
+			streamfx::obs::gs::effect_dependencies_t dependencies;
+			auto code     = streamfx::obs::gs::effect::preprocess(file, streamfx::obs::gs::effect::get_device_type(), &dependencies);
+			_shader       = streamfx::obs::gs::effect::shared(code, streamfx::obs::gs::effect::get_name(file), get_mode_key(_mode));
+			_shader_watch = _watcher->watch(dependencies);
+			_shader_file  = file;
 		}
 
 		// Update Params
 		if (param_dirty) {
-			auto settings = std::shared_ptr<obs_data_t>(obs_source_get_settings(_self), [](obs_data_t* p) { obs_data_release(p); });
-
-			bool have_valid_tech = false;
-			for (std::size_t idx = 0; idx < _shader.count_techniques(); idx++) {
-				if (_shader.get_technique(idx).name() == tech) {
-					have_valid_tech = true;
-					break;
-				}
-			}
-			if (have_valid_tech) {
-				_shader_tech = tech;
-			} else {
-				_shader_tech = _shader.get_technique(0).name();
-
-				// Update source data.
-				obs_data_set_string(settings.get(), ST_KEY_SHADER_TECHNIQUE, _shader_tech.c_str());
-			}
-
-			// Clear the shader parameters map and rebuild.
-			_shader_params.clear();
-			auto etech = _shader.get_technique(_shader_tech);
-			for (std::size_t idx = 0; idx < etech.count_passes(); idx++) {
-				auto pass         = etech.get_pass(idx);
-				auto fetch_params = [&](std::size_t count, std::function<streamfx::obs::gs::effect_parameter(std::size_t)> get_func) {
-					for (std::size_t vidx = 0; vidx < count; vidx++) {
-						auto el = get_func(vidx);
-						if (!el)
-							continue;
-
-						auto el_name = el.get_name();
-						auto fnd     = _shader_params.find(el_name);
-						if (fnd != _shader_params.end())
-							continue;
-
-						auto param = streamfx::gfx::shader::parameter::make_parameter(this, el, ST_KEY_PARAMETERS);
-
-						if (param) {
-							_shader_params.insert_or_assign(el_name, param);
-							param->defaults(settings.get());
-							param->update(settings.get());
-						}
-					}
-				};
-
-				auto gvp = [&](std::size_t idx) { return pass.get_vertex_parameter(idx); };
-				fetch_params(pass.count_vertex_parameters(), gvp);
-				auto gpp = [&](std::size_t idx) { return pass.get_pixel_parameter(idx); };
-				fetch_params(pass.count_pixel_parameters(), gpp);
-			}
+			load_parameters(tech);
 		}
 
 		return true;
@@ -170,6 +136,101 @@ bool streamfx::gfx::shader::shader::load_shader(const std::filesystem::path& fil
 	}
 }
 
+void streamfx::gfx::shader::shader::load_parameters(std::string_view tech)
+{
+	auto settings = std::shared_ptr<obs_data_t>(obs_source_get_settings(_self), [](obs_data_t* p) { obs_data_release(p); });
+
+	bool have_valid_tech = false;
+	for (std::size_t idx = 0; idx < _shader.count_techniques(); idx++) {
+		if (_shader.get_technique(idx).name() == tech) {
+			have_valid_tech = true;
+			break;
+		}
+	}
+	if (have_valid_tech) {
+		_shader_tech = tech;
+	} else {
+		_shader_tech = _shader.get_technique(0).name();
+
+		// Update source data.
+		obs_data_set_string(settings.get(), ST_KEY_SHADER_TECHNIQUE, _shader_tech.c_str());
+	}
+
+	// Clear the shader parameters map and rebuild.
+	_shader_params.clear();
+	_rt_static     = true;
+	_rt_up_to_date = false;
+	auto etech     = _shader.get_technique(_shader_tech);
+	for (std::size_t idx = 0; idx < etech.count_passes(); idx++) {
+		auto pass         = etech.get_pass(idx);
+		auto fetch_params = [&](std::size_t count, std::function<streamfx::obs::gs::effect_parameter(std::size_t)> get_func) {
+			for (std::size_t vidx = 0; vidx < count; vidx++) {
+				auto el = get_func(vidx);
+				if (!el)
+					continue;
+
+				auto el_name = el.get_name();
+				if (std::find(std::begin(dynamic_parameters), std::end(dynamic_parameters), el_name) != std::end(dynamic_parameters)) {
+					_rt_static = false;
+				}
+
+				auto fnd = _shader_params.find(el_name);
+				if (fnd != _shader_params.end())
+					continue;
+
+				auto param = streamfx::gfx::shader::parameter::make_parameter(this, el, ST_KEY_PARAMETERS);
+
+				if (param) {
+					_shader_params.insert_or_assign(el_name, param);
+					param->defaults(settings.get());
+					param->update(settings.get());
+				}
+			}
+		};
+
+		auto gvp = [&](std::size_t idx) { return pass.get_vertex_parameter(idx); };
+		fetch_params(pass.count_vertex_parameters(), gvp);
+		auto gpp = [&](std::size_t idx) { return pass.get_pixel_parameter(idx); };
+		fetch_params(pass.count_pixel_parameters(), gpp);
+	}
+}
+
+void streamfx::gfx::shader::shader::check_reload(std::shared_ptr<reload> state)
+{
+	try {
+		state->code = streamfx::obs::gs::effect::preprocess(state->file, state->device_type, &state->dependencies);
+	} catch (const std::exception& ex) {
+		state->error = ex.what();
+	}
+}
+
+void streamfx::gfx::shader::shader::finish_reload()
+{
+	auto state = std::move(_reload);
+	_reload_task.reset();
+
+	// Skip results for a file that has been replaced in the meantime.
+	if (state->file != _shader_file)
+		return;
+
+	// Watch whatever was read even if it failed to load, so that the error is only reported again once it changes.
+	_shader_watch = _watcher->watch(state->dependencies);
+
+	if (!state->error.empty()) {
+		DLOG_ERROR("Loading shader '%s' failed with error: %s", state->file.c_str(), state->error.c_str());
+		return;
+	}
+
+	try {
+		// The current shader keeps being used until its replacement compiled successfully.
+		_shader = streamfx::obs::gs::effect::shared(state->code, streamfx::obs::gs::effect::get_name(state->file), get_mode_key(_mode));
+		load_parameters(std::string(_shader_tech));
+		_rt_up_to_date = false;
+	} catch (const std::exception& ex) {
+		DLOG_ERROR("Loading shader '%s' failed with error: %s", state->file.c_str(), ex.what());
+	}
+}
+
 void streamfx::gfx::shader::shader::defaults(obs_data_t* data)
 {
 	obs_data_set_default_string(data, ST_KEY_SHADER_FILE, "");
@@ -351,6 +412,9 @@ void streamfx::gfx::shader::shader::update(obs_data_t* data)
 		kv.second->defaults(data);
 		kv.second->update(data);
 	}
+
+	// Any setting may have changed the output.
+	_rt_up_to_date = false;
 }
 
 uint32_t streamfx::gfx::shader::shader::width()
@@ -401,11 +465,16 @@ uint32_t streamfx::gfx::shader::shader::base_height()
 
 bool streamfx::gfx::shader::shader::tick(float time)
 {
-	_shader_file_tick = static_cast<float>(static_cast<double_t>(_shader_file_tick) + static_cast<double_t>(time));
-	if (_shader_file_tick >= 1.0f / 3.0f) {
-		_shader_file_tick -= 1.0f / 3.0f;
-		bool v1, v2;
-		load_shader(_shader_file, _shader_tech, v1, v2);
+	// Files are checked and read on worker threads, as slow disks and network shares would otherwise stall rendering.
+	_watcher->poll();
+	if (_reload_task && _reload_task->is_completed()) {
+		finish_reload();
+	}
+	if (!_reload_task && _shader_watch && _shader_watch->changed()) {
+		_reload              = std::make_shared<reload>();
+		_reload->file        = _shader_file;
+		_reload->device_type = streamfx::obs::gs::effect::get_device_type();
+		_reload_task         = streamfx::threadpool()->push([](streamfx::util::threadpool::task_data_t data) { check_reload(std::static_pointer_cast<reload>(data)); }, _reload, streamfx::util::threadpool::priority::BACKGROUND);
 	}
 
 	// Update State
@@ -425,8 +494,17 @@ bool streamfx::gfx::shader::shader::tick(float time)
 		_random_values[8 + idx] = static_cast<float>(static_cast<double_t>(_random()) / static_cast<double_t>(_random.max()));
 	}
 
-	// Flag Render Target as outdated.
-	_rt_up_to_date = false;
+	// Flag Render Target as outdated, unless the technique reads nothing that changes on its own.
+	if (!_rt_static) {
+		_rt_up_to_date = false;
+	} else {
+		for (auto kv : _shader_params) {
+			if (kv.second->is_dynamic()) {
+				_rt_up_to_date = false;
+				break;
+			}
+		}
+	}
 
 	return false;
 }
@@ -436,6 +514,21 @@ void streamfx::gfx::shader::shader::prepare_render()
 	if (!_shader)
 		return;
 
+	// Capture sources for parameters first, as anything they render may use the same effect as this shader.
+	for (auto kv : _shader_params) {
+		kv.second->prepare();
+	}
+
+	// The effect may be shared with other shaders, so nothing they assigned must remain for this one to read. Anything
+	// that is not assigned by a parameter below is reset, including the inputs of a source that has none.
+	for (std::size_t idx = 0, end = _shader.count_parameters(); idx < end; idx++) {
+		auto el = _shader.get_parameter(idx);
+		if (auto kv = _shader_params.find(el.get_name()); (kv != _shader_params.end()) && !kv->second->is_automatic()) {
+			continue;
+		}
+		el.set_default();
+	}
+
 	// Assign user parameters
 	for (auto kv : _shader_params) {
 		kv.second->assign();
@@ -480,7 +573,7 @@ void streamfx::gfx::shader::shader::render(gs_effect* effect)
 	if (!effect)
 		effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 
-	if (!_rt_up_to_date) {
+	if (!_rt_up_to_date || (_rt_width != width()) || (_rt_height != height())) {
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 		::streamfx::obs::gs::debug_marker profiler1{::streamfx::obs::gs::debug_color_cache, "Render Cache"};
 #endif
@@ -514,6 +607,8 @@ void streamfx::gfx::shader::shader::render(gs_effect* effect)
 		gs_blend_state_pop();
 
 		_rt_up_to_date = true;
+		_rt_width      = width();
+		_rt_height     = height();
 	}
 
 	if (auto tex = _rt->get_texture(); tex) {
@@ -7,9 +7,11 @@
 #pragma once
 #include "common.hpp"
 #include "gfx/gfx-util.hpp"
+#include "gfx/shader/gfx-shader-file-watcher.hpp"
 #include "gfx/shader/gfx-shader-param.hpp"
 #include "obs/gs/gs-effect.hpp"
 #include "obs/gs/gs-rendertarget.hpp"
+#include "util/util-threadpool.hpp"
 
 #include "warning-disable.hpp"
 #include <filesystem>
@@ -34,6 +36,8 @@ namespace streamfx::gfx {
 		typedef std::map<std::string_view, std::shared_ptr<parameter>> shader_param_map_t;
 
 		class shader {
+			struct reload;
+
 			obs_source_t* _self;
 
 			std::shared_ptr<streamfx::gfx::util> _gfx_util;
@@ -46,13 +50,16 @@ namespace streamfx::gfx {
 			bool        _visible;
 
 			// Shader
-			streamfx::obs::gs::effect       _shader;
-			std::filesystem::path           _shader_file;
-			std::string                     _shader_tech;
-			std::filesystem::file_time_type _shader_file_mt;
-			uintmax_t                       _shader_file_sz;
-			float                         _shader_file_tick;
-			shader_param_map_t              _shader_params;
+			streamfx::obs::gs::effect _shader;
+			std::filesystem::path     _shader_file;
+			std::string               _shader_tech;
+			shader_param_map_t        _shader_params;
+
+			// Shader: Background Reload
+			std::shared_ptr<streamfx::gfx::shader::file_watcher>               _watcher;
+			std::shared_ptr<streamfx::gfx::shader::file_watcher::subscription> _shader_watch; // Shader file and all its includes.
+			std::shared_ptr<reload>                                            _reload;
+			std::shared_ptr<streamfx::util::threadpool::task>                  _reload_task;
 
 			// Options
 			size_type _width_type;
@@ -71,6 +78,9 @@ namespace streamfx::gfx {
 
 			// Rendering
 			bool                                             _rt_up_to_date;
+			bool                                             _rt_static; // Output only changes along with settings and size.
+			uint32_t                                         _rt_width;
+			uint32_t                                         _rt_height;
 			std::shared_ptr<streamfx::obs::gs::rendertarget> _rt;
 
 			public:
@@ -83,6 +93,19 @@ namespace streamfx::gfx {
 
 			bool load_shader(const std::filesystem::path& file, std::string_view tech, bool& shader_dirty, bool& param_dirty);
 
+			void load_parameters(std::string_view tech);
+
+			private:
+			/** Read and preprocess the changed shader file, on a worker thread.
+			 */
+			static void check_reload(std::shared_ptr<reload> state);
+
+			/** Compile the result of a completed check and replace the shader with it, on the graphics thread.
+			 */
+			void finish_reload();
+
+			public:
+
 			static void defaults(obs_data_t* data);
 
 			void properties(obs_properties_t* props);
@@ -95,11 +95,11 @@ void shader_instance::video_render(gs_effect_t* effect)
 
 void shader_instance::transition_render(gs_texture_t* a, gs_texture_t* b, float t, uint32_t cx, uint32_t cy)
 {
+	_fx->prepare_render();
 	_fx->set_input_a(std::make_shared<::streamfx::obs::gs::texture>(a, false));
 	_fx->set_input_b(std::make_shared<::streamfx::obs::gs::texture>(b, false));
 	_fx->set_transition_time(t);
 	_fx->set_transition_size(cx, cy);
-	_fx->prepare_render();
 	_fx->render(nullptr);
 }
 
@@ -93,13 +93,11 @@ enum RotationOrder : int64_t {
 	ZYX = 5,
 };
 
-transform_instance::transform_instance(obs_data_t* data, obs_source_t* context) : obs::source_instance(data, context), _gfx_util(::streamfx::gfx::util::get()), _camera_mode(), _camera_fov(), _params(), _corners(), _standard_effect(), _transform_effect(), _sampler(), _cache_rendered(), _mipmap_enabled(), _source_rendered(), _source_size(), _update_mesh(true)
+transform_instance::transform_instance(obs_data_t* data, obs_source_t* context) : obs::source_instance(data, context), _gfx_util(::streamfx::gfx::util::get()), _camera_mode(), _camera_fov(), _params(), _corners(), _standard_effect(), _transform_effect(), _sampler(), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _cache_rendered(), _mipmap_enabled(), _source_rendered(), _source_size(), _update_mesh(true)
 {
 	{
 		auto gctx = obs::gs::context();
 
-		_cache_rt      = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
-		_source_rt     = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
 		_vertex_buffer = std::make_shared<streamfx::obs::gs::vertex_buffer>(uint32_t(4u), uint8_t(1u));
 		{
 			auto file = streamfx::data_file_path("effects/standard.effect");
@@ -142,7 +140,6 @@ transform_instance::transform_instance(obs_data_t* data, obs_source_t* context)
 transform_instance::~transform_instance()
 {
 	_vertex_buffer.reset();
-	_cache_rt.reset();
 	_cache_texture.reset();
 	_mipmap_texture.reset();
 }
@@ -359,6 +356,7 @@ void transform_instance::video_tick(float)
 	_cache_rendered  = false;
 	_mipmap_rendered = false;
 	_source_rendered = false;
+	_cache_texture.reset();
 }
 
 void transform_instance::video_render(gs_effect_t* effect)
@@ -401,7 +399,8 @@ void transform_instance::video_render(gs_effect_t* effect)
 		streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_cache, "Cache"};
 #endif
 
-		auto op = _cache_rt->render(cache_width, cache_height);
+		auto rt = _pool->acquire(cache_width, cache_height);
+		auto op = rt->render(cache_width, cache_height);
 
 		gs_ortho(0, static_cast<float>(base_width), 0, static_cast<float>(base_height), -1, 1);
 
@@ -428,9 +427,9 @@ void transform_instance::video_render(gs_effect_t* effect)
 			return;
 		}
 
+		_cache_texture  = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
 		_cache_rendered = true;
 	}
-	_cache_rt->get_texture(_cache_texture);
 	if (!_cache_texture) {
 		obs_source_skip_video_filter(_self);
 		return;
@@ -458,12 +457,13 @@ void transform_instance::video_render(gs_effect_t* effect)
 		}
 	}
 
+	auto rt = _pool->acquire(base_width, base_height);
 	{
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
 		streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_convert, "Transform"};
 #endif
 
-		auto op = _source_rt->render(base_width, base_height);
+		auto op = rt->render(base_width, base_height);
 
 		vec4 clear_color = {0, 0, 0, 0};
 		gs_clear(GS_CLEAR_COLOR | GS_CLEAR_DEPTH, &clear_color, 0, 0);
@@ -530,8 +530,8 @@ void transform_instance::video_render(gs_effect_t* effect)
 
 		gs_blend_state_pop();
 	}
-	_source_rt->get_texture(_source_texture);
-	if (!_source_texture) {
+	auto source_texture = rt->get_texture();
+	if (!source_texture) {
 		obs_source_skip_video_filter(_self);
 		return;
 	}
@@ -541,7 +541,7 @@ void transform_instance::video_render(gs_effect_t* effect)
 		streamfx::obs::gs::debug_marker gdm{streamfx::obs::gs::debug_color_render, "Render"};
 #endif
 
-		gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), _source_texture->get_object());
+		gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), source_texture->get_object());
 		while (gs_effect_loop(effect, "Draw")) {
 			gs_draw_sprite(nullptr, 0, base_width, base_height);
 		}
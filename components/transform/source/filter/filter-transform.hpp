@@ -6,7 +6,7 @@
 #include "common.hpp"
 #include "gfx/gfx-mipmapper.hpp"
 #include "gfx/gfx-util.hpp"
-#include "obs/gs/gs-rendertarget.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
 #include "obs/gs/gs-texture.hpp"
 #include "obs/gs/gs-vertexbuffer.hpp"
 #include "obs/obs-source-factory.hpp"
@@ -47,10 +47,12 @@ namespace streamfx::filter::transform {
 		streamfx::obs::gs::effect  _transform_effect;
 		streamfx::obs::gs::sampler _sampler;
 
-		// Cache
-		bool                                             _cache_rendered;
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _cache_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _cache_texture;
+		// Render Targets
+		std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+
+		// Cache, borrowed until the next tick.
+		bool                                        _cache_rendered;
+		std::shared_ptr<streamfx::obs::gs::texture> _cache_texture;
 
 		// Mip-mapping
 		bool                                        _mipmap_enabled;
@@ -59,10 +61,8 @@ namespace streamfx::filter::transform {
 		std::shared_ptr<streamfx::obs::gs::texture> _mipmap_texture;
 
 		// Input
-		bool                                             _source_rendered;
-		std::pair<uint32_t, uint32_t>                    _source_size;
-		std::shared_ptr<streamfx::obs::gs::rendertarget> _source_rt;
-		std::shared_ptr<streamfx::obs::gs::texture>      _source_texture;
+		bool                          _source_rendered;
+		std::pair<uint32_t, uint32_t> _source_size;
 
 		// Mesh
 		bool                                              _update_mesh;
@@ -368,7 +368,7 @@ void streamfx::filter::upscaling::upscaling_instance::switch_provider(upscaling_
 	_provider     = provider;
 
 	// Then spawn a new task to switch provider.
-	_provider_task = streamfx::threadpool()->push(std::bind(&upscaling_instance::task_switch_provider, this, std::placeholders::_1), spd);
+	_provider_task = streamfx::threadpool()->push(std::bind(&upscaling_instance::task_switch_provider, this, std::placeholders::_1), spd, streamfx::util::threadpool::priority::INTERACTIVE);
 }
 
 void streamfx::filter::upscaling::upscaling_instance::task_switch_provider(util::threadpool::task_data_t data)
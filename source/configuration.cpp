@@ -72,7 +72,7 @@ void streamfx::configuration::save()
 			if (!obs_data_save_json_safe(_data.get(), _config_path.u8string().c_str(), ".tmp", path_backup_ext.data())) {
 				D_LOG_ERROR("Failed to save configuration file.", nullptr);
 			}
-		});
+		}, nullptr, streamfx::util::threadpool::priority::BACKGROUND);
 	}
 }
 
@@ -0,0 +1,206 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gfx-change-detector.hpp"
+#include "obs/gs/gs-helper.hpp"
+#include "plugin.hpp"
+#include "util/util-benchmark.hpp"
+#include "util/util-logging.hpp"
+
+#include "warning-disable.hpp"
+#include <stdexcept>
+#include "warning-enable.hpp"
+
+#ifdef _DEBUG
+#define ST_PREFIX "<%s> "
+#define D_LOG_ERROR(x, ...) P_LOG_ERROR(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_WARNING(x, ...) P_LOG_WARN(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_INFO(x, ...) P_LOG_INFO(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_DEBUG(x, ...) P_LOG_DEBUG(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#else
+#define ST_PREFIX "<gfx::change_detector> "
+#define D_LOG_ERROR(...) P_LOG_ERROR(ST_PREFIX __VA_ARGS__)
+#define D_LOG_WARNING(...) P_LOG_WARN(ST_PREFIX __VA_ARGS__)
+#define D_LOG_INFO(...) P_LOG_INFO(ST_PREFIX __VA_ARGS__)
+#define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
+#endif
+
+// Number of frames the GPU may run behind the graphics thread, so reading back any earlier would make the graphics
+// thread wait for it. The staging surface of the current frame comes on top, so results arrive ST_LATENCY + 1 calls late.
+#define ST_LATENCY 2
+
+// Upper limit for the width and height of the reduced image that is read back.
+#define ST_MAX_BLOCKS 64u
+
+streamfx::gfx::change_detector::change_detector() : _gfx_util(::streamfx::gfx::util::get()), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _reference(), _generation(0), _readbacks(ST_LATENCY + 1), _index(0)
+{
+	auto gctx = streamfx::obs::gs::context();
+
+	auto file = streamfx::data_file_path("effects/difference.effect");
+	try {
+		_effect = streamfx::obs::gs::effect::create(file);
+	} catch (const std::exception& ex) {
+		D_LOG_ERROR("Error loading '%s': %s", file.generic_u8string().c_str(), ex.what());
+	}
+}
+
+streamfx::gfx::change_detector::~change_detector()
+{
+	auto gctx = streamfx::obs::gs::context();
+	_readbacks.clear();
+	_reference.reset();
+	_effect.reset();
+}
+
+void streamfx::gfx::change_detector::set_reference(std::shared_ptr<streamfx::obs::gs::texture> reference)
+{
+	_reference = std::move(reference);
+	_generation++;
+}
+
+std::shared_ptr<streamfx::obs::gs::texture> streamfx::gfx::change_detector::get_reference()
+{
+	return _reference;
+}
+
+streamfx::gfx::change_detector::result streamfx::gfx::change_detector::compare(std::shared_ptr<streamfx::obs::gs::texture> texture)
+{
+	// Without the effect nothing can be compared, and claiming that nothing changed would be wrong.
+	if (!_effect || !_reference || !texture) {
+		return result::Changed;
+	}
+
+	uint32_t width  = texture->get_width();
+	uint32_t height = texture->get_height();
+	if ((width != _reference->get_width()) || (height != _reference->get_height())) {
+		return result::Changed;
+	}
+
+	// The oldest comparison is retrieved first, as its staging surface is reused for this one.
+	auto& entry = _readbacks[_index];
+	_index      = (_index + 1) % _readbacks.size();
+	result res  = resolve(entry);
+
+	uint32_t block_width  = (width + ST_MAX_BLOCKS - 1) / ST_MAX_BLOCKS;
+	uint32_t block_height = (height + ST_MAX_BLOCKS - 1) / ST_MAX_BLOCKS;
+	uint32_t count_width  = (width + block_width - 1) / block_width;
+	uint32_t count_height = (height + block_height - 1) / block_height;
+
+#if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
+	auto gdmp = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_cache, "Change Detection");
+#endif
+
+	std::shared_ptr<streamfx::obs::gs::rendertarget> rt;
+	try {
+		rt = _pool->acquire(count_width, count_height);
+	} catch (const std::exception&) {
+		return result::Changed;
+	}
+
+	gs_blend_state_push();
+	gs_reset_blend_state();
+	gs_enable_blending(false);
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+	gs_set_cull_mode(GS_NEITHER);
+	gs_enable_color(true, true, true, true);
+	gs_enable_depth_test(false);
+	gs_depth_function(GS_ALWAYS);
+	gs_enable_stencil_test(false);
+	gs_enable_stencil_write(false);
+	gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
+	gs_stencil_op(GS_STENCIL_BOTH, GS_ZERO, GS_ZERO, GS_ZERO);
+
+	_param_image(_effect).set_texture(texture);
+	_param_reference(_effect).set_texture(_reference);
+	_param_image_texel(_effect).set_float2(1.f / static_cast<float>(width), 1.f / static_cast<float>(height));
+	_param_block_size(_effect).set_float2(static_cast<float>(block_width), static_cast<float>(block_height));
+	_param_block_count(_effect).set_float2(static_cast<float>(count_width), static_cast<float>(count_height));
+
+	{
+		auto op = rt->render(count_width, count_height);
+		gs_ortho(0, 1., 0, 1., 0, 1.);
+		while (gs_effect_loop(_effect.get_object(), "Draw")) {
+			_gfx_util->draw_fullscreen_triangle();
+		}
+	}
+
+	gs_blend_state_pop();
+
+	if (!entry.surface || (entry.width != count_width) || (entry.height != count_height)) {
+		entry.surface = std::shared_ptr<gs_stagesurf_t>(gs_stagesurface_create(count_width, count_height, GS_RGBA), [](gs_stagesurf_t* v) { gs_stagesurface_destroy(v); });
+		entry.width   = count_width;
+		entry.height  = count_height;
+	}
+	if (entry.surface.get() == nullptr) {
+		entry.surface.reset();
+		entry.pending = false;
+		return result::Changed;
+	}
+
+	gs_stage_texture(entry.surface.get(), rt->get_texture()->get_object());
+	entry.generation = _generation;
+	entry.pending    = true;
+
+	return res;
+}
+
+std::size_t streamfx::gfx::change_detector::get_latency()
+{
+	return _readbacks.size();
+}
+
+streamfx::gfx::change_detector::result streamfx::gfx::change_detector::resolve(readback& entry)
+{
+	if (!entry.pending || (entry.generation != _generation)) {
+		return result::Unknown;
+	}
+	entry.pending = false;
+
+	uint8_t* data     = nullptr;
+	uint32_t linesize = 0;
+	if (!gs_stagesurface_map(entry.surface.get(), &data, &linesize)) {
+		return result::Changed;
+	}
+
+	bool changed = false;
+	for (uint32_t y = 0; (y < entry.height) && !changed; y++) {
+		const uint8_t* row = data + static_cast<size_t>(y) * linesize;
+		for (uint32_t x = 0; x < (entry.width * 4); x++) {
+			if (row[x] != 0) {
+				changed = true;
+				break;
+			}
+		}
+	}
+
+	gs_stagesurface_unmap(entry.surface.get());
+	return changed ? result::Changed : result::Unchanged;
+}
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		// Cost of comparing a static 1080p input, which is paid every frame in place of re-rendering its result.
+		streamfx::util::benchmark::add("gfx.change_detector.compare.1920x1080", 100, []() -> streamfx::util::benchmark::function_t {
+			auto gctx     = streamfx::obs::gs::context();
+			auto pool     = streamfx::obs::gs::rendertarget_pool::instance();
+			auto detector = std::make_shared<streamfx::gfx::change_detector>();
+
+			auto rt = pool->acquire(1920, 1080);
+			{
+				auto op = rt->render(1920, 1080);
+			}
+			auto reference = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+			detector->set_reference(reference);
+
+			return [detector, reference]() {
+				auto gctx = streamfx::obs::gs::context();
+				if (detector->compare(reference) == streamfx::gfx::change_detector::result::Changed) {
+					throw std::runtime_error("Identical textures were reported as different.");
+				}
+			};
+		});
+	},
+	[]() { // Finalizer
+	},
+	streamfx::loader_priority::NORMAL);
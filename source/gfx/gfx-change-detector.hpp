@@ -0,0 +1,80 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+#include "gfx/gfx-util.hpp"
+#include "obs/gs/gs-effect.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
+#include "obs/gs/gs-texture.hpp"
+
+#include "warning-disable.hpp"
+#include <memory>
+#include <vector>
+#include "warning-enable.hpp"
+
+namespace streamfx::gfx {
+	/** Detects whether a texture still has the same content as a reference texture.
+	 *
+	 * Textures are compared on the GPU and reduced to a tiny image, which is read back a few frames later so that
+	 * the graphics thread never has to wait for the GPU. Results therefore describe the texture passed to compare()
+	 * get_latency() calls ago, not the current one.
+	 */
+	class change_detector {
+		public:
+		enum class result {
+			Unknown,   // No comparison against the current reference has completed yet.
+			Unchanged, // The compared texture matched the reference exactly.
+			Changed,   // The compared texture differed from the reference.
+		};
+
+		private:
+		struct readback {
+			std::shared_ptr<gs_stagesurf_t> surface;
+			uint32_t                        width;
+			uint32_t                        height;
+			uint64_t                        generation; // Generation of the reference this was compared against.
+			bool                            pending;
+		};
+
+		streamfx::obs::gs::effect                             _effect;
+		streamfx::obs::gs::effect_parameter_handle            _param_image{"image"};
+		streamfx::obs::gs::effect_parameter_handle            _param_reference{"reference"};
+		streamfx::obs::gs::effect_parameter_handle            _param_image_texel{"image_texel"};
+		streamfx::obs::gs::effect_parameter_handle            _param_block_size{"block_size"};
+		streamfx::obs::gs::effect_parameter_handle            _param_block_count{"block_count"};
+		std::shared_ptr<streamfx::gfx::util>                  _gfx_util;
+		std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+
+		std::shared_ptr<streamfx::obs::gs::texture> _reference;
+		uint64_t                                    _generation;
+		std::vector<readback>                       _readbacks;
+		std::size_t                                 _index;
+
+		public:
+		change_detector();
+		~change_detector();
+
+		/** Replace the texture that future textures are compared against.
+		 *
+		 * The reference is kept alive until it is replaced. Comparisons still in flight are discarded.
+		 */
+		void set_reference(std::shared_ptr<streamfx::obs::gs::texture> reference);
+
+		std::shared_ptr<streamfx::obs::gs::texture> get_reference();
+
+		/** Queue a comparison of the texture against the reference, and retrieve the oldest queued comparison.
+		 *
+		 * Must be called with the graphics context entered.
+		 */
+		result compare(std::shared_ptr<streamfx::obs::gs::texture> texture);
+
+		/** Number of calls to compare() between queueing a comparison and retrieving its result.
+		 */
+		std::size_t get_latency();
+
+		private:
+		result resolve(readback& entry);
+	};
+} // namespace streamfx::gfx
@@ -0,0 +1,150 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gfx-source-capture-cache.hpp"
+#include "obs/gs/gs-helper.hpp"
+#include "util/util-logging.hpp"
+
+#ifdef _DEBUG
+#define ST_PREFIX "<%s> "
+#define D_LOG_ERROR(x, ...) P_LOG_ERROR(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_WARNING(x, ...) P_LOG_WARN(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_INFO(x, ...) P_LOG_INFO(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_DEBUG(x, ...) P_LOG_DEBUG(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#else
+#define ST_PREFIX "<gfx::source_capture_cache> "
+#define D_LOG_ERROR(...) P_LOG_ERROR(ST_PREFIX __VA_ARGS__)
+#define D_LOG_WARNING(...) P_LOG_WARN(ST_PREFIX __VA_ARGS__)
+#define D_LOG_INFO(...) P_LOG_INFO(ST_PREFIX __VA_ARGS__)
+#define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
+#endif
+
+// In nanoseconds of video frame time. Captures that nothing asked for in this long belong to sources that are no
+// longer being rendered, and only keep their render targets away from the pool.
+#define ST_TIMEOUT 1000000000ull
+
+streamfx::gfx::source_capture_cache::source_capture_cache() : _lock(), _entries(), _pool(streamfx::obs::gs::rendertarget_pool::instance()), _frame(0), _captures(0), _saved(0) {}
+
+streamfx::gfx::source_capture_cache::~source_capture_cache()
+{
+	D_LOG_DEBUG("Rendered %" PRIu64 " capture(s) of sources and saved %" PRIu64 " more by sharing them.", _captures, _saved);
+	clear();
+}
+
+void streamfx::gfx::source_capture_cache::prune(uint64_t frame)
+{
+	for (auto iter = _entries.begin(); iter != _entries.end();) {
+		if (!iter->second.busy && ((frame - iter->second.frame) > ST_TIMEOUT)) {
+			iter = _entries.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+}
+
+std::shared_ptr<streamfx::obs::gs::texture> streamfx::gfx::source_capture_cache::capture(obs_source_t* source, uint32_t width, uint32_t height, gs_color_format format, gs_color_space space)
+{
+	if (!source || (width == 0) || (height == 0)) {
+		return nullptr;
+	}
+
+	uint64_t frame = obs_get_video_frame_time();
+	key_t    key{source, width, height, format, space, gs_get_linear_srgb(), gs_framebuffer_srgb_enabled()};
+
+	{
+		std::unique_lock<decltype(_lock)> lock(_lock);
+
+		if (frame != _frame) {
+			prune(frame);
+			_frame = frame;
+		}
+
+		auto& entry = _entries[key];
+		if (entry.busy) {
+			// The source ended up rendering itself, which would never finish.
+			return nullptr;
+		} else if (entry.texture && (entry.frame == frame)) {
+			_saved++;
+			return entry.texture;
+		}
+
+		// Hand the previous capture back to the pool first, so that it can be reused for this one.
+		entry.texture.reset();
+		entry.busy = true;
+	}
+
+	std::shared_ptr<streamfx::obs::gs::texture> texture;
+	try {
+#if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
+		auto gdm = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_capture, "Capture '%s'", obs_source_get_name(source));
+#endif
+
+		auto rt = _pool->acquire(width, height, format);
+		{
+			auto op = rt->render(width, height, space);
+
+			gs_blend_state_push();
+			gs_reset_blend_state();
+			gs_enable_blending(false);
+			gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+			gs_enable_color(true, true, true, true);
+			gs_set_cull_mode(GS_NEITHER);
+			gs_enable_depth_test(false);
+			gs_depth_function(GS_ALWAYS);
+			gs_enable_stencil_test(false);
+			gs_enable_stencil_write(false);
+			gs_stencil_function(GS_STENCIL_BOTH, GS_ALWAYS);
+			gs_stencil_op(GS_STENCIL_BOTH, GS_KEEP, GS_KEEP, GS_KEEP);
+
+			gs_ortho(0, static_cast<float>(width), 0, static_cast<float>(height), -1., 1.);
+
+			vec4 black = {0., 0., 0., 0.};
+			gs_clear(GS_CLEAR_COLOR, &black, 0., 0);
+
+			try {
+				obs_source_video_render(source);
+			} catch (...) {
+				gs_blend_state_pop();
+				throw;
+			}
+
+			gs_blend_state_pop();
+		}
+		texture = streamfx::obs::gs::rendertarget_pool::get_texture(rt);
+	} catch (...) {
+		std::unique_lock<decltype(_lock)> lock(_lock);
+		_entries[key].busy = false;
+		throw;
+	}
+
+	std::unique_lock<decltype(_lock)> lock(_lock);
+	auto&                             entry = _entries[key];
+	entry.frame                             = frame;
+	entry.texture                           = texture;
+	entry.busy                              = false;
+	_captures++;
+
+	return texture;
+}
+
+void streamfx::gfx::source_capture_cache::clear()
+{
+	auto                              gctx = streamfx::obs::gs::context();
+	std::unique_lock<decltype(_lock)> lock(_lock);
+	_entries.clear();
+}
+
+std::shared_ptr<streamfx::gfx::source_capture_cache> streamfx::gfx::source_capture_cache::instance()
+{
+	static std::weak_ptr<streamfx::gfx::source_capture_cache> winst;
+	static std::mutex                                         mtx;
+
+	std::unique_lock<decltype(mtx)> lock(mtx);
+	auto                            instance = winst.lock();
+	if (!instance) {
+		instance = std::shared_ptr<streamfx::gfx::source_capture_cache>(new streamfx::gfx::source_capture_cache());
+		winst    = instance;
+	}
+	return instance;
+}
@@ -0,0 +1,69 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
+#include "obs/gs/gs-texture.hpp"
+
+#include "warning-disable.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include "warning-enable.hpp"
+
+namespace streamfx::gfx {
+	/** Captures of sources that are shared by everything which renders them during the same frame.
+	 *
+	 * Rendering a source runs its entire filter chain, so a source used by several filters would otherwise be rendered
+	 * once for each of them. The first capture of a source in a frame renders it, and every further capture of the
+	 * same source with the same size, format and color state reuses that texture until the next frame begins.
+	 */
+	class source_capture_cache {
+		// Source, width, height, format, color space, linear sRGB and framebuffer sRGB.
+		typedef std::tuple<obs_source_t*, uint32_t, uint32_t, gs_color_format, gs_color_space, bool, bool> key_t;
+
+		struct entry {
+			uint64_t                                    frame; // Video frame time the texture was captured in.
+			std::shared_ptr<streamfx::obs::gs::texture> texture;
+			bool                                        busy; // Set while the source is being rendered.
+		};
+
+		std::mutex                                            _lock;
+		std::map<key_t, entry>                                _entries;
+		std::shared_ptr<streamfx::obs::gs::rendertarget_pool> _pool;
+
+		uint64_t _frame;
+		uint64_t _captures;
+		uint64_t _saved;
+
+		private:
+		source_capture_cache();
+
+		/** Forget captures of sources that have not been rendered for a while, so their render targets return to the pool.
+		 *
+		 * Must be called with the lock held.
+		 */
+		void prune(uint64_t frame);
+
+		public:
+		~source_capture_cache();
+
+		/** Retrieve the content of the source for the current frame, rendering it only if nothing else has yet.
+		 *
+		 * The source is rendered with blending disabled into a texture cleared to transparent black, using the linear
+		 * and framebuffer sRGB state that is currently set. Must be called with the graphics context entered. Returns
+		 * nullptr if the source is already being captured further up the stack.
+		 */
+		std::shared_ptr<streamfx::obs::gs::texture> capture(obs_source_t* source, uint32_t width, uint32_t height, gs_color_format format = GS_RGBA, gs_color_space space = GS_CS_SRGB);
+
+		/** Forget all captures.
+		 */
+		void clear();
+
+		public /* Singleton */:
+		static std::shared_ptr<streamfx::gfx::source_capture_cache> instance();
+	};
+} // namespace streamfx::gfx
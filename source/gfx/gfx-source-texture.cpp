@@ -31,7 +31,7 @@ streamfx::gfx::source_texture::source_texture(streamfx::obs::source child, strea
 		throw std::runtime_error("Child contains Parent");
 	}
 
-	_rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
+	_cache = streamfx::gfx::source_capture_cache::instance();
 }
 
 obs_source_t* streamfx::gfx::source_texture::get_object()
@@ -67,19 +67,8 @@ std::shared_ptr<streamfx::obs::gs::texture> streamfx::gfx::source_texture::rende
 		return nullptr;
 	}
 
-	if (_child) {
 #if defined(ENABLE_PROFILING) && !defined(D_PLATFORM_MAC) && _DEBUG
-		auto cctr = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_capture, "gfx::source_texture '%s'", obs_source_get_name(_child.get()));
+	auto cctr = streamfx::obs::gs::debug_marker(streamfx::obs::gs::debug_color_capture, "gfx::source_texture '%s'", obs_source_get_name(_child.get()));
 #endif
-		auto op = _rt->render(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
-		vec4 black;
-		vec4_zero(&black);
-		gs_ortho(0, static_cast<float>(width), 0, static_cast<float>(height), 0, 1);
-		gs_clear(GS_CLEAR_COLOR, &black, 0, 0);
-		obs_source_video_render(_child.get());
-	}
-
-	std::shared_ptr<streamfx::obs::gs::texture> tex;
-	_rt->get_texture(tex);
-	return tex;
+	return _cache->capture(_child.get(), static_cast<uint32_t>(width), static_cast<uint32_t>(height));
 }
@@ -694,3 +694,12 @@ void streamfx::obs::gs::effect_parameter::get_default_string(std::string& v)
 		v.clear();
 	}
 }
+
+void streamfx::obs::gs::effect_parameter::set_default()
+{
+	if (get_type() == type::Texture) {
+		gs_effect_set_texture(get(), nullptr);
+	} else {
+		gs_effect_set_default(get());
+	}
+}
@@ -184,6 +184,10 @@ namespace streamfx::obs::gs {
 		void get_string(std::string& v);
 		void get_default_string(std::string& v);
 
+		/** Restore the value the parameter was declared with. Textures have none, and are cleared instead.
+		 */
+		void set_default();
+
 		public /* Helpers */:
 		inline float get_bool()
 		{
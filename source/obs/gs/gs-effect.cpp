@@ -6,9 +6,12 @@
 #include "gs-effect.hpp"
 #include "obs/gs/gs-helper.hpp"
 #include "util/util-platform.hpp"
+#include "util/utility.hpp"
 
 #include "warning-disable.hpp"
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
@@ -16,28 +19,47 @@
 
 #define MAX_EFFECT_SIZE 32 * 1024 * 1024 // 32 MiB, big enough for everything.
 
-static std::string load_file_as_code(const std::filesystem::path& shader_file, bool is_top_level = true)
+namespace {
+	// Effects compiled by effect::shared(), by the hash of their key and code.
+	struct shared_effects {
+		struct entry {
+			std::string                                                      key;
+			std::string                                                      code;
+			std::weak_ptr<gs_effect_t>                                       effect;
+			std::weak_ptr<std::unordered_map<std::string_view, std::size_t>> parameters;
+		};
+
+		std::mutex                lock;
+		std::map<uint64_t, entry> entries;
+
+		static shared_effects& get()
+		{
+			static shared_effects instance;
+			return instance;
+		}
+	};
+} // namespace
+
+static std::string load_file_as_code(const std::filesystem::path& shader_file, int device_type, streamfx::obs::gs::effect_dependencies_t* dependencies, bool is_top_level = true)
 {
 	std::stringstream           shader_stream;
 	const std::filesystem::path shader_path = std::filesystem::absolute(shader_file.native());
 	const std::filesystem::path shader_root = std::filesystem::path(shader_path.native()).remove_filename();
 
-	// Ensure it meets size limits.
-	uintmax_t size = std::filesystem::file_size(shader_path);
-	if (size > MAX_EFFECT_SIZE) {
-		throw std::runtime_error("File is too large to be loaded.");
+	// Read and stamp the file at once, so that the stamp describes exactly what was preprocessed.
+	std::string content;
+	auto        stamp = streamfx::obs::gs::effect_file_stamp::read(shader_path, &content);
+	if (dependencies) {
+		dependencies->insert_or_assign(shader_path, stamp);
 	}
-
-	// Try to open as-is.
-	std::ifstream ifs(shader_path, std::ios::in);
-	if (!ifs.is_open() || ifs.bad()) {
-		throw std::runtime_error("Failed to open file.");
+	if (!stamp.exists) {
+		throw std::runtime_error("File does not exist.");
 	}
+	std::istringstream ifs(content);
 
 	// Push Graphics API to shader.
 	if (is_top_level) {
-		auto gctx = streamfx::obs::gs::context();
-		switch (gs_get_device_type()) {
+		switch (device_type) {
 		case GS_DEVICE_DIRECT3D_11:
 			shader_stream << "#define GS_DEVICE_DIRECT3D_11" << std::endl;
 			shader_stream << "#define GS_DEVICE_DIRECT3D" << std::endl;
@@ -51,6 +73,11 @@ static std::string load_file_as_code(const std::filesystem::path& shader_file, b
 	// Pre-process the shader.
 	std::string line;
 	while (std::getline(ifs, line)) {
+		// Files are read as binary to stamp them, which keeps Windows line endings around.
+		if (!line.empty() && (line.back() == '\r')) {
+			line.pop_back();
+		}
+
 		std::string line_trimmed = line;
 
 		{ // Figure out the length of the trim.
@@ -76,7 +103,7 @@ static std::string load_file_as_code(const std::filesystem::path& shader_file, b
 				include_path = shader_root / include_str;
 			}
 
-			line = load_file_as_code(include_path, false);
+			line = load_file_as_code(include_path, device_type, dependencies, false);
 		}
 
 		shader_stream << line << std::endl;
@@ -85,6 +112,49 @@ static std::string load_file_as_code(const std::filesystem::path& shader_file, b
 	return shader_stream.str();
 }
 
+bool streamfx::obs::gs::effect_file_stamp::operator==(const effect_file_stamp& other) const
+{
+	return (exists == other.exists) && (size == other.size) && (hash == other.hash);
+}
+
+bool streamfx::obs::gs::effect_file_stamp::operator!=(const effect_file_stamp& other) const
+{
+	return !(*this == other);
+}
+
+streamfx::obs::gs::effect_file_stamp streamfx::obs::gs::effect_file_stamp::read(const std::filesystem::path& file, std::string* content)
+{
+	effect_file_stamp stamp{false, std::filesystem::file_time_type::min(), 0, 0};
+
+	std::error_code ec;
+	stamp.time = std::filesystem::last_write_time(file, ec);
+	if (ec) {
+		return stamp;
+	}
+
+	// Ensure it meets size limits.
+	stamp.size = std::filesystem::file_size(file);
+	if (stamp.size > MAX_EFFECT_SIZE) {
+		throw std::runtime_error("File is too large to be loaded.");
+	}
+
+	std::ifstream ifs(file, std::ios::in | std::ios::binary);
+	if (!ifs.is_open() || ifs.bad()) {
+		throw std::runtime_error("Failed to open file.");
+	}
+
+	std::string data(static_cast<std::size_t>(stamp.size), '\0');
+	ifs.read(data.data(), static_cast<std::streamsize>(data.size()));
+	data.resize(static_cast<std::size_t>(ifs.gcount()));
+
+	stamp.exists = true;
+	stamp.hash   = streamfx::util::hash::fnv1a(data.data(), data.size());
+	if (content) {
+		*content = std::move(data);
+	}
+	return stamp;
+}
+
 streamfx::obs::gs::effect::effect(std::string_view code, std::string_view name)
 {
 	auto gctx = streamfx::obs::gs::context();
@@ -97,9 +167,16 @@ streamfx::obs::gs::effect::effect(std::string_view code, std::string_view name)
 	}
 
 	reset(effect, [](gs_effect_t* ptr) { gs_effect_destroy(ptr); });
+
+	// Names are owned by the effect, and live as long as it does.
+	_parameters = std::make_shared<std::unordered_map<std::string_view, std::size_t>>();
+	_parameters->reserve(count_parameters());
+	for (std::size_t idx = 0; idx < count_parameters(); idx++) {
+		_parameters->emplace(get()->params.array[idx].name, idx);
+	}
 }
 
-streamfx::obs::gs::effect::effect(std::filesystem::path file) : effect(load_file_as_code(file), streamfx::util::platform::utf8_to_native(std::filesystem::absolute(file)).generic_u8string()) {}
+streamfx::obs::gs::effect::effect(std::filesystem::path file) : effect(preprocess(file, get_device_type()), get_name(file)) {}
 
 streamfx::obs::gs::effect::~effect()
 {
@@ -156,11 +233,12 @@ streamfx::obs::gs::effect_parameter streamfx::obs::gs::effect::get_parameter(std
 
 streamfx::obs::gs::effect_parameter streamfx::obs::gs::effect::get_parameter(std::string_view name)
 {
-	for (std::size_t idx = 0; idx < count_parameters(); idx++) {
-		auto ptr = get()->params.array + idx;
-		if (strcmp(ptr->name, name.data()) == 0) {
-			return streamfx::obs::gs::effect_parameter(ptr, *this);
-		}
+	if (!_parameters) {
+		return nullptr;
+	}
+
+	if (auto kv = _parameters->find(name); kv != _parameters->end()) {
+		return streamfx::obs::gs::effect_parameter(get()->params.array + kv->second, *this);
 	}
 
 	return nullptr;
@@ -168,9 +246,7 @@ streamfx::obs::gs::effect_parameter streamfx::obs::gs::effect::get_parameter(std
 
 bool streamfx::obs::gs::effect::has_parameter(std::string_view name)
 {
-	if (get_parameter(name))
-		return true;
-	return false;
+	return _parameters && (_parameters->count(name) > 0);
 }
 
 bool streamfx::obs::gs::effect::has_parameter(std::string_view name, effect_parameter::type type)
@@ -180,3 +256,68 @@ bool streamfx::obs::gs::effect::has_parameter(std::string_view name, effect_para
 		return eprm.get_type() == type;
 	return false;
 }
+
+std::string streamfx::obs::gs::effect::preprocess(const std::filesystem::path& file, int device_type, effect_dependencies_t* dependencies)
+{
+	return load_file_as_code(file, device_type, dependencies);
+}
+
+std::string streamfx::obs::gs::effect::get_name(const std::filesystem::path& file)
+{
+	return streamfx::util::platform::utf8_to_native(std::filesystem::absolute(file)).generic_u8string();
+}
+
+streamfx::obs::gs::effect streamfx::obs::gs::effect::shared(std::string_view code, std::string_view name, std::string_view key)
+{
+	auto& cache = shared_effects::get();
+	auto  hash  = streamfx::util::hash::fnv1a(code.data(), code.size(), streamfx::util::hash::fnv1a(key.data(), key.size()));
+
+	{
+		std::unique_lock<decltype(cache.lock)> lock(cache.lock);
+		if (auto kv = cache.entries.find(hash); (kv != cache.entries.end()) && (kv->second.key == key) && (kv->second.code == code)) {
+			auto ptr        = kv->second.effect.lock();
+			auto parameters = kv->second.parameters.lock();
+			if (ptr && parameters) {
+				effect result;
+				static_cast<std::shared_ptr<gs_effect_t>&>(result) = std::move(ptr);
+				result._parameters                                 = std::move(parameters);
+				return result;
+			}
+		}
+	}
+
+	// Compiling requires the graphics context, which must never be waited for while holding the lock.
+	effect result(code, name);
+
+	std::unique_lock<decltype(cache.lock)> lock(cache.lock);
+	for (auto iter = cache.entries.begin(); iter != cache.entries.end();) {
+		if (iter->second.effect.expired()) {
+			iter = cache.entries.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+	cache.entries.insert_or_assign(hash, shared_effects::entry{std::string(key), std::string(code), result, result._parameters});
+	return result;
+}
+
+int streamfx::obs::gs::effect::get_device_type()
+{
+	// The device is created before any plugin is loaded, and lives until after all of them are gone.
+	static int device_type = []() {
+		auto gctx = streamfx::obs::gs::context();
+		return gs_get_device_type();
+	}();
+	return device_type;
+}
+
+streamfx::obs::gs::effect_parameter_handle::effect_parameter_handle(std::string_view name, effect_parameter::type type) : _name(name), _type(type), _effect(nullptr), _parameter() {}
+
+void streamfx::obs::gs::effect_parameter_handle::rebind(streamfx::obs::gs::effect& effect)
+{
+	_effect    = effect.get();
+	_parameter = effect ? effect.get_parameter(_name) : nullptr;
+	if (_parameter && (_type != effect_parameter::type::Invalid) && (_parameter.get_type() != _type)) {
+		_parameter = nullptr;
+	}
+}
@@ -11,10 +11,39 @@
 #include "warning-disable.hpp"
 #include <filesystem>
 #include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
 #include "warning-enable.hpp"
 
 namespace streamfx::obs::gs {
+	/** State of a file that effect code was read from, used to find out whether it changed since.
+	 *
+	 * Stamps are equal if the content is, no matter when the file was last written.
+	 */
+	struct effect_file_stamp {
+		bool                            exists;
+		std::filesystem::file_time_type time;
+		uintmax_t                       size;
+		uint64_t                        hash; // Of the entire content.
+
+		bool operator==(const effect_file_stamp& other) const;
+		bool operator!=(const effect_file_stamp& other) const;
+
+		/** Stamp the file, and optionally retrieve the content that was stamped.
+		 *
+		 * A file that does not exist results in a stamp with 'exists' unset, so that its creation can be noticed.
+		 */
+		static effect_file_stamp read(const std::filesystem::path& file, std::string* content = nullptr);
+	};
+
+	// Every file that was read to create an effect, including the effect file itself.
+	typedef std::map<std::filesystem::path, effect_file_stamp> effect_dependencies_t;
+
 	class effect : public std::shared_ptr<gs_effect_t> {
+		// Parameter name to index, built once on creation and shared by all copies.
+		std::shared_ptr<std::unordered_map<std::string_view, std::size_t>> _parameters;
+
 		public:
 		effect() = default;
 		effect(std::string_view code, std::string_view name);
@@ -32,6 +61,32 @@ namespace streamfx::obs::gs {
 		bool                                has_parameter(std::string_view name);
 		bool                                has_parameter(std::string_view name, effect_parameter::type type);
 
+		public:
+		/** Read an effect file and resolve all of its #include directives.
+		 *
+		 * Does not need the graphics context, so files can be read and preprocessed on any thread and only the
+		 * compilation of the result has to happen on the graphics thread.
+		 *
+		 * @param device_type Graphics device the code is meant for, as returned by get_device_type().
+		 * @param dependencies If set, receives the stamps of all files that were read, even if preprocessing failed.
+		 */
+		static std::string preprocess(const std::filesystem::path& file, int device_type, effect_dependencies_t* dependencies = nullptr);
+
+		/** Create an effect from the code, or reuse one that was already created from identical code and key.
+		 *
+		 * Compiling is by far the most expensive part of creating an effect, and is skipped entirely for code that
+		 * another user is still holding an effect for. The values of parameters are shared as well, so users must
+		 * assign every parameter they rely on right before drawing, without rendering anything else in between, and
+		 * reset those they do not. Users that assign different sets of parameters must pass different keys.
+		 */
+		static effect shared(std::string_view code, std::string_view name, std::string_view key = {});
+
+		/** Name of an effect created from the given file, which libobs reports errors with.
+		 */
+		static std::string get_name(const std::filesystem::path& file);
+
+		static int get_device_type();
+
 		public /* Legacy Support */:
 		inline gs_effect_t* get_object()
 		{
@@ -53,4 +108,37 @@ namespace streamfx::obs::gs {
 			return streamfx::obs::gs::effect(file);
 		};
 	};
+
+	/** Parameter of an effect which is looked up by name once, and then reused.
+	 *
+	 * Meant to be kept next to the code that renders with the effect, so that binding parameters in the
+	 * render loop does no string work at all. Looks up the parameter again only if used with another effect.
+	 */
+	class effect_parameter_handle {
+		std::string                         _name;
+		effect_parameter::type              _type;
+		gs_effect_t*                        _effect;
+		streamfx::obs::gs::effect_parameter _parameter;
+
+		public:
+		/**
+		 * @param type Expected type of the parameter, or Invalid to accept any type.
+		 */
+		effect_parameter_handle(std::string_view name, effect_parameter::type type = effect_parameter::type::Invalid);
+
+		/** Resolve the parameter in the given effect.
+		 *
+		 * @return The parameter, which is empty if the effect has no parameter with this name and type.
+		 */
+		inline streamfx::obs::gs::effect_parameter& operator()(streamfx::obs::gs::effect& effect)
+		{
+			if (effect.get() != _effect) {
+				rebind(effect);
+			}
+			return _parameter;
+		}
+
+		private:
+		void rebind(streamfx::obs::gs::effect& effect);
+	};
 } // namespace streamfx::obs::gs
@@ -0,0 +1,307 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "gs-rendertarget-pool.hpp"
+#include "configuration.hpp"
+#include "obs/gs/gs-helper.hpp"
+#include "plugin.hpp"
+#include "util/util-benchmark.hpp"
+#include "util/util-logging.hpp"
+
+#ifdef _DEBUG
+#define ST_PREFIX "<%s> "
+#define D_LOG_ERROR(x, ...) P_LOG_ERROR(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_WARNING(x, ...) P_LOG_WARN(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_INFO(x, ...) P_LOG_INFO(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_DEBUG(x, ...) P_LOG_DEBUG(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#else
+#define ST_PREFIX "<obs::gs::rendertarget_pool> "
+#define D_LOG_ERROR(...) P_LOG_ERROR(ST_PREFIX __VA_ARGS__)
+#define D_LOG_WARNING(...) P_LOG_WARN(ST_PREFIX __VA_ARGS__)
+#define D_LOG_INFO(...) P_LOG_INFO(ST_PREFIX __VA_ARGS__)
+#define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
+#endif
+
+#define ST_CFG_BUDGET "graphics.rendertarget_pool.budget"
+#define ST_CFG_TIMEOUT "graphics.rendertarget_pool.timeout"
+
+// In MiB, roughly a dozen idle 4K RGBA render targets.
+#define ST_DEFAULT_BUDGET 384
+
+// In milliseconds. Render targets are normally returned and borrowed again within a single frame, so anything idle
+// for longer than this belongs to a filter that is no longer being rendered.
+#define ST_DEFAULT_TIMEOUT 2000
+
+using namespace streamfx::obs::gs;
+
+double_t rendertarget_pool::statistics::hit_rate() const
+{
+	uint64_t total = hits + misses;
+	return (total > 0) ? (static_cast<double_t>(hits) / static_cast<double_t>(total)) : 0.;
+}
+
+void rendertarget_pool::deleter::operator()(streamfx::obs::gs::rendertarget* rt)
+{
+	if (auto self = pool.lock(); self) {
+		self->release(rt, bytes);
+	} else {
+		delete rt;
+	}
+}
+
+rendertarget_pool::rendertarget_pool() : _lock(), _buckets(), _budget(size_t(ST_DEFAULT_BUDGET) << 20), _timeout(ST_DEFAULT_TIMEOUT), _idle_count(0), _idle_bytes(0), _borrowed_count(0), _borrowed_bytes(0), _peak_bytes(0), _hits(0), _misses(0), _evictions(0)
+{
+	if (auto config = streamfx::configuration::instance(); config) {
+		auto data = config->get();
+		if (obs_data_has_user_value(data.get(), ST_CFG_BUDGET)) {
+			_budget = static_cast<size_t>(std::max<long long>(obs_data_get_int(data.get(), ST_CFG_BUDGET), 0)) << 20;
+		}
+		if (obs_data_has_user_value(data.get(), ST_CFG_TIMEOUT)) {
+			_timeout = std::chrono::milliseconds(std::max<long long>(obs_data_get_int(data.get(), ST_CFG_TIMEOUT), 0));
+		}
+	}
+	D_LOG_DEBUG("Idle render targets may use up to %zu MiB of memory for up to %lld ms.", _budget >> 20, static_cast<long long>(_timeout.count()));
+
+	obs_add_tick_callback(tick, this);
+}
+
+rendertarget_pool::~rendertarget_pool()
+{
+	obs_remove_tick_callback(tick, this);
+
+	D_LOG_DEBUG("Served %" PRIu64 " of %" PRIu64 " request(s) from the pool, with %zu MiB peak usage and %" PRIu64 " eviction(s).", _hits, _hits + _misses, _peak_bytes >> 20, _evictions);
+	clear();
+}
+
+void rendertarget_pool::release(streamfx::obs::gs::rendertarget* rt, size_t bytes)
+{
+	std::unique_ptr<streamfx::obs::gs::rendertarget> ptr{rt};
+	std::list<entry>                                 evicted;
+
+	{
+		std::lock_guard<std::mutex> lg(_lock);
+		_borrowed_count--;
+		_borrowed_bytes -= bytes;
+
+		// File it under the size it was actually rendered at, which is what a future borrower gets.
+		uint32_t width  = ptr->get_width();
+		uint32_t height = ptr->get_height();
+		size_t   size   = get_size(width, height, ptr->get_color_format(), ptr->get_zstencil_format());
+		if ((size > 0) && (size <= _budget)) {
+			evict(size, evicted);
+			auto& bucket = _buckets[key_t{width, height, ptr->get_color_format(), ptr->get_zstencil_format()}];
+			bucket.push_back({std::move(ptr), size, std::chrono::steady_clock::now()});
+			_idle_count++;
+			_idle_bytes += size;
+		} else if (size > 0) {
+			_evictions++;
+		}
+	}
+
+	// Destroying render targets requires the graphics context, which must never be entered with the lock held.
+	if (ptr || !evicted.empty()) {
+		auto gctx = streamfx::obs::gs::context();
+		evicted.clear();
+		ptr.reset();
+	}
+}
+
+void rendertarget_pool::evict(size_t bytes, std::list<entry>& evicted)
+{
+	auto now = std::chrono::steady_clock::now();
+
+	for (auto kv = _buckets.begin(); kv != _buckets.end();) {
+		auto& bucket = kv->second;
+		while (!bucket.empty() && ((now - bucket.front().released) > _timeout)) {
+			_idle_count--;
+			_idle_bytes -= bucket.front().bytes;
+			evicted.splice(evicted.end(), bucket, bucket.begin());
+			_evictions++;
+		}
+		if (bucket.empty()) {
+			kv = _buckets.erase(kv);
+		} else {
+			kv++;
+		}
+	}
+
+	while ((_idle_bytes + bytes) > _budget) {
+		// Find the bucket holding the oldest idle render target.
+		auto oldest = _buckets.end();
+		for (auto kv = _buckets.begin(); kv != _buckets.end(); kv++) {
+			if ((oldest == _buckets.end()) || (kv->second.front().released < oldest->second.front().released)) {
+				oldest = kv;
+			}
+		}
+		if (oldest == _buckets.end()) {
+			break;
+		}
+
+		_idle_count--;
+		_idle_bytes -= oldest->second.front().bytes;
+		evicted.splice(evicted.end(), oldest->second, oldest->second.begin());
+		if (oldest->second.empty()) {
+			_buckets.erase(oldest);
+		}
+		_evictions++;
+	}
+}
+
+void rendertarget_pool::tick(void* ptr, float)
+{
+	auto             self = reinterpret_cast<rendertarget_pool*>(ptr);
+	std::list<entry> evicted;
+
+	{
+		std::lock_guard<std::mutex> lg(self->_lock);
+		if (self->_idle_count == 0) {
+			return;
+		}
+		self->evict(0, evicted);
+	}
+
+	if (!evicted.empty()) {
+		auto gctx = streamfx::obs::gs::context();
+		evicted.clear();
+	}
+}
+
+std::shared_ptr<streamfx::obs::gs::rendertarget> rendertarget_pool::acquire(uint32_t width, uint32_t height, gs_color_format format, gs_zstencil_format zsformat)
+{
+	std::unique_ptr<streamfx::obs::gs::rendertarget> rt;
+	std::list<entry>                                 evicted;
+	size_t                                           bytes = get_size(width, height, format, zsformat);
+
+	{
+		std::lock_guard<std::mutex> lg(_lock);
+		if (auto kv = _buckets.find(key_t{width, height, format, zsformat}); kv != _buckets.end()) {
+			// Reuse the most recently returned render target, so that rarely needed ones at the front can time out.
+			rt = std::move(kv->second.back().rt);
+			_idle_count--;
+			_idle_bytes -= kv->second.back().bytes;
+			kv->second.pop_back();
+			if (kv->second.empty()) {
+				_buckets.erase(kv);
+			}
+			_hits++;
+		} else {
+			_misses++;
+		}
+		evict(0, evicted);
+
+		_borrowed_count++;
+		_borrowed_bytes += bytes;
+		_peak_bytes = std::max(_peak_bytes, _idle_bytes + _borrowed_bytes);
+	}
+
+	{
+		auto gctx = streamfx::obs::gs::context();
+		evicted.clear();
+		if (!rt) {
+			try {
+				rt = std::make_unique<streamfx::obs::gs::rendertarget>(format, zsformat);
+			} catch (...) {
+				std::lock_guard<std::mutex> lg(_lock);
+				_borrowed_count--;
+				_borrowed_bytes -= bytes;
+				throw;
+			}
+		}
+	}
+
+	return std::shared_ptr<streamfx::obs::gs::rendertarget>(rt.release(), deleter{weak_from_this(), bytes});
+}
+
+void rendertarget_pool::clear()
+{
+	std::list<entry> evicted;
+
+	{
+		std::lock_guard<std::mutex> lg(_lock);
+		for (auto& kv : _buckets) {
+			evicted.splice(evicted.end(), kv.second);
+		}
+		_buckets.clear();
+		_idle_count = 0;
+		_idle_bytes = 0;
+	}
+
+	if (!evicted.empty()) {
+		auto gctx = streamfx::obs::gs::context();
+		evicted.clear();
+	}
+}
+
+rendertarget_pool::statistics rendertarget_pool::get_statistics()
+{
+	std::lock_guard<std::mutex> lg(_lock);
+	return statistics{_hits, _misses, _evictions, _idle_count, _idle_bytes, _borrowed_count, _borrowed_bytes, _peak_bytes, _budget};
+}
+
+std::shared_ptr<streamfx::obs::gs::texture> rendertarget_pool::get_texture(std::shared_ptr<streamfx::obs::gs::rendertarget> rt)
+{
+	auto texture = rt->get_texture();
+	return std::shared_ptr<streamfx::obs::gs::texture>(texture.get(), [texture, rt](streamfx::obs::gs::texture*) {});
+}
+
+size_t rendertarget_pool::get_size(uint32_t width, uint32_t height, gs_color_format format, gs_zstencil_format zsformat)
+{
+	size_t bits = gs_get_format_bpp(format);
+	switch (zsformat) {
+	case GS_Z16:
+		bits += 16;
+		break;
+	case GS_Z24_S8:
+	case GS_Z32F:
+		bits += 32;
+		break;
+	case GS_Z32F_S8X24:
+		bits += 64;
+		break;
+	default:
+		break;
+	}
+	return (static_cast<size_t>(width) * static_cast<size_t>(height) * bits) / 8;
+}
+
+std::shared_ptr<streamfx::obs::gs::rendertarget_pool> rendertarget_pool::instance()
+{
+	static std::weak_ptr<streamfx::obs::gs::rendertarget_pool> winst;
+	static std::mutex                                          mtx;
+
+	std::unique_lock<decltype(mtx)> lock(mtx);
+	auto                            instance = winst.lock();
+	if (!instance) {
+		instance = std::shared_ptr<streamfx::obs::gs::rendertarget_pool>(new streamfx::obs::gs::rendertarget_pool());
+		winst    = instance;
+	}
+	return instance;
+}
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		// A filter chain with four passes per frame, with and without reusing render targets.
+		streamfx::util::benchmark::add("gs.rendertarget.create.1920x1080", 100, []() -> streamfx::util::benchmark::function_t {
+			return []() {
+				auto gctx = streamfx::obs::gs::context();
+				for (size_t pass = 0; pass < 4; pass++) {
+					auto rt = std::make_shared<streamfx::obs::gs::rendertarget>(GS_RGBA, GS_ZS_NONE);
+					auto op = rt->render(1920, 1080);
+				}
+			};
+		});
+		streamfx::util::benchmark::add("gs.rendertarget_pool.acquire.1920x1080", 100, []() -> streamfx::util::benchmark::function_t {
+			auto pool = rendertarget_pool::instance();
+			return [pool]() {
+				auto gctx = streamfx::obs::gs::context();
+				for (size_t pass = 0; pass < 4; pass++) {
+					auto rt = pool->acquire(1920, 1080);
+					auto op = rt->render(1920, 1080);
+				}
+			};
+		});
+	},
+	[]() { // Finalizer
+	},
+	streamfx::loader_priority::NORMAL);
@@ -0,0 +1,118 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+#include "gs-rendertarget.hpp"
+#include "gs-texture.hpp"
+
+#include "warning-disable.hpp"
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include "warning-enable.hpp"
+
+namespace streamfx::obs::gs {
+	/** Pool of transient render targets shared by all filters.
+	 *
+	 * Passes borrow a render target for as long as they need its content and hand it back by releasing their
+	 * reference. Idle render targets are kept in buckets by size and format, and are destroyed once they have not
+	 * been used for a while or once they exceed the memory budget, least recently returned first. Timeouts are
+	 * checked every frame.
+	 */
+	class rendertarget_pool : public std::enable_shared_from_this<rendertarget_pool> {
+		public:
+		struct statistics {
+			uint64_t hits;
+			uint64_t misses;
+			uint64_t evictions;
+			size_t   idle_count;
+			size_t   idle_bytes;
+			size_t   borrowed_count;
+			size_t   borrowed_bytes;
+			size_t   peak_bytes;
+			size_t   budget_bytes;
+
+			double_t hit_rate() const;
+		};
+
+		private:
+		typedef std::tuple<uint32_t, uint32_t, gs_color_format, gs_zstencil_format> key_t;
+
+		// Returns borrowed render targets to the pool, if it still exists.
+		struct deleter {
+			std::weak_ptr<rendertarget_pool> pool;
+			size_t                           bytes;
+
+			void operator()(streamfx::obs::gs::rendertarget* rt);
+		};
+
+		struct entry {
+			std::unique_ptr<streamfx::obs::gs::rendertarget> rt;
+			size_t                                           bytes;
+			std::chrono::steady_clock::time_point            released;
+		};
+
+		std::mutex                        _lock;
+		std::map<key_t, std::list<entry>> _buckets; // Most recently returned render targets are at the back.
+
+		size_t                    _budget;
+		std::chrono::milliseconds _timeout;
+		size_t                    _idle_count;
+		size_t                    _idle_bytes;
+		size_t                    _borrowed_count;
+		size_t                    _borrowed_bytes;
+		size_t                    _peak_bytes;
+		uint64_t                  _hits;
+		uint64_t                  _misses;
+		uint64_t                  _evictions;
+
+		private:
+		rendertarget_pool();
+
+		void release(streamfx::obs::gs::rendertarget* rt, size_t bytes);
+
+		/** Remove idle render targets that timed out, and then the oldest ones until 'bytes' more fit into the budget.
+		 *
+		 * Must be called with the lock held. Evicted render targets are moved into 'evicted', so that they can be
+		 * destroyed after the lock has been released.
+		 */
+		void evict(size_t bytes, std::list<entry>& evicted);
+
+		/** Destroy idle render targets that timed out, even while nothing borrows or returns any.
+		 */
+		static void tick(void* ptr, float seconds);
+
+		public:
+		~rendertarget_pool();
+
+		/** Borrow a render target of the given size and format.
+		 *
+		 * The render target is returned to the pool once the last reference to it is released, and must be rendered
+		 * to at exactly the given size to be reused efficiently.
+		 */
+		std::shared_ptr<streamfx::obs::gs::rendertarget> acquire(uint32_t width, uint32_t height, gs_color_format format = GS_RGBA, gs_zstencil_format zsformat = GS_ZS_NONE);
+
+		/** Destroy all idle render targets.
+		 */
+		void clear();
+
+		statistics get_statistics();
+
+		public:
+		/** Retrieve the texture of a borrowed render target, which keeps it borrowed for as long as it is referenced.
+		 */
+		static std::shared_ptr<streamfx::obs::gs::texture> get_texture(std::shared_ptr<streamfx::obs::gs::rendertarget> rt);
+
+		/** Memory used by a render target of the given size and format, in bytes.
+		 */
+		static size_t get_size(uint32_t width, uint32_t height, gs_color_format format, gs_zstencil_format zsformat);
+
+		public /* Singleton */:
+		static std::shared_ptr<streamfx::obs::gs::rendertarget_pool> instance();
+	};
+} // namespace streamfx::obs::gs
@@ -7,16 +7,29 @@
 #include "obs/gs/gs-helper.hpp"
 
 #include "warning-disable.hpp"
+#include <atomic>
 #include <stdexcept>
 #include "warning-enable.hpp"
 
+static std::atomic<uint64_t> _allocations{0};
+
+static void track_allocation(uint32_t& rt_width, uint32_t& rt_height, uint32_t width, uint32_t height)
+{
+	// gs_texrender_begin() recreates the texture whenever the size changes.
+	if ((rt_width != width) || (rt_height != height)) {
+		rt_width  = width;
+		rt_height = height;
+		_allocations.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
 streamfx::obs::gs::rendertarget::~rendertarget()
 {
 	auto gctx = streamfx::obs::gs::context();
 	gs_texrender_destroy(_render_target);
 }
 
-streamfx::obs::gs::rendertarget::rendertarget(gs_color_format colorFormat, gs_zstencil_format zsFormat) : _color_format(colorFormat), _zstencil_format(zsFormat)
+streamfx::obs::gs::rendertarget::rendertarget(gs_color_format colorFormat, gs_zstencil_format zsFormat) : _color_format(colorFormat), _zstencil_format(zsFormat), _width(0), _height(0)
 {
 	_is_being_rendered = false;
 	auto gctx          = streamfx::obs::gs::context();
@@ -73,6 +86,21 @@ gs_zstencil_format streamfx::obs::gs::rendertarget::get_zstencil_format()
 	return _zstencil_format;
 }
 
+uint32_t streamfx::obs::gs::rendertarget::get_width()
+{
+	return _width;
+}
+
+uint32_t streamfx::obs::gs::rendertarget::get_height()
+{
+	return _height;
+}
+
+uint64_t streamfx::obs::gs::rendertarget::allocations()
+{
+	return _allocations.load(std::memory_order_relaxed);
+}
+
 streamfx::obs::gs::rendertarget_op::rendertarget_op(streamfx::obs::gs::rendertarget* rt, uint32_t width, uint32_t height) : parent(rt)
 {
 	if (parent == nullptr)
@@ -81,6 +109,7 @@ streamfx::obs::gs::rendertarget_op::rendertarget_op(streamfx::obs::gs::rendertar
 		throw std::logic_error("Can't start rendering to the same render target twice.");
 
 	auto gctx = streamfx::obs::gs::context();
+	track_allocation(parent->_width, parent->_height, width, height);
 	gs_texrender_reset(parent->_render_target);
 	if (!gs_texrender_begin(parent->_render_target, width, height)) {
 		throw std::runtime_error("Failed to begin rendering to render target.");
@@ -96,6 +125,7 @@ streamfx::obs::gs::rendertarget_op::rendertarget_op(streamfx::obs::gs::rendertar
 		throw std::logic_error("Can't start rendering to the same render target twice.");
 
 	auto gctx = streamfx::obs::gs::context();
+	track_allocation(parent->_width, parent->_height, width, height);
 	gs_texrender_reset(parent->_render_target);
 	if (!gs_texrender_begin_with_color_space(parent->_render_target, width, height, cs)) {
 		throw std::runtime_error("Failed to begin rendering to render target.");
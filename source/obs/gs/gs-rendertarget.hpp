@@ -20,6 +20,9 @@ namespace streamfx::obs::gs {
 		gs_color_format    _color_format;
 		gs_zstencil_format _zstencil_format;
 
+		uint32_t _width;
+		uint32_t _height;
+
 		public:
 		~rendertarget();
 
@@ -39,9 +42,22 @@ namespace streamfx::obs::gs {
 
 		gs_zstencil_format get_zstencil_format();
 
+		/** Size the render target was last rendered at, or zero if it never was.
+		 */
+		uint32_t get_width();
+
+		uint32_t get_height();
+
 		streamfx::obs::gs::rendertarget_op render(uint32_t width, uint32_t height);
 
 		streamfx::obs::gs::rendertarget_op render(uint32_t width, uint32_t height, gs_color_space cs);
+
+		public:
+		/** Total number of render target (re-)allocations so far.
+		 *
+		 * Includes both the creation of new render targets and resizing of existing ones.
+		 */
+		static uint64_t allocations();
 	};
 
 	class rendertarget_op {
@@ -5,6 +5,7 @@
 
 #pragma once
 #include "common.hpp"
+#include "obs-source-profiler.hpp"
 #include "obs-source.hpp"
 
 namespace streamfx::obs {
@@ -236,8 +237,15 @@ namespace streamfx::obs {
 		static void _video_tick(void* data, float seconds) noexcept
 		{
 			try {
-				if (data)
-					reinterpret_cast<_instance*>(data)->video_tick(seconds);
+				if (data) {
+					auto instance = reinterpret_cast<_instance*>(data);
+					if (auto profiler = instance->profiler(); profiler) {
+						auto scope = profiler->tick();
+						instance->video_tick(seconds);
+					} else {
+						instance->video_tick(seconds);
+					}
+				}
 			} catch (const std::exception& ex) {
 				DLOG_ERROR("Unexpected exception in function '%s': %s.", __FUNCTION_NAME__, ex.what());
 			} catch (...) {
@@ -248,8 +256,15 @@ namespace streamfx::obs {
 		static void _video_render(void* data, gs_effect_t* effect) noexcept
 		{
 			try {
-				if (data)
-					reinterpret_cast<_instance*>(data)->video_render(effect);
+				if (data) {
+					auto instance = reinterpret_cast<_instance*>(data);
+					if (auto profiler = instance->profiler(); profiler) {
+						auto scope = profiler->render();
+						instance->video_render(effect);
+					} else {
+						instance->video_render(effect);
+					}
+				}
 			} catch (const std::exception& ex) {
 				DLOG_ERROR("Unexpected exception in function '%s': %s.", __FUNCTION_NAME__, ex.what());
 			} catch (...) {
@@ -260,8 +275,15 @@ namespace streamfx::obs {
 		static void _video_render_filter(void* data, gs_effect_t* effect) noexcept
 		{
 			try {
-				if (data)
-					reinterpret_cast<_instance*>(data)->video_render(effect);
+				if (data) {
+					auto instance = reinterpret_cast<_instance*>(data);
+					if (auto profiler = instance->profiler(); profiler) {
+						auto scope = profiler->render();
+						instance->video_render(effect);
+					} else {
+						instance->video_render(effect);
+					}
+				}
 			} catch (const std::exception& ex) {
 				DLOG_ERROR("Unexpected exception in function '%s': %s.", __FUNCTION_NAME__, ex.what());
 				obs_source_skip_video_filter(reinterpret_cast<_instance*>(data)->get());
@@ -833,8 +855,10 @@ namespace streamfx::obs {
 		protected:
 		::streamfx::obs::source _self;
 
+		std::shared_ptr<::streamfx::obs::source_profiler> _profiler;
+
 		public:
-		source_instance(obs_data_t* settings, obs_source_t* source) : _self(source, false, false) {}
+		source_instance(obs_data_t* settings, obs_source_t* source) : _self(source, false, false), _profiler(::streamfx::obs::source_profiler::is_enabled() ? ::streamfx::obs::source_profiler::create(source) : nullptr) {}
 		virtual ~source_instance(){};
 
 		virtual ::streamfx::obs::source get()
@@ -842,6 +866,13 @@ namespace streamfx::obs {
 			return _self;
 		}
 
+		/** Instrumentation for this instance, or nullptr if profiling is disabled.
+		 */
+		std::shared_ptr<::streamfx::obs::source_profiler> profiler()
+		{
+			return _profiler;
+		}
+
 		virtual void filter_remove(obs_source_t* source) {}
 
 		public /* Instance > Video */:
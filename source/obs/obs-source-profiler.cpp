@@ -0,0 +1,291 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "obs-source-profiler.hpp"
+#include "configuration.hpp"
+#include "obs/gs/gs-helper.hpp"
+#include "obs/gs/gs-rendertarget-pool.hpp"
+#include "obs/gs/gs-rendertarget.hpp"
+#include "plugin.hpp"
+#include "util/util-logging.hpp"
+
+#ifdef _DEBUG
+#define ST_PREFIX "<%s> "
+#define D_LOG_ERROR(x, ...) P_LOG_ERROR(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_WARNING(x, ...) P_LOG_WARN(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_INFO(x, ...) P_LOG_INFO(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_DEBUG(x, ...) P_LOG_DEBUG(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#else
+#define ST_PREFIX "<obs::source_profiler> "
+#define D_LOG_ERROR(...) P_LOG_ERROR(ST_PREFIX __VA_ARGS__)
+#define D_LOG_WARNING(...) P_LOG_WARN(ST_PREFIX __VA_ARGS__)
+#define D_LOG_INFO(...) P_LOG_INFO(ST_PREFIX __VA_ARGS__)
+#define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
+#endif
+
+#define ST_CFG_ENABLED "profiling.enabled"
+#define ST_CFG_INTERVAL "profiling.interval"
+
+namespace {
+	bool                         _enabled  = false;
+	std::chrono::duration<float> _interval = std::chrono::seconds(60);
+	std::chrono::duration<float> _elapsed  = std::chrono::seconds(0);
+
+	std::mutex                                               _registry_lock;
+	std::list<std::weak_ptr<streamfx::obs::source_profiler>> _registry;
+
+	// Innermost scope that is currently measuring on this thread.
+	thread_local streamfx::obs::source_profiler::scope* _current = nullptr;
+
+	double_t to_ms(std::chrono::nanoseconds v)
+	{
+		return std::max<double_t>(double_t(v.count()), 0.) / 1000000.;
+	}
+} // namespace
+
+streamfx::obs::source_profiler::scope::~scope()
+{
+	if (!_parent) {
+		return;
+	}
+
+	if (_gpu_query != std::numeric_limits<size_t>::max()) {
+		_parent->gpu_end(_gpu_query);
+	}
+	auto     elapsed     = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _start);
+	uint64_t allocations = ::streamfx::obs::gs::rendertarget::allocations() - _allocations;
+
+	// Leave out what nested instances spent, as they already count it for themselves.
+	_profiler->track(elapsed - _nested_time);
+	_parent->_allocations.fetch_add(allocations - _nested_allocations, std::memory_order_relaxed);
+
+	_current = _outer;
+	if (_outer) {
+		_outer->_nested_time += elapsed;
+		_outer->_nested_allocations += allocations;
+	}
+}
+
+streamfx::obs::source_profiler::scope::scope(source_profiler* parent, std::shared_ptr<streamfx::util::profiler> profiler, bool gpu)
+	: _parent(parent), _profiler(profiler), _start(), _allocations(::streamfx::obs::gs::rendertarget::allocations()), _gpu_query(std::numeric_limits<size_t>::max()), _outer(_current), _nested_time(0), _nested_allocations(0)
+{
+	// A GPU query of an enclosing scope already measures everything rendered in here, so nested instances are left
+	// out to count that time only once.
+	for (auto outer = _outer; gpu && outer; outer = outer->_outer) {
+		gpu = (outer->_gpu_query == std::numeric_limits<size_t>::max());
+	}
+
+	_current = this;
+	if (gpu) {
+		_gpu_query = _parent->gpu_begin();
+	}
+	_start = std::chrono::high_resolution_clock::now();
+}
+
+streamfx::obs::source_profiler::~source_profiler()
+{
+	bool has_queries = std::any_of(_gpu_queries.begin(), _gpu_queries.end(), [](const gpu_query& q) { return q.range || q.timer; });
+	if (has_queries) {
+		auto gctx = ::streamfx::obs::gs::context();
+		for (auto& query : _gpu_queries) {
+			if (query.timer) {
+				gs_timer_destroy(query.timer);
+			}
+			if (query.range) {
+				gs_timer_range_destroy(query.range);
+			}
+		}
+	}
+}
+
+streamfx::obs::source_profiler::source_profiler(obs_source_t* source)
+	: _source(source), _id(obs_source_get_id(source)), _tick(streamfx::util::profiler::create()), _render(streamfx::util::profiler::create()), _gpu(streamfx::util::profiler::create()), _allocations(0), _reused(0), _rendered(0), _gpu_queries(), _gpu_supported(true)
+{
+#ifdef D_PLATFORM_MAC
+	// Timestamp queries are not implemented for Metal.
+	_gpu_supported = false;
+#endif
+	for (auto& query : _gpu_queries) {
+		query = {nullptr, nullptr, false};
+	}
+}
+
+streamfx::obs::source_profiler::scope streamfx::obs::source_profiler::tick()
+{
+	return {this, _tick, false};
+}
+
+streamfx::obs::source_profiler::scope streamfx::obs::source_profiler::render()
+{
+	return {this, _render, true};
+}
+
+void streamfx::obs::source_profiler::track_reuse(bool reused)
+{
+	(reused ? _reused : _rendered).fetch_add(1, std::memory_order_relaxed);
+}
+
+streamfx::obs::source_profiler::stats streamfx::obs::source_profiler::report()
+{
+	stats result;
+	if (auto source = _source.lock(); source) {
+		result.name = source.name();
+	}
+	result.id          = _id;
+	result.tick        = _tick->capture();
+	result.render      = _render->capture();
+	result.gpu         = _gpu->capture();
+	result.allocations = _allocations.load(std::memory_order_relaxed);
+	result.reused      = _reused.load(std::memory_order_relaxed);
+	result.rendered    = _rendered.load(std::memory_order_relaxed);
+	return result;
+}
+
+size_t streamfx::obs::source_profiler::gpu_begin()
+{
+	if (!_gpu_supported) {
+		return std::numeric_limits<size_t>::max();
+	}
+
+	// Collect finished queries first, so that their slots can be reused.
+	gpu_collect();
+
+	for (size_t idx = 0; idx < _gpu_queries.size(); idx++) {
+		auto& query = _gpu_queries[idx];
+		if (query.pending) {
+			continue;
+		}
+
+		if (!query.range || !query.timer) {
+			query.range = gs_timer_range_create();
+			query.timer = gs_timer_create();
+			if (!query.range || !query.timer) {
+				D_LOG_WARNING("Graphics backend does not support timestamp queries, GPU time will not be measured.", nullptr);
+				_gpu_supported = false;
+				return std::numeric_limits<size_t>::max();
+			}
+		}
+
+		gs_timer_range_begin(query.range);
+		gs_timer_begin(query.timer);
+		return idx;
+	}
+
+	// All queries are still in flight, skip this frame.
+	return std::numeric_limits<size_t>::max();
+}
+
+void streamfx::obs::source_profiler::gpu_end(size_t idx)
+{
+	auto& query = _gpu_queries[idx];
+	gs_timer_end(query.timer);
+	gs_timer_range_end(query.range);
+	query.pending = true;
+}
+
+void streamfx::obs::source_profiler::gpu_collect()
+{
+	for (auto& query : _gpu_queries) {
+		if (!query.pending) {
+			continue;
+		}
+
+		uint64_t ticks     = 0;
+		uint64_t frequency = 0;
+		bool     disjoint  = false;
+		if (!gs_timer_get_data(query.timer, &ticks) || !gs_timer_range_get_data(query.range, &disjoint, &frequency)) {
+			continue; // Not ready yet.
+		}
+
+		query.pending = false;
+		if (!disjoint && (frequency > 0)) {
+			_gpu->track(std::chrono::nanoseconds(static_cast<int64_t>(double_t(ticks) * (1000000000. / double_t(frequency)))));
+		}
+	}
+}
+
+bool streamfx::obs::source_profiler::is_enabled()
+{
+	return _enabled;
+}
+
+std::shared_ptr<streamfx::obs::source_profiler> streamfx::obs::source_profiler::create(obs_source_t* source)
+{
+	auto instance = std::make_shared<streamfx::obs::source_profiler>(source);
+
+	std::lock_guard<std::mutex> lg(_registry_lock);
+	_registry.push_back(instance);
+	return instance;
+}
+
+std::vector<streamfx::obs::source_profiler::stats> streamfx::obs::source_profiler::report_all()
+{
+	std::vector<stats> result;
+
+	std::lock_guard<std::mutex> lg(_registry_lock);
+	for (auto itr = _registry.begin(); itr != _registry.end();) {
+		if (auto instance = itr->lock(); instance) {
+			result.push_back(instance->report());
+			itr++;
+		} else {
+			itr = _registry.erase(itr);
+		}
+	}
+
+	return result;
+}
+
+void streamfx::obs::source_profiler::dump()
+{
+	auto reports = report_all();
+
+	D_LOG_INFO("Profiling data for %zu instance(s), times are p50/p99/max in milliseconds:", reports.size());
+	for (auto& report : reports) {
+		D_LOG_INFO("  '%s' (%s): Tick %.3f/%.3f/%.3f, Render %.3f/%.3f/%.3f, GPU %.3f/%.3f/%.3f, %" PRIu64 " render target allocation(s).", report.name.c_str(), report.id.c_str(),
+				   to_ms(report.tick.percentile(.5)), to_ms(report.tick.percentile(.99)), to_ms(report.tick.maximum()),
+				   to_ms(report.render.percentile(.5)), to_ms(report.render.percentile(.99)), to_ms(report.render.maximum()),
+				   to_ms(report.gpu.percentile(.5)), to_ms(report.gpu.percentile(.99)), to_ms(report.gpu.maximum()),
+				   report.allocations);
+		if (uint64_t total = report.reused + report.rendered; total > 0) {
+			D_LOG_INFO("    Reused its previous result for %" PRIu64 " of %" PRIu64 " frame(s) (%.1f%%).", report.reused, total, 100. * static_cast<double_t>(report.reused) / static_cast<double_t>(total));
+		}
+	}
+
+	if (!reports.empty()) {
+		auto pool = streamfx::obs::gs::rendertarget_pool::instance()->get_statistics();
+		D_LOG_INFO("  Render Target Pool: %zu borrowed (%zu MiB), %zu idle (%zu MiB), %zu MiB peak, %.1f%% hit rate, %" PRIu64 " eviction(s).", pool.borrowed_count, pool.borrowed_bytes >> 20, pool.idle_count, pool.idle_bytes >> 20, pool.peak_bytes >> 20, pool.hit_rate() * 100., pool.evictions);
+	}
+}
+
+static void profiler_tick(void*, float seconds)
+{
+	_elapsed += std::chrono::duration<float>(seconds);
+	if (_elapsed >= _interval) {
+		_elapsed = std::chrono::seconds(0);
+		streamfx::obs::source_profiler::dump();
+	}
+}
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		if (auto config = streamfx::configuration::instance(); config) {
+			auto data = config->get();
+			_enabled  = obs_data_get_bool(data.get(), ST_CFG_ENABLED);
+			if (obs_data_has_user_value(data.get(), ST_CFG_INTERVAL)) {
+				_interval = std::chrono::seconds(std::max<long long>(obs_data_get_int(data.get(), ST_CFG_INTERVAL), 1));
+			}
+		}
+
+		if (_enabled) {
+			D_LOG_INFO("Profiling is enabled, statistics will be logged every %.0f seconds.", _interval.count());
+			obs_add_tick_callback(profiler_tick, nullptr);
+		}
+	},
+	[]() { // Finalizer
+		if (_enabled) {
+			obs_remove_tick_callback(profiler_tick, nullptr);
+			streamfx::obs::source_profiler::dump();
+		}
+	},
+	streamfx::loader_priority::NORMAL);
@@ -0,0 +1,124 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+#include "obs-weak-source.hpp"
+#include "util/util-profiler.hpp"
+
+#include "warning-disable.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "warning-enable.hpp"
+
+namespace streamfx::obs {
+	/** Opt-in per-instance timing of video_tick and video_render.
+	 *
+	 * Enabled with 'profiling.enabled' in the StreamFX configuration. CPU time is measured around the
+	 * callbacks, GPU time with timestamp queries where the graphics backend supports them, and render
+	 * target allocations are attributed to the instance that caused them.
+	 *
+	 * CPU time and allocations are exclusive: whatever an instance spends rendering or ticking other
+	 * profiled instances from within its own callbacks is only counted for those. GPU time can't be
+	 * split like that, so the GPU time of nested instances is only counted for the instance that
+	 * rendered them.
+	 */
+	class source_profiler {
+		public:
+		static constexpr size_t gpu_query_count = 4;
+
+		struct stats {
+			std::string                        name;
+			std::string                        id;
+			streamfx::util::profiler::snapshot tick;
+			streamfx::util::profiler::snapshot render;
+			streamfx::util::profiler::snapshot gpu;
+			uint64_t                           allocations;
+			uint64_t                           reused;   // Frames that reused a previous result.
+			uint64_t                           rendered; // Frames that could have reused one, but did not.
+		};
+
+		class scope {
+			source_profiler*                               _parent;
+			std::shared_ptr<streamfx::util::profiler>      _profiler;
+			std::chrono::high_resolution_clock::time_point _start;
+			uint64_t                                       _allocations;
+			size_t                                         _gpu_query;
+			scope*                                         _outer; // Scope this one is nested in on the same thread.
+			std::chrono::nanoseconds                       _nested_time;
+			uint64_t                                       _nested_allocations;
+
+			public:
+			~scope();
+			scope(source_profiler* parent, std::shared_ptr<streamfx::util::profiler> profiler, bool gpu);
+
+			scope(const scope&)            = delete;
+			scope& operator=(const scope&) = delete;
+		};
+
+		private:
+		::streamfx::obs::weak_source _source;
+		std::string                  _id;
+
+		std::shared_ptr<streamfx::util::profiler> _tick;
+		std::shared_ptr<streamfx::util::profiler> _render;
+		std::shared_ptr<streamfx::util::profiler> _gpu;
+		std::atomic<uint64_t>                     _allocations;
+		std::atomic<uint64_t>                     _reused;
+		std::atomic<uint64_t>                     _rendered;
+
+		struct gpu_query {
+			gs_timer_range_t* range;
+			gs_timer_t*       timer;
+			bool              pending;
+		};
+		std::array<gpu_query, gpu_query_count> _gpu_queries;
+		bool                                   _gpu_supported;
+
+		public:
+		~source_profiler();
+		source_profiler(obs_source_t* source);
+
+		/** Measure a video_tick call for the lifetime of the returned scope.
+		 */
+		scope tick();
+
+		/** Measure a video_render call for the lifetime of the returned scope, including GPU time.
+		 *
+		 * Must be called from within the graphics context.
+		 */
+		scope render();
+
+		/** Count a frame of an instance that caches its results, by whether it reused a previous result.
+		 */
+		void track_reuse(bool reused);
+
+		stats report();
+
+		private:
+		size_t gpu_begin();
+
+		void gpu_end(size_t query);
+
+		void gpu_collect();
+
+		public:
+		static bool is_enabled();
+
+		static std::shared_ptr<source_profiler> create(obs_source_t* source);
+
+		/** Retrieve the current statistics of all profiled instances.
+		 */
+		static std::vector<stats> report_all();
+
+		/** Write the current statistics of all profiled instances to the log.
+		 */
+		static void dump();
+	};
+} // namespace streamfx::obs
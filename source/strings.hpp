@@ -42,6 +42,7 @@
 #define S_SOURCETYPE_SOURCE "SourceType.Source"
 #define S_SOURCETYPE_SCENE "SourceType.Scene"
 
+#define S_BLUR_TYPE_AUTOMATIC "Blur.Type.Automatic"
 #define S_BLUR_TYPE_BOX "Blur.Type.Box"
 #define S_BLUR_TYPE_BOX_LINEAR "Blur.Type.BoxLinear"
 #define S_BLUR_TYPE_GAUSSIAN "Blur.Type.Gaussian"
@@ -0,0 +1,162 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#include "util-benchmark.hpp"
+#include "configuration.hpp"
+#include "plugin.hpp"
+#include "util/util-logging.hpp"
+
+#include "warning-disable.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include "warning-enable.hpp"
+
+#ifdef _DEBUG
+#define ST_PREFIX "<%s> "
+#define D_LOG_ERROR(x, ...) P_LOG_ERROR(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_WARNING(x, ...) P_LOG_WARN(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_INFO(x, ...) P_LOG_INFO(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#define D_LOG_DEBUG(x, ...) P_LOG_DEBUG(ST_PREFIX##x, __FUNCTION_SIG__, __VA_ARGS__)
+#else
+#define ST_PREFIX "<util::benchmark> "
+#define D_LOG_ERROR(...) P_LOG_ERROR(ST_PREFIX __VA_ARGS__)
+#define D_LOG_WARNING(...) P_LOG_WARN(ST_PREFIX __VA_ARGS__)
+#define D_LOG_INFO(...) P_LOG_INFO(ST_PREFIX __VA_ARGS__)
+#define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
+#endif
+
+#define ST_CFG_ENABLED "benchmark.enabled"
+#define ST_BENCHMARK_FILE "benchmark.json"
+
+namespace {
+	struct benchmark_info {
+		std::string                        name;
+		size_t                             iterations;
+		streamfx::util::benchmark::setup_t setup;
+	};
+
+	std::mutex& registry_lock()
+	{
+		static std::mutex lock;
+		return lock;
+	}
+
+	std::list<benchmark_info>& registry()
+	{
+		// Components register from their own loaders, so this must not depend on static initialization order.
+		static std::list<benchmark_info> list;
+		return list;
+	}
+
+	std::atomic<bool> _started = false;
+	std::thread       _worker;
+} // namespace
+
+void streamfx::util::benchmark::add(std::string_view name, size_t iterations, setup_t setup)
+{
+	std::lock_guard<std::mutex> lg(registry_lock());
+	registry().push_back({std::string{name}, std::max<size_t>(iterations, 1), setup});
+}
+
+size_t streamfx::util::benchmark::run(std::filesystem::path output, const std::vector<std::string>& filters)
+{
+	std::list<benchmark_info> benchmarks;
+	{
+		std::lock_guard<std::mutex> lg(registry_lock());
+		for (auto& benchmark : registry()) {
+			if (filters.empty() || std::any_of(filters.begin(), filters.end(), [&benchmark](const std::string& filter) { return benchmark.name.compare(0, filter.size(), filter) == 0; })) {
+				benchmarks.push_back(benchmark);
+			}
+		}
+	}
+
+	size_t failed = 0;
+
+	nlohmann::json results = nlohmann::json::array();
+	for (auto& benchmark : benchmarks) {
+		nlohmann::json result;
+		result["name"]       = benchmark.name;
+		result["iterations"] = benchmark.iterations;
+
+		try {
+			auto function = benchmark.setup();
+			auto profiler = streamfx::util::profiler::create();
+
+			// Warm up caches and lazily initialized state before measuring.
+			function();
+
+			for (size_t iteration = 0; iteration < benchmark.iterations; iteration++) {
+				auto start = std::chrono::high_resolution_clock::now();
+				function();
+				profiler->track(std::chrono::high_resolution_clock::now() - start);
+			}
+
+			auto data            = profiler->capture();
+			result["total_ns"]   = data.total_duration().count();
+			result["average_ns"] = data.average_duration();
+			result["minimum_ns"] = data.minimum().count();
+			result["p50_ns"]     = data.percentile(.5).count();
+			result["p95_ns"]     = data.percentile(.95).count();
+			result["p99_ns"]     = data.percentile(.99).count();
+			result["maximum_ns"] = data.maximum().count();
+			D_LOG_INFO("%s: %.3f ms average, %.3f ms p99 over %zu iteration(s).", benchmark.name.c_str(), data.average_duration() / 1000000., double_t(data.percentile(.99).count()) / 1000000., benchmark.iterations);
+		} catch (const std::exception& ex) {
+			result["error"] = ex.what();
+			failed++;
+			D_LOG_WARNING("%s: Failed with error: %s", benchmark.name.c_str(), ex.what());
+		} catch (...) {
+			result["error"] = "Unknown error";
+			failed++;
+			D_LOG_WARNING("%s: Failed with unknown error.", benchmark.name.c_str());
+		}
+
+		results.push_back(result);
+	}
+
+	nlohmann::json document;
+	document["version"]    = STREAMFX_VERSION_STRING;
+	document["benchmarks"] = results;
+
+	std::ofstream file(output, std::ios::out | std::ios::trunc);
+	if (!file.good()) {
+		D_LOG_ERROR("Unable to write results to '%s'.", output.generic_u8string().c_str());
+		return results.size();
+	}
+	file << document.dump(1, '\t');
+	D_LOG_INFO("Wrote results of %zu benchmark(s) to '%s', %zu failed.", results.size(), output.generic_u8string().c_str(), failed);
+	return failed;
+}
+
+static void benchmark_tick(void*, float)
+{
+	// Wait for the first frame, so that every component had a chance to register its benchmarks.
+	if (_started.exchange(true)) {
+		return;
+	}
+
+	_worker = std::thread([]() { streamfx::util::benchmark::run(streamfx::config_file_path(ST_BENCHMARK_FILE)); });
+}
+
+static auto loader = streamfx::loader(
+	[]() { // Initalizer
+		if (auto config = streamfx::configuration::instance(); config) {
+			auto data = config->get();
+			if (obs_data_get_bool(data.get(), ST_CFG_ENABLED)) {
+				D_LOG_INFO("Benchmarks are enabled, results will be written to '%s'.", streamfx::config_file_path(ST_BENCHMARK_FILE).generic_u8string().c_str());
+				obs_add_tick_callback(benchmark_tick, nullptr);
+			}
+		}
+	},
+	[]() { // Finalizer
+		obs_remove_tick_callback(benchmark_tick, nullptr);
+		if (_worker.joinable()) {
+			_worker.join();
+		}
+	},
+	streamfx::loader_priority::LOWEST); // Must be loaded after all other functionality.
@@ -0,0 +1,38 @@
+// AUTOGENERATED COPYRIGHT HEADER START
+// Copyright (C) 2023 Michael Fabian 'Xaymar' Dirks <info@xaymar.com>
+// AUTOGENERATED COPYRIGHT HEADER END
+
+#pragma once
+#include "common.hpp"
+
+#include "warning-disable.hpp"
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "warning-enable.hpp"
+
+namespace streamfx::util::benchmark {
+	typedef std::function<void()>       function_t;
+	typedef std::function<function_t()> setup_t;
+
+	/** Register a benchmark.
+	 *
+	 * The setup function is called once outside of the measurement and returns the function that is
+	 * measured, which is then called 'iterations' times. Anything the measured function needs should be
+	 * captured by it, and is released once the benchmark has finished.
+	 *
+	 * @param name Unique name of the benchmark, for example 'ffmpeg.swscale.1920x1080'.
+	 */
+	void add(std::string_view name, size_t iterations, setup_t setup);
+
+	/** Run all registered benchmarks and write the results as JSON to the given file.
+	 *
+	 * Benchmarks which throw during setup or measurement are reported with an error instead of timings.
+	 *
+	 * @param filters If not empty, only benchmarks whose name starts with one of these are run.
+	 * @return Number of benchmarks that failed, or that ran at all if the results could not be written.
+	 */
+	size_t run(std::filesystem::path output, const std::vector<std::string>& filters = {});
+} // namespace streamfx::util::benchmark
@@ -4,132 +4,210 @@
 
 #include "util-profiler.hpp"
 
-#include "warning-disable.hpp"
-#include <iterator>
-#include "warning-enable.hpp"
-
-streamfx::util::profiler::profiler() {}
+namespace {
+	size_t most_significant_bit(uint64_t v)
+	{
+		size_t bit = 0;
+		for (size_t step = 32; step > 0; step >>= 1) {
+			if (v >= (uint64_t(1) << step)) {
+				v >>= step;
+				bit += step;
+			}
+		}
+		return bit;
+	}
 
-streamfx::util::profiler::~profiler() {}
+	size_t bucket_of(uint64_t value)
+	{
+		constexpr size_t   bits  = streamfx::util::profiler::sub_bucket_bits;
+		constexpr size_t   count = streamfx::util::profiler::sub_bucket_count;
+		constexpr uint64_t limit = (uint64_t(1) << (streamfx::util::profiler::magnitude_limit + 1)) - 1;
 
-std::shared_ptr<streamfx::util::profiler::instance> streamfx::util::profiler::track()
-{
-	return std::make_shared<streamfx::util::profiler::instance>(shared_from_this());
-}
+		if (value < count) { // Exact region.
+			return static_cast<size_t>(value);
+		}
 
-void streamfx::util::profiler::track(std::chrono::nanoseconds duration)
-{
-	std::unique_lock<std::mutex> ul(_timings_lock);
-	auto                         itr = _timings.find(duration);
-	if (itr == _timings.end()) {
-		_timings.emplace(duration, 1u);
-	} else {
-		itr->second++;
+		value            = std::min(value, limit);
+		size_t magnitude = most_significant_bit(value);
+		size_t mantissa  = static_cast<size_t>(value >> (magnitude - bits)) & (count - 1);
+		return count + (magnitude - bits) * count + mantissa;
 	}
-}
-
-uint64_t streamfx::util::profiler::count()
-{
-	uint64_t count = 0;
 
-	std::map<std::chrono::nanoseconds, size_t> copy_timings;
+	uint64_t value_of(size_t bucket)
 	{
-		std::unique_lock<std::mutex> ul(_timings_lock);
-		copy(_timings.begin(), _timings.end(), std::inserter(copy_timings, copy_timings.end()));
+		constexpr size_t bits  = streamfx::util::profiler::sub_bucket_bits;
+		constexpr size_t count = streamfx::util::profiler::sub_bucket_count;
+
+		if (bucket < count) {
+			return bucket;
+		}
+
+		size_t   magnitude = (bucket - count) / count + bits;
+		size_t   mantissa  = (bucket - count) % count;
+		uint64_t width     = uint64_t(1) << (magnitude - bits);
+		uint64_t lower     = uint64_t(count + mantissa) << (magnitude - bits);
+		return lower + width / 2; // Middle of the bucket.
 	}
 
-	for (auto kv : copy_timings) {
-		count += kv.second;
+	size_t local_shard()
+	{
+		static std::atomic<size_t> next{0};
+		thread_local size_t        shard = next.fetch_add(1, std::memory_order_relaxed) % streamfx::util::profiler::shard_count;
+		return shard;
 	}
+} // namespace
 
-	return count;
+streamfx::util::profiler::snapshot::snapshot() : _buckets(bucket_count, 0), _count(0), _total(0), _minimum(std::chrono::nanoseconds::max()), _maximum(0) {}
+
+uint64_t streamfx::util::profiler::snapshot::count() const
+{
+	return _count;
 }
 
-std::chrono::nanoseconds streamfx::util::profiler::total_duration()
+std::chrono::nanoseconds streamfx::util::profiler::snapshot::total_duration() const
 {
-	std::chrono::nanoseconds duration{0};
+	return _total;
+}
 
-	std::map<std::chrono::nanoseconds, size_t> copy_timings;
-	{
-		std::unique_lock<std::mutex> ul(_timings_lock);
-		copy(_timings.begin(), _timings.end(), std::inserter(copy_timings, copy_timings.end()));
-	}
+double_t streamfx::util::profiler::snapshot::average_duration() const
+{
+	return double_t(_total.count()) / double_t(_count);
+}
 
-	for (auto kv : copy_timings) {
-		duration += kv.first * kv.second;
-	}
+std::chrono::nanoseconds streamfx::util::profiler::snapshot::minimum() const
+{
+	return (_count > 0) ? _minimum : std::chrono::nanoseconds(-1);
+}
 
-	return duration;
+std::chrono::nanoseconds streamfx::util::profiler::snapshot::maximum() const
+{
+	return (_count > 0) ? _maximum : std::chrono::nanoseconds(-1);
 }
 
-double_t streamfx::util::profiler::average_duration()
+std::chrono::nanoseconds streamfx::util::profiler::snapshot::percentile(double_t percentile, bool by_time) const
 {
-	std::chrono::nanoseconds duration{0};
-	uint64_t                 count = 0;
+	if (_count == 0) {
+		return std::chrono::nanoseconds(-1);
+	}
+	percentile = std::clamp(percentile, 0.0, 1.0);
 
-	std::map<std::chrono::nanoseconds, size_t> copy_timings;
-	{
-		std::unique_lock<std::mutex> ul(_timings_lock);
-		copy(_timings.begin(), _timings.end(), std::inserter(copy_timings, copy_timings.end()));
+	if (by_time) { // Return by time percentile.
+		auto threshold = uint64_t(double_t(_minimum.count()) + double_t((_maximum - _minimum).count()) * percentile);
+		for (size_t idx = bucket_of(threshold); idx < bucket_count; idx++) {
+			if (_buckets[idx] > 0) {
+				return std::chrono::nanoseconds(std::clamp<int64_t>(int64_t(value_of(idx)), _minimum.count(), _maximum.count()));
+			}
+		}
+	} else { // Return by call percentile.
+		auto     threshold = std::max<uint64_t>(uint64_t(std::ceil(double_t(_count) * percentile)), 1);
+		uint64_t accu      = 0;
+		for (size_t idx = 0; idx < bucket_count; idx++) {
+			accu += _buckets[idx];
+			if (accu >= threshold) {
+				return std::chrono::nanoseconds(std::clamp<int64_t>(int64_t(value_of(idx)), _minimum.count(), _maximum.count()));
+			}
+		}
 	}
 
-	for (auto kv : copy_timings) {
-		duration += kv.first * kv.second;
-		count += kv.second;
+	return _maximum;
+}
+
+void streamfx::util::profiler::snapshot::merge(const snapshot& other)
+{
+	for (size_t idx = 0; idx < bucket_count; idx++) {
+		_buckets[idx] += other._buckets[idx];
 	}
+	_count += other._count;
+	_total += other._total;
+	_minimum = std::min(_minimum, other._minimum);
+	_maximum = std::max(_maximum, other._maximum);
+}
 
-	return double_t(duration.count()) / double_t(count);
+streamfx::util::profiler::profiler() : _shards(std::make_unique<shard[]>(shard_count))
+{
+	reset();
 }
 
-template<typename T>
-inline bool is_equal(T a, T b, T c)
+streamfx::util::profiler::~profiler() {}
+
+std::shared_ptr<streamfx::util::profiler::instance> streamfx::util::profiler::track()
 {
-	return (a == b) || ((a >= (b - c)) && (a <= (b + c)));
+	return std::make_shared<streamfx::util::profiler::instance>(shared_from_this());
 }
 
-std::chrono::nanoseconds streamfx::util::profiler::percentile(double_t percentile, bool by_time)
+void streamfx::util::profiler::track(std::chrono::nanoseconds duration)
 {
-	constexpr double_t edge  = 0.00005;
-	uint64_t           calls = count();
+	auto   value = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+	shard& sh    = _shards[local_shard()];
 
-	std::map<std::chrono::nanoseconds, size_t> copy_timings;
-	{
-		std::unique_lock<std::mutex> ul(_timings_lock);
-		copy(_timings.begin(), _timings.end(), inserter(copy_timings, copy_timings.end()));
+	sh.buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+	sh.total.fetch_add(value, std::memory_order_relaxed);
+
+	// Only write the extremes if they actually changed, which quickly becomes rare.
+	for (auto cur = sh.minimum.load(std::memory_order_relaxed); (value < cur) && !sh.minimum.compare_exchange_weak(cur, value, std::memory_order_relaxed);) {
 	}
-	if (by_time) { // Return by time percentile.
-		// Find largest and smallest time.
-		std::chrono::nanoseconds smallest = copy_timings.begin()->first;
-		std::chrono::nanoseconds largest  = copy_timings.rbegin()->first;
-		std::chrono::nanoseconds variance = largest - smallest;
-
-		for (auto kv : copy_timings) {
-			double_t kv_pct = double_t((kv.first - smallest).count()) / double_t(variance.count());
-			if (is_equal<double_t>(kv_pct, percentile, edge) || (kv_pct > percentile)) {
-				return std::chrono::nanoseconds(kv.first);
-			}
-		}
-	} else { // Return by call percentile.
-		if (percentile == 0.0) {
-			return copy_timings.begin()->first;
-		}
+	for (auto cur = sh.maximum.load(std::memory_order_relaxed); (value > cur) && !sh.maximum.compare_exchange_weak(cur, value, std::memory_order_relaxed);) {
+	}
+}
 
-		uint64_t accu_calls_now = 0;
-		for (auto kv : copy_timings) {
-			uint64_t accu_calls_last = accu_calls_now;
-			accu_calls_now += kv.second;
+streamfx::util::profiler::snapshot streamfx::util::profiler::capture()
+{
+	streamfx::util::profiler::snapshot result;
+	for (size_t sdx = 0; sdx < shard_count; sdx++) {
+		shard& sh = _shards[sdx];
+		for (size_t idx = 0; idx < bucket_count; idx++) {
+			uint64_t count = sh.buckets[idx].load(std::memory_order_relaxed);
+			result._buckets[idx] += count;
+			result._count += count;
+		}
+		result._total += std::chrono::nanoseconds(sh.total.load(std::memory_order_relaxed));
+		result._minimum = std::min(result._minimum, std::chrono::nanoseconds(sh.minimum.load(std::memory_order_relaxed)));
+		result._maximum = std::max(result._maximum, std::chrono::nanoseconds(sh.maximum.load(std::memory_order_relaxed)));
+	}
+	return result;
+}
 
-			double_t percentile_last = double_t(accu_calls_last) / double_t(calls);
-			double_t percentile_now  = double_t(accu_calls_now) / double_t(calls);
+void streamfx::util::profiler::reset()
+{
+	for (size_t sdx = 0; sdx < shard_count; sdx++) {
+		shard& sh = _shards[sdx];
+		for (size_t idx = 0; idx < bucket_count; idx++) {
+			sh.buckets[idx].store(0, std::memory_order_relaxed);
+		}
+		sh.total.store(0, std::memory_order_relaxed);
+		sh.minimum.store(uint64_t(std::chrono::nanoseconds::max().count()), std::memory_order_relaxed);
+		sh.maximum.store(0, std::memory_order_relaxed);
+	}
+}
 
-			if (is_equal<double_t>(percentile, percentile_now, edge)
-				|| ((percentile_last < percentile) && (percentile_now > percentile))) {
-				return std::chrono::nanoseconds(kv.first);
-			}
+uint64_t streamfx::util::profiler::count()
+{
+	uint64_t count = 0;
+	for (size_t sdx = 0; sdx < shard_count; sdx++) {
+		for (size_t idx = 0; idx < bucket_count; idx++) {
+			count += _shards[sdx].buckets[idx].load(std::memory_order_relaxed);
 		}
 	}
+	return count;
+}
 
-	return std::chrono::nanoseconds(-1);
+std::chrono::nanoseconds streamfx::util::profiler::total_duration()
+{
+	std::chrono::nanoseconds duration{0};
+	for (size_t sdx = 0; sdx < shard_count; sdx++) {
+		duration += std::chrono::nanoseconds(_shards[sdx].total.load(std::memory_order_relaxed));
+	}
+	return duration;
+}
+
+double_t streamfx::util::profiler::average_duration()
+{
+	return capture().average_duration();
+}
+
+std::chrono::nanoseconds streamfx::util::profiler::percentile(double_t percentile, bool by_time)
+{
+	return capture().percentile(percentile, by_time);
 }
 
 streamfx::util::profiler::instance::instance(std::shared_ptr<streamfx::util::profiler> parent)
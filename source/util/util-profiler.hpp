@@ -6,15 +6,61 @@
 #include "common.hpp"
 
 #include "warning-disable.hpp"
+#include <atomic>
 #include <chrono>
-#include <map>
-#include <mutex>
+#include <vector>
 #include "warning-enable.hpp"
 
 namespace streamfx::util {
+	/** Constant memory timing profiler.
+	 *
+	 * Samples are recorded into a log-linear (HDR-style) histogram: durations below 2^sub_bucket_bits ns are
+	 * stored exactly, everything above is stored with sub_bucket_bits of precision (~3% relative error). Each
+	 * thread records into one of a fixed number of shards using relaxed atomics, so tracking never blocks.
+	 */
 	class profiler : public std::enable_shared_from_this<streamfx::util::profiler> {
-		std::map<std::chrono::nanoseconds, size_t> _timings;
-		std::mutex                                 _timings_lock;
+		public:
+		static constexpr size_t sub_bucket_bits  = 5;
+		static constexpr size_t sub_bucket_count = size_t(1) << sub_bucket_bits;
+		static constexpr size_t magnitude_limit  = 43; // 2^44ns is ~4.9 hours.
+		static constexpr size_t bucket_count     = sub_bucket_count + (magnitude_limit - sub_bucket_bits + 1) * sub_bucket_count;
+		static constexpr size_t shard_count      = 4;
+
+		class snapshot {
+			std::vector<uint64_t>    _buckets;
+			uint64_t                 _count;
+			std::chrono::nanoseconds _total;
+			std::chrono::nanoseconds _minimum;
+			std::chrono::nanoseconds _maximum;
+
+			public:
+			snapshot();
+
+			uint64_t count() const;
+
+			std::chrono::nanoseconds total_duration() const;
+
+			double_t average_duration() const;
+
+			std::chrono::nanoseconds minimum() const;
+
+			std::chrono::nanoseconds maximum() const;
+
+			std::chrono::nanoseconds percentile(double_t percentile, bool by_time = false) const;
+
+			void merge(const snapshot& other);
+
+			friend class profiler;
+		};
+
+		private:
+		struct shard {
+			std::atomic<uint64_t> buckets[bucket_count];
+			std::atomic<uint64_t> total;
+			std::atomic<uint64_t> minimum;
+			std::atomic<uint64_t> maximum;
+		};
+		std::unique_ptr<shard[]> _shards;
 
 		public:
 		class instance {
@@ -41,6 +87,12 @@ namespace streamfx::util {
 
 		void track(std::chrono::nanoseconds duration);
 
+		/** Copy the current state into a snapshot, which can be queried and merged.
+		 */
+		streamfx::util::profiler::snapshot capture();
+
+		void reset();
+
 		uint64_t count();
 
 		std::chrono::nanoseconds total_duration();
@@ -10,7 +10,9 @@
 #include "util/util-logging.hpp"
 
 #include "warning-disable.hpp"
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include "warning-enable.hpp"
 
 #include "warning-disable.hpp"
@@ -35,7 +37,7 @@
 #define D_LOG_DEBUG(...) P_LOG_DEBUG(ST_PREFIX __VA_ARGS__)
 #endif
 
-streamfx::util::threadpool::task::task(task_callback_t callback, task_data_t data) : _callback(callback), _data(data), _lock(), _status_changed(), _cancelled(false), _completed(false), _failed(false) {}
+streamfx::util::threadpool::task::task(task_callback_t callback, task_data_t data, priority priority, std::chrono::high_resolution_clock::time_point deadline) : _callback(callback), _data(data), _priority(priority), _deadline(deadline), _lock(), _status_changed(), _cancelled(false), _completed(false), _failed(false), _missed_deadline(false) {}
 
 streamfx::util::threadpool::task::~task() {}
 
@@ -52,6 +54,9 @@ void streamfx::util::threadpool::task::run()
 			D_LOG_ERROR("Unhandled exception in Task.", nullptr);
 			_failed = true;
 		}
+		if (std::chrono::high_resolution_clock::now() > _deadline) {
+			_missed_deadline = true;
+		}
 	}
 	_completed = true;
 	_status_changed.notify_all();
@@ -80,6 +85,16 @@ bool streamfx::util::threadpool::task::has_failed()
 	return _failed;
 }
 
+bool streamfx::util::threadpool::task::has_missed_deadline()
+{
+	return _missed_deadline;
+}
+
+streamfx::util::threadpool::priority streamfx::util::threadpool::task::get_priority()
+{
+	return _priority;
+}
+
 void streamfx::util::threadpool::task::wait()
 {
 	std::unique_lock<std::mutex> ul(_lock);
@@ -93,51 +108,493 @@ void streamfx::util::threadpool::task::await_completion()
 	wait();
 }
 
-streamfx::util::threadpool::threadpool::~threadpool()
+namespace {
+	// Worker (and owning threadpool) of the current thread, if any.
+	thread_local streamfx::util::threadpool::threadpool*  local_pool   = nullptr;
+	thread_local streamfx::util::threadpool::worker_info* local_worker = nullptr;
+
+	/** Recycles task allocations on a per-thread basis.
+	 *
+	 * A task and its shared_ptr control block are allocated as one block, which remembers the thread
+	 * that allocated it. Whichever thread releases the last reference hands the block back to that
+	 * thread, which keeps it for its next push() instead of returning it to the heap. This matters for
+	 * threads outside of the threadpool, whose tasks are usually released last by a worker.
+	 */
+	template<typename T>
+	struct task_allocator {
+		typedef T value_type;
+
+		static constexpr size_t limit = 64;
+
+		struct storage;
+
+		// Placed in front of every recycled block.
+		struct header {
+			storage* owner;
+			header*  next; // Next block returned by other threads.
+		};
+
+		static constexpr size_t alignment   = std::max(alignof(T), alignof(header));
+		static constexpr size_t header_size = (sizeof(header) + alignment - 1) & ~(alignment - 1);
+
+		struct storage {
+			std::vector<header*> blocks;     // Only ever accessed by the owning thread.
+			std::atomic<header*> returned;   // Blocks released by other threads, or closed() once the thread is gone.
+			std::atomic<size_t>  references; // One for the thread, and one for every block that exists.
+
+			storage() : blocks(), returned(nullptr), references(1)
+			{
+				blocks.reserve(limit);
+			}
+
+			static header* closed()
+			{
+				return reinterpret_cast<header*>(static_cast<uintptr_t>(1));
+			}
+
+			void release()
+			{
+				if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					delete this;
+				}
+			}
+
+			void destroy(header* block)
+			{
+				::operator delete(block, std::align_val_t(alignment));
+				release();
+			}
+
+			// Take the blocks that other threads returned since the last call.
+			void collect()
+			{
+				for (header* block = returned.exchange(nullptr, std::memory_order_acquire); block != nullptr;) {
+					header* next = block->next;
+					if (blocks.size() < limit) {
+						blocks.push_back(block);
+					} else {
+						destroy(block);
+					}
+					block = next;
+				}
+			}
+
+			// Called from another thread.
+			void give_back(header* block)
+			{
+				header* head = returned.load(std::memory_order_relaxed);
+				do {
+					if (head == closed()) { // The owning thread is gone, and nothing will ever collect the block.
+						destroy(block);
+						return;
+					}
+					block->next = head;
+				} while (!returned.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			// Called once the owning thread exits.
+			void close()
+			{
+				for (auto block : blocks) {
+					::operator delete(block, std::align_val_t(alignment));
+					references.fetch_sub(1, std::memory_order_relaxed);
+				}
+				blocks.clear();
+				for (header* block = returned.exchange(closed(), std::memory_order_acquire); block != nullptr;) {
+					header* next = block->next;
+					::operator delete(block, std::align_val_t(alignment));
+					references.fetch_sub(1, std::memory_order_relaxed);
+					block = next;
+				}
+				release();
+			}
+		};
+
+		struct local {
+			storage* instance;
+
+			local() : instance(new storage()) {}
+
+			~local()
+			{
+				instance->close();
+			}
+		};
+
+		task_allocator() noexcept {}
+
+		template<typename U>
+		task_allocator(const task_allocator<U>&) noexcept
+		{}
+
+		T* allocate(size_t n)
+		{
+			if (n != 1) {
+				return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+			}
+
+			storage* cache = local_storage();
+			if (cache->blocks.empty()) {
+				cache->collect();
+			}
+
+			header* block;
+			if (!cache->blocks.empty()) {
+				block = cache->blocks.back();
+				cache->blocks.pop_back();
+			} else {
+				block        = static_cast<header*>(::operator new(header_size + sizeof(T), std::align_val_t(alignment)));
+				block->owner = cache;
+				cache->references.fetch_add(1, std::memory_order_relaxed);
+			}
+			return reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(block) + header_size);
+		}
+
+		void deallocate(T* ptr, size_t n)
+		{
+			if (n != 1) {
+				::operator delete(ptr, std::align_val_t(alignof(T)));
+				return;
+			}
+
+			header*  block = reinterpret_cast<header*>(reinterpret_cast<uint8_t*>(ptr) - header_size);
+			storage* owner = block->owner;
+			if (owner != local_storage()) {
+				owner->give_back(block);
+			} else if (owner->blocks.size() < limit) {
+				owner->blocks.push_back(block);
+			} else {
+				owner->destroy(block);
+			}
+		}
+
+		static storage* local_storage()
+		{
+			static thread_local local instance;
+			return instance.instance;
+		}
+	};
+
+	template<typename T, typename U>
+	bool operator==(const task_allocator<T>&, const task_allocator<U>&)
+	{
+		return true;
+	}
+
+	template<typename T, typename U>
+	bool operator!=(const task_allocator<T>&, const task_allocator<U>&)
+	{
+		return false;
+	}
+
+	void set_thread_priority(streamfx::util::threadpool::priority priority)
+	{
+		// Only report the first failure of each thread, as workers change their priority with every task.
+		static thread_local bool reported = false;
+
+#if defined(D_PLATFORM_WINDOWS)
+		// Leaving background mode fails if the thread was never in it, which is expected.
+		bool result = true;
+		switch (priority) {
+		case streamfx::util::threadpool::priority::REALTIME:
+			SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+			result = SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+			break;
+		case streamfx::util::threadpool::priority::INTERACTIVE:
+			SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+			result = SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL);
+			break;
+		case streamfx::util::threadpool::priority::BACKGROUND:
+			result = SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN) && SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+			break;
+		}
+		if (!result && !reported) {
+			reported = true;
+			D_LOG_WARNING("Failed to change the priority of a worker thread to %" PRIu8 ", error %lu.", static_cast<uint8_t>(priority), GetLastError());
+		}
+#elif defined(D_PLATFORM_LINUX)
+		// SCHED_IDLE and raised nice values can't be undone without CAP_SYS_NICE, so background work only uses
+		// SCHED_BATCH, which any thread may freely switch to and from.
+		struct sched_param param;
+		int                result = 0;
+		switch (priority) {
+		case streamfx::util::threadpool::priority::REALTIME:
+			// Requires CAP_SYS_NICE or a suitable RLIMIT_RTPRIO, so fall back to the default policy.
+			param.sched_priority = sched_get_priority_min(SCHED_RR);
+			if (pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0) {
+				break;
+			}
+			[[fallthrough]];
+		case streamfx::util::threadpool::priority::INTERACTIVE:
+			param.sched_priority = 0;
+			result               = pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+			break;
+		case streamfx::util::threadpool::priority::BACKGROUND:
+			param.sched_priority = 0;
+			result               = pthread_setschedparam(pthread_self(), SCHED_BATCH, &param);
+			break;
+		}
+		if ((result != 0) && !reported) {
+			reported = true;
+			D_LOG_WARNING("Failed to change the priority of a worker thread to %" PRIu8 ": %s", static_cast<uint8_t>(priority), strerror(result));
+		}
+#endif
+	}
+
+	size_t next_power_of_two(size_t v)
+	{
+		size_t result = 1;
+		while (result < v) {
+			result <<= 1;
+		}
+		return result;
+	}
+} // namespace
+
+streamfx::util::threadpool::work_queue::ring::ring(size_t capacity) : mask(capacity - 1), data(std::make_unique<std::atomic<task*>[]>(capacity)) {}
+
+streamfx::util::threadpool::task* streamfx::util::threadpool::work_queue::ring::get(int64_t index)
 {
-	{ // Terminate all remaining tasks.
-		std::lock_guard<std::mutex> lg(_tasks_lock);
-		for (auto task : _tasks) {
-			task->cancel();
+	return data[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+}
+
+void streamfx::util::threadpool::work_queue::ring::put(int64_t index, task* value)
+{
+	data[static_cast<size_t>(index) & mask].store(value, std::memory_order_relaxed);
+}
+
+streamfx::util::threadpool::work_queue::~work_queue() {}
+
+streamfx::util::threadpool::work_queue::work_queue(size_t capacity) : _top(0), _bottom(0), _ring(), _rings()
+{
+	_rings.emplace_back(std::make_unique<ring>(next_power_of_two(capacity)));
+	_ring.store(_rings.back().get(), std::memory_order_relaxed);
+}
+
+void streamfx::util::threadpool::work_queue::push(task* value)
+{
+	int64_t b = _bottom.load(std::memory_order_relaxed);
+	int64_t t = _top.load(std::memory_order_acquire);
+	ring*   r = _ring.load(std::memory_order_relaxed);
+
+	if ((b - t) > static_cast<int64_t>(r->mask)) { // Full, so grow the ring.
+		// Old rings may still be read by concurrent thieves, so they are kept alive until destruction.
+		auto nr = std::make_unique<ring>((r->mask + 1) << 1);
+		for (int64_t idx = t; idx < b; idx++) {
+			nr->put(idx, r->get(idx));
+		}
+		r = nr.get();
+		_rings.emplace_back(std::move(nr));
+		_ring.store(r, std::memory_order_release);
+	}
+
+	r->put(b, value);
+	std::atomic_thread_fence(std::memory_order_release);
+	_bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+streamfx::util::threadpool::task* streamfx::util::threadpool::work_queue::pop()
+{
+	int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+	ring*   r = _ring.load(std::memory_order_relaxed);
+	_bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = _top.load(std::memory_order_relaxed);
+
+	if (t > b) { // Empty.
+		_bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	task* value = r->get(b);
+	if (t == b) { // Last element, race against thieves for it.
+		if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			value = nullptr;
+		}
+		_bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return value;
+}
+
+streamfx::util::threadpool::task* streamfx::util::threadpool::work_queue::steal()
+{
+	int64_t t = _top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = _bottom.load(std::memory_order_acquire);
+
+	if (t >= b) {
+		return nullptr;
+	}
+
+	ring* r     = _ring.load(std::memory_order_acquire);
+	task* value = r->get(t);
+	if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr;
+	}
+	return value;
+}
+
+bool streamfx::util::threadpool::work_queue::empty()
+{
+	return _top.load(std::memory_order_relaxed) >= _bottom.load(std::memory_order_relaxed);
+}
+
+streamfx::util::threadpool::inject_queue::~inject_queue() {}
+
+streamfx::util::threadpool::inject_queue::inject_queue(size_t capacity) : _mask(next_power_of_two(capacity) - 1), _cells(std::make_unique<cell[]>(_mask + 1)), _enqueue(0), _dequeue(0)
+{
+	for (size_t idx = 0; idx <= _mask; idx++) {
+		_cells[idx].sequence.store(idx, std::memory_order_relaxed);
+		_cells[idx].data = nullptr;
+	}
+}
+
+bool streamfx::util::threadpool::inject_queue::push(task* value)
+{
+	cell*  c   = nullptr;
+	size_t pos = _enqueue.load(std::memory_order_relaxed);
+	while (true) {
+		c            = &_cells[pos & _mask];
+		size_t   seq = c->sequence.load(std::memory_order_acquire);
+		intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+		if (dif == 0) {
+			if (_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (dif < 0) { // Full.
+			return false;
+		} else {
+			pos = _enqueue.load(std::memory_order_relaxed);
 		}
-		_tasks.clear();
 	}
 
+	c->data = value;
+	c->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+bool streamfx::util::threadpool::inject_queue::pop(task*& value)
+{
+	cell*  c   = nullptr;
+	size_t pos = _dequeue.load(std::memory_order_relaxed);
+	while (true) {
+		c            = &_cells[pos & _mask];
+		size_t   seq = c->sequence.load(std::memory_order_acquire);
+		intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+		if (dif == 0) {
+			if (_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (dif < 0) { // Empty.
+			return false;
+		} else {
+			pos = _dequeue.load(std::memory_order_relaxed);
+		}
+	}
+
+	value = c->data;
+	c->sequence.store(pos + _mask + 1, std::memory_order_release);
+	return true;
+}
+
+streamfx::util::threadpool::threadpool::~threadpool()
+{
 	{ // Notify workers to stop working.
 		{
 			std::lock_guard<std::mutex> lg(_workers_lock);
-			for (auto worker : _workers) {
+			for (auto& worker : _workers) {
 				worker->stop = true;
 			}
 		}
 		{
-			std::lock_guard<std::mutex> lg(_tasks_lock);
-			_tasks_cv.notify_all();
+			std::lock_guard<std::mutex> lg(_sleep_lock);
+			_sleep_cv.notify_all();
+			_realtime_cv.notify_all();
 		}
-		for (auto worker : _workers) {
-			std::lock_guard<std::mutex> lg(worker->lifeline);
+		for (auto& worker : _workers) {
+			if (!worker->thread.joinable()) {
+				continue;
+			}
+
+			if (worker->thread.get_id() == std::this_thread::get_id()) {
+				// The last reference was released by one of our own tasks.
+				worker->thread.detach();
+			} else {
+				worker->thread.join();
+			}
+		}
+	}
+
+	{ // Terminate all remaining tasks.
+		auto cancel = [](task* ptr) {
+			auto task = std::move(ptr->_self);
+			task->cancel();
+		};
+
+		for (size_t cls = 0; cls < priority_count; cls++) {
+			task* ptr = nullptr;
+			while (_inject[cls].pop(ptr)) {
+				cancel(ptr);
+			}
+			for (auto ptr : _overflow[cls]) {
+				cancel(ptr);
+			}
+			_overflow[cls].clear();
+			for (auto& worker : _workers) {
+				while ((ptr = worker->tasks[cls].pop()) != nullptr) {
+					cancel(ptr);
+				}
+			}
 		}
 	}
 }
 
-streamfx::util::threadpool::threadpool::threadpool(size_t minimum, size_t maximum) : _limits{minimum, maximum}, _workers_lock(), _worker_count(0), _workers(), _tasks_lock(), _tasks_cv(), _tasks()
+streamfx::util::threadpool::threadpool::threadpool(size_t minimum, size_t maximum) : _limits{minimum, std::max(minimum, maximum)}, _workers_lock(), _workers(), _worker_count(0), _inject(), _overflow_lock(), _overflow(), _sleeping(0), _realtime_sleeping(0), _sleep_lock(), _sleep_cv(), _realtime_cv(), _missed_deadlines(0)
 {
+	for (size_t cls = 0; cls < priority_count; cls++) {
+		_overflow_count[cls] = 0;
+		_pending[cls]        = 0;
+	}
+
+	// Allocate all worker slots up front, so that thieves never see the list change. The first
+	// slot is reserved for a worker that only runs REALTIME tasks and never shuts down.
+	_workers.reserve(_limits.second + 1);
+	for (size_t idx = 0; idx <= _limits.second; idx++) {
+		auto wi         = std::make_unique<worker_info>();
+		wi->stop        = false;
+		wi->alive       = false;
+		wi->index       = idx;
+		wi->realtime    = (idx == 0);
+		wi->os_priority = wi->realtime ? priority::REALTIME : priority::INTERACTIVE;
+		_workers.emplace_back(std::move(wi));
+	}
+
+	{
+		std::lock_guard<std::mutex> lg(_workers_lock);
+		launch(_workers.front().get());
+	}
+
 	// Spawn the minimum number of threads.
 	spawn(_limits.first);
 }
 
-std::shared_ptr<streamfx::util::threadpool::task> streamfx::util::threadpool::threadpool::push(task_callback_t callback, task_data_t data /*= nullptr*/)
+std::shared_ptr<streamfx::util::threadpool::task> streamfx::util::threadpool::threadpool::push(task_callback_t callback, task_data_t data /*= nullptr*/, priority priority /*= priority::INTERACTIVE*/, std::chrono::nanoseconds deadline /*= std::chrono::nanoseconds::zero()*/)
 {
-	std::lock_guard<std::mutex> lg(_tasks_lock);
-	constexpr size_t            threshold = 3;
+	constexpr size_t threshold = 3;
+
+	auto until = std::chrono::high_resolution_clock::time_point::max();
+	if (deadline > std::chrono::nanoseconds::zero()) {
+		until = std::chrono::high_resolution_clock::now() + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(deadline);
+	}
 
 	// Enqueue the new task.
-	auto task = std::make_shared<streamfx::util::threadpool::task>(callback, data);
-	_tasks.emplace_back(task);
+	auto task   = std::allocate_shared<streamfx::util::threadpool::task>(task_allocator<streamfx::util::threadpool::task>(), std::move(callback), std::move(data), priority, until);
+	task->_self = task;
+	enqueue(task.get());
 
 	// Spawn additional workers if the number of queued tasks exceeds a threshold.
-	if (_tasks.size() > (threshold * _worker_count)) {
-		spawn(_tasks.size() / threshold);
+	if (size_t count = pending(); count > (threshold * _worker_count.load(std::memory_order_relaxed))) {
+		spawn(count / threshold);
 	}
 
 	// Return handle to caller.
@@ -146,43 +603,153 @@ std::shared_ptr<streamfx::util::threadpool::task> streamfx::util::threadpool::th
 
 void streamfx::util::threadpool::threadpool::pop(std::shared_ptr<task> task)
 {
+	// Queued tasks can't be removed from the lock-free queues, but cancelled tasks are skipped by the workers.
 	if (task) {
 		task->cancel();
 	}
-	std::lock_guard<std::mutex> lg(_tasks_lock);
-	_tasks.remove(task);
+}
+
+uint64_t streamfx::util::threadpool::threadpool::missed_deadlines()
+{
+	return _missed_deadlines.load(std::memory_order_relaxed);
+}
+
+void streamfx::util::threadpool::threadpool::enqueue(task* task)
+{
+	size_t cls = static_cast<size_t>(task->_priority);
+	_pending[cls].fetch_add(1, std::memory_order_seq_cst);
+
+	if ((local_pool == this) && local_worker) {
+		// Pushed from one of our own workers, so keep it local.
+		local_worker->tasks[cls].push(task);
+	} else if (!_inject[cls].push(task)) {
+		std::lock_guard<std::mutex> lg(_overflow_lock);
+		_overflow[cls].push_back(task);
+		_overflow_count[cls].fetch_add(1, std::memory_order_release);
+	}
+
+	wake(task->_priority);
+}
+
+streamfx::util::threadpool::task* streamfx::util::threadpool::threadpool::dequeue(worker_info* wi)
+{
+	for (auto cls : {priority::REALTIME, priority::INTERACTIVE, priority::BACKGROUND}) {
+		if (wi->realtime && (cls != priority::REALTIME)) {
+			break;
+		}
+
+		if (auto ptr = dequeue(wi, cls); ptr != nullptr) {
+			return ptr;
+		}
+	}
+
+	return nullptr;
+}
+
+streamfx::util::threadpool::task* streamfx::util::threadpool::threadpool::dequeue(worker_info* wi, priority priority)
+{
+	size_t cls = static_cast<size_t>(priority);
+	task*  ptr = nullptr;
+
+	// Is there anything in this class at all?
+	if (_pending[cls].load(std::memory_order_acquire) == 0) {
+		return nullptr;
+	}
+
+	// 1. Our own queue.
+	if ((ptr = wi->tasks[cls].pop()) != nullptr) {
+		return ptr;
+	}
+
+	// 2. Work injected from outside of the threadpool.
+	if (_inject[cls].pop(ptr)) {
+		return ptr;
+	}
+	if (_overflow_count[cls].load(std::memory_order_acquire) > 0) {
+		std::lock_guard<std::mutex> lg(_overflow_lock);
+		if (!_overflow[cls].empty()) {
+			ptr = _overflow[cls].front();
+			_overflow[cls].pop_front();
+			_overflow_count[cls].fetch_sub(1, std::memory_order_relaxed);
+			return ptr;
+		}
+	}
+
+	// 3. Steal from other workers, starting at our neighbour to spread out contention.
+	for (size_t n = 1, count = _workers.size(); n < count; n++) {
+		if ((ptr = _workers[(wi->index + n) % count]->tasks[cls].steal()) != nullptr) {
+			return ptr;
+		}
+	}
+
+	return nullptr;
+}
+
+size_t streamfx::util::threadpool::threadpool::pending()
+{
+	size_t count = 0;
+	for (size_t cls = 0; cls < priority_count; cls++) {
+		count += _pending[cls].load(std::memory_order_seq_cst);
+	}
+	return count;
+}
+
+void streamfx::util::threadpool::threadpool::wake(priority priority)
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if ((priority == priority::REALTIME) && (_realtime_sleeping.load(std::memory_order_seq_cst) > 0)) {
+		std::lock_guard<std::mutex> lg(_sleep_lock);
+		_realtime_cv.notify_one();
+	} else if (_sleeping.load(std::memory_order_seq_cst) > 0) {
+		std::lock_guard<std::mutex> lg(_sleep_lock);
+		_sleep_cv.notify_one();
+	}
+}
+
+void streamfx::util::threadpool::threadpool::launch(worker_info* wi)
+{
+	// Reap the previous thread in this slot, which has already left work().
+	if (wi->thread.joinable()) {
+		wi->thread.join();
+	}
+
+	wi->stop           = false;
+	wi->alive          = true;
+	wi->last_work_time = std::chrono::high_resolution_clock::now();
+	wi->thread         = std::thread(&streamfx::util::threadpool::threadpool::work, this, wi);
 }
 
 void streamfx::util::threadpool::threadpool::spawn(size_t count)
 {
 	std::lock_guard<std::mutex> lg(_workers_lock);
-	for (size_t n = 0; (n < count) && (_worker_count < _limits.second); n++) {
-		auto wi            = std::make_shared<worker_info>();
-		wi->stop           = false;
-		wi->last_work_time = std::chrono::high_resolution_clock::now();
-		wi->thread         = std::thread(std::bind(&streamfx::util::threadpool::threadpool::work, this, wi));
-		wi->thread.detach();
-		_workers.emplace_back(wi);
+	for (auto itr = _workers.begin(); (count > 0) && (itr != _workers.end()) && (_worker_count < _limits.second); itr++) {
+		auto& wi = *itr;
+		if (wi->alive || wi->realtime) {
+			continue;
+		}
+
+		launch(wi.get());
 		++_worker_count;
+		--count;
 		D_LOG_DEBUG("Spawning new worker thread (%zu < %zu < %zu).", _limits.first, _worker_count.load(), _limits.second);
 	}
 }
 
-bool streamfx::util::threadpool::threadpool::die(std::shared_ptr<worker_info> wi)
+bool streamfx::util::threadpool::threadpool::die(worker_info* wi)
 {
 	constexpr std::chrono::seconds delay{1};
 
 	std::lock_guard<std::mutex> lg(_workers_lock);
 	bool                        result = false;
 
-	if (_worker_count > _limits.first) {
+	if (!wi->realtime && (_worker_count > _limits.first)) {
 		auto now = std::chrono::high_resolution_clock::now();
 		result   = ((wi->last_work_time + delay) <= now) && ((_last_worker_death + delay) <= now);
 
 		if (result) {
 			_last_worker_death = now;
 			--_worker_count;
-			_workers.remove(wi);
+			wi->alive = false;
 			D_LOG_DEBUG("Terminated idle worker thread (%zu < %zu < %zu).", _limits.first, _worker_count.load(), _limits.second);
 		}
 	}
@@ -190,51 +757,81 @@ bool streamfx::util::threadpool::threadpool::die(std::shared_ptr<worker_info> wi
 	return result;
 }
 
-void streamfx::util::threadpool::threadpool::work(std::shared_ptr<worker_info> wi)
+void streamfx::util::threadpool::threadpool::work(worker_info* wi)
 {
-	std::shared_ptr<streamfx::util::threadpool::task> task{};
-	std::lock_guard<std::mutex>                       lg(wi->lifeline);
+	local_pool   = this;
+	local_worker = wi;
 
+	set_thread_priority(wi->os_priority);
 #if defined(D_PLATFORM_WINDOWS)
-	SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN | THREAD_PRIORITY_BELOW_NORMAL);
-	SetThreadDescription(GetCurrentThread(), L"StreamFX Worker Thread");
+	SetThreadDescription(GetCurrentThread(), wi->realtime ? L"StreamFX Realtime Worker Thread" : L"StreamFX Worker Thread");
 #elif defined(D_PLATFORM_LINUX)
-	struct sched_param param;
-	param.sched_priority = 0;
-	pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
-	pthread_setname_np(pthread_self(), "StreamFX Worker Thread");
+	pthread_setname_np(pthread_self(), wi->realtime ? "StreamFX RT" : "StreamFX Worker"); // 15 characters at most.
 #endif
 
+	std::atomic<size_t>&     sleeping = wi->realtime ? _realtime_sleeping : _sleeping;
+	std::condition_variable& sleep_cv = wi->realtime ? _realtime_cv : _sleep_cv;
+
 	while (!wi->stop) {
-		{ // Try and acquire new work.
-			std::unique_lock<std::mutex> ul(_tasks_lock);
+		// Try and acquire new work.
+		if (auto ptr = dequeue(wi); ptr != nullptr) {
+			_pending[static_cast<size_t>(ptr->_priority)].fetch_sub(1, std::memory_order_relaxed);
+			wi->last_work_time = std::chrono::high_resolution_clock::now();
+
+			// Take over the reference that the queue held.
+			auto task = std::move(ptr->_self);
 
-			// Is there any work available right now?
-			if (_tasks.size() == 0) { // If not:
-				// Block this thread until it is notified of a change.
-				_tasks_cv.wait_until(ul, std::chrono::time_point(std::chrono::high_resolution_clock::now() + std::chrono::milliseconds(250)), [this, wi]() { return wi->stop || _tasks.size() > 0; });
+			// The task may hold the last reference to the threadpool, so keep it alive until we are done with it.
+			auto self = weak_from_this().lock();
+
+			// Match the OS priority to the class of the task.
+			if (!wi->realtime && (wi->os_priority != task->_priority)) {
+				wi->os_priority = task->_priority;
+				set_thread_priority(wi->os_priority);
 			}
 
-			// If we were asked to stop, skip everything.
-			if (wi->stop) {
-				continue;
+			task->run();
+
+			if (task->has_missed_deadline()) {
+				auto late   = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - task->_deadline);
+				auto missed = _missed_deadlines.fetch_add(1, std::memory_order_relaxed) + 1;
+				D_LOG_DEBUG("Task (priority %" PRIu8 ") completed %" PRId64 " us after its deadline.", static_cast<uint8_t>(task->_priority), static_cast<int64_t>(late.count()));
+				if ((missed & (missed - 1)) == 0) { // Don't flood the log.
+					D_LOG_WARNING("%" PRIu64 " tasks have missed their deadline so far, most recently by %" PRId64 " us.", missed, static_cast<int64_t>(late.count()));
+				}
 			}
+			task.reset();
 
-			// If there is work to be done, take it.
-			if (_tasks.size() > 0) {
-				wi->last_work_time = std::chrono::high_resolution_clock::now();
-				task               = _tasks.front();
-				_tasks.pop_front();
-			} else if (die(wi)) { // Is the threadpool requesting less threads?
-				break;
+			if (self) {
+				std::weak_ptr<streamfx::util::threadpool::threadpool> weak = self;
+				self.reset();
+				if (weak.expired()) {
+					// The threadpool is gone or being destroyed, and must not be touched anymore.
+					local_pool   = nullptr;
+					local_worker = nullptr;
+					return;
+				}
 			}
+			continue;
 		}
 
-		if (task) {
-			task->run();
-			task.reset();
+		{ // Block this thread until it is notified of a change.
+			std::unique_lock<std::mutex> ul(_sleep_lock);
+			sleeping.fetch_add(1, std::memory_order_seq_cst);
+			if (!wi->stop && ((wi->realtime ? _pending[static_cast<size_t>(priority::REALTIME)].load(std::memory_order_seq_cst) : pending()) == 0)) {
+				sleep_cv.wait_for(ul, std::chrono::milliseconds(250));
+			}
+			sleeping.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		// Is the threadpool requesting less threads?
+		if (!wi->stop && (pending() == 0) && die(wi)) {
+			break;
 		}
 	}
+
+	local_pool   = nullptr;
+	local_worker = nullptr;
 }
 
 std::shared_ptr<streamfx::util::threadpool::threadpool> streamfx::util::threadpool::threadpool::instance()
@@ -16,12 +16,95 @@
 #include <new>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 #include "warning-enable.hpp"
 
 namespace streamfx::util::threadpool {
 	typedef std::shared_ptr<void>            task_data_t;
 	typedef std::function<void(task_data_t)> task_callback_t;
 
+	class task;
+
+	/** Priority class of a task.
+	 *
+	 * Classes are served strictly in order, so REALTIME work never waits behind INTERACTIVE
+	 * or BACKGROUND work. Workers also adjust their OS priority to match the class of the task
+	 * they are currently running.
+	 */
+	enum class priority : uint8_t {
+		REALTIME,    // Latency critical work, such as forwarding audio.
+		INTERACTIVE, // Work the user is actively waiting for.
+		BACKGROUND,  // Long running or I/O bound work, such as network requests.
+	};
+	constexpr size_t priority_count = 3;
+
+	/** Lock-free single-producer multi-consumer deque (Chase-Lev).
+	 *
+	 * Only the owning worker may call push() and pop(), which operate on the bottom end. Any
+	 * other thread may call steal(), which operates on the top end.
+	 */
+	class work_queue {
+		struct ring {
+			size_t                                mask;
+			std::unique_ptr<std::atomic<task*>[]> data;
+
+			ring(size_t capacity);
+
+			task* get(int64_t index);
+			void  put(int64_t index, task* value);
+		};
+
+#if __cpp_lib_hardware_interference_size >= 201603
+		alignas(std::hardware_destructive_interference_size)
+#endif
+			std::atomic<int64_t> _top;
+#if __cpp_lib_hardware_interference_size >= 201603
+		alignas(std::hardware_destructive_interference_size)
+#endif
+			std::atomic<int64_t> _bottom;
+		std::atomic<ring*>                 _ring;
+		std::vector<std::unique_ptr<ring>> _rings;
+
+		public:
+		~work_queue();
+		work_queue(size_t capacity = 64);
+
+		void  push(task* value);
+		task* pop();
+		task* steal();
+
+		bool empty();
+	};
+
+	/** Lock-free bounded multi-producer multi-consumer queue (Vyukov).
+	 *
+	 * Used to inject work from threads that are not part of the threadpool.
+	 */
+	class inject_queue {
+		struct cell {
+			std::atomic<size_t> sequence;
+			task*               data;
+		};
+
+		size_t                  _mask;
+		std::unique_ptr<cell[]> _cells;
+#if __cpp_lib_hardware_interference_size >= 201603
+		alignas(std::hardware_destructive_interference_size)
+#endif
+			std::atomic<size_t> _enqueue;
+#if __cpp_lib_hardware_interference_size >= 201603
+		alignas(std::hardware_destructive_interference_size)
+#endif
+			std::atomic<size_t> _dequeue;
+
+		public:
+		~inject_queue();
+		inject_queue(size_t capacity = 1024);
+
+		bool push(task* value);
+		bool pop(task*& value);
+	};
+
 	struct worker_info {
 #if __cpp_lib_hardware_interference_size >= 201603
 		alignas(std::hardware_destructive_interference_size)
@@ -31,17 +114,26 @@ namespace streamfx::util::threadpool {
 #if __cpp_lib_hardware_interference_size >= 201603
 		alignas(std::hardware_destructive_interference_size)
 #endif
-			std::mutex lifeline;
+			std::atomic<bool> alive;
 
 		std::chrono::high_resolution_clock::time_point last_work_time;
 
+		size_t      index;
+		bool        realtime;
+		priority    os_priority;
+		work_queue  tasks[priority_count];
 		std::thread thread;
 	};
 
 	class task {
-		task_callback_t _callback;
-		task_data_t     _data;
-		std::mutex      _lock;
+		task_callback_t                                _callback;
+		task_data_t                                    _data;
+		priority                                       _priority;
+		std::chrono::high_resolution_clock::time_point _deadline;
+		std::mutex                                     _lock;
+
+		// Reference held by the threadpool while the task is queued.
+		std::shared_ptr<task> _self;
 
 #if __cpp_lib_hardware_interference_size >= 201603
 		alignas(std::hardware_destructive_interference_size)
@@ -59,9 +151,10 @@ namespace streamfx::util::threadpool {
 		alignas(std::hardware_destructive_interference_size)
 #endif
 			std::atomic<bool> _failed;
+		std::atomic<bool> _missed_deadline;
 
 		public:
-		task(task_callback_t callback, task_data_t data);
+		task(task_callback_t callback, task_data_t data, priority priority = priority::INTERACTIVE, std::chrono::high_resolution_clock::time_point deadline = std::chrono::high_resolution_clock::time_point::max());
 
 		public:
 		~task();
@@ -81,36 +174,60 @@ namespace streamfx::util::threadpool {
 		public:
 		bool has_failed();
 
+		public:
+		bool has_missed_deadline();
+
+		public:
+		priority get_priority();
+
 		public:
 		void wait();
 
 		public:
 		void await_completion();
+
+		friend class threadpool;
 	};
 
-	class threadpool {
+	class threadpool : public std::enable_shared_from_this<threadpool> {
 		std::pair<size_t, size_t> _limits;
 
 #if __cpp_lib_hardware_interference_size >= 201603
 		alignas(std::hardware_destructive_interference_size)
 #endif
 			std::mutex _workers_lock;
-		std::list<std::shared_ptr<worker_info>> _workers;
+		std::vector<std::unique_ptr<worker_info>> _workers;
 #if __cpp_lib_hardware_interference_size >= 201603
 		alignas(std::hardware_destructive_interference_size)
 #endif
 			std::atomic<size_t> _worker_count;
 		std::chrono::high_resolution_clock::time_point _last_worker_death;
 
+		inject_queue _inject[priority_count];
 #if __cpp_lib_hardware_interference_size >= 201603
 		alignas(std::hardware_destructive_interference_size)
 #endif
-			std::mutex _tasks_lock;
+			std::atomic<size_t> _overflow_count[priority_count];
+		std::mutex       _overflow_lock;
+		std::list<task*> _overflow[priority_count];
+
+#if __cpp_lib_hardware_interference_size >= 201603
+		alignas(std::hardware_destructive_interference_size)
+#endif
+			std::atomic<size_t> _pending[priority_count];
+#if __cpp_lib_hardware_interference_size >= 201603
+		alignas(std::hardware_destructive_interference_size)
+#endif
+			std::atomic<size_t> _sleeping;
+		std::atomic<size_t>     _realtime_sleeping;
+		std::mutex              _sleep_lock;
+		std::condition_variable _sleep_cv;
+		std::condition_variable _realtime_cv;
+
 #if __cpp_lib_hardware_interference_size >= 201603
 		alignas(std::hardware_destructive_interference_size)
 #endif
-			std::condition_variable _tasks_cv;
-		std::list<std::shared_ptr<task>> _tasks;
+			std::atomic<uint64_t> _missed_deadlines;
 
 		public:
 		~threadpool();
@@ -119,19 +236,48 @@ namespace streamfx::util::threadpool {
 		threadpool(size_t minimum = 2, size_t maximum = std::thread::hardware_concurrency());
 
 		public:
-		std::shared_ptr<task> push(task_callback_t callback, task_data_t data = nullptr);
+		/** Queue a new task.
+		 *
+		 * @param priority Priority class to run the task in.
+		 * @param deadline Time (relative to now) by which the task should have completed, or zero for none.
+		 *                 Tasks that miss their deadline still run, but are reported.
+		 */
+		std::shared_ptr<task> push(task_callback_t callback, task_data_t data = nullptr, priority priority = priority::INTERACTIVE, std::chrono::nanoseconds deadline = std::chrono::nanoseconds::zero());
 
 		public:
 		void pop(std::shared_ptr<task> task);
 
+		public:
+		/** Number of tasks that completed after their deadline.
+		 */
+		uint64_t missed_deadlines();
+
+		private:
+		void enqueue(task* task);
+
+		private:
+		task* dequeue(worker_info* wi);
+
+		private:
+		task* dequeue(worker_info* wi, priority priority);
+
+		private:
+		size_t pending();
+
+		private:
+		void wake(priority priority);
+
+		private:
+		void launch(worker_info* wi);
+
 		private:
 		void spawn(size_t count = 1);
 
 		private:
-		bool die(std::shared_ptr<worker_info>);
+		bool die(worker_info* wi);
 
 		private:
-		void work(std::shared_ptr<worker_info>);
+		void work(worker_info* wi);
 
 		public /* Singleton */:
 		static std::shared_ptr<streamfx::util::threadpool::threadpool> instance();
@@ -261,6 +261,22 @@ namespace streamfx::util {
 		};
 	} // namespace math
 
+	namespace hash {
+		/** 64-bit FNV-1a, which is fast on short inputs and good enough to tell files and code apart.
+		 *
+		 * Hashes can be chained by passing the previous hash as the basis.
+		 */
+		inline uint64_t fnv1a(const void* data, std::size_t size, uint64_t basis = 14695981039346656037ull)
+		{
+			auto ptr = static_cast<const uint8_t*>(data);
+			for (std::size_t idx = 0; idx < size; idx++) {
+				basis ^= ptr[idx];
+				basis *= 1099511628211ull;
+			}
+			return basis;
+		}
+	} // namespace hash
+
 	namespace memory {
 		inline std::size_t aligned_offset(std::size_t align, std::size_t pos)
 		{